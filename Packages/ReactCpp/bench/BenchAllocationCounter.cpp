@@ -0,0 +1,54 @@
+#include "BenchmarkHarness.h"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions so benchmarks can report how many
+// heap allocations a measured body makes. The other operator new overloads
+// forward to these two by default.
+
+namespace {
+
+std::size_t allocations = 0;
+
+void* countedAllocate(std::size_t size) {
+  ++allocations;
+  if (void* pointer = std::malloc(size != 0 ? size : 1)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace react::bench {
+
+std::size_t allocationCount() {
+  return allocations;
+}
+
+} // namespace react::bench
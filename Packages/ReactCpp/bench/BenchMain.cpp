@@ -0,0 +1,26 @@
+#include <cstdlib>
+
+namespace react::bench {
+void runReactFiberConcurrentUpdatesBenchmarks();
+void runReactFiberRootArenaBenchmarks();
+void runReactFiberHooksBenchmarks();
+void runReactFiberNewContextBenchmarks();
+void runReactFiberExternalStoreBenchmarks();
+void runReactFiberTransitionBenchmarks();
+void runReactTypedComponentBenchmarks();
+void runReactDOMComponentBenchmarks();
+void runReactWasmRenderBenchmarks();
+}
+
+int main() {
+    react::bench::runReactFiberConcurrentUpdatesBenchmarks();
+    react::bench::runReactFiberRootArenaBenchmarks();
+    react::bench::runReactFiberHooksBenchmarks();
+    react::bench::runReactFiberNewContextBenchmarks();
+    react::bench::runReactFiberExternalStoreBenchmarks();
+    react::bench::runReactFiberTransitionBenchmarks();
+    react::bench::runReactTypedComponentBenchmarks();
+    react::bench::runReactDOMComponentBenchmarks();
+    react::bench::runReactWasmRenderBenchmarks();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace react::bench {
+
+// Runs `body` `sampleCount` times (after one warm-up run) and prints a line in
+// the Benchmark.js format parsed by bin/run-benchmarks.py:
+//   <name> x <ops> ops/sec ±<rme>% (<n> runs sampled)
+// `setup` runs before every sample and is excluded from the measurement.
+template <typename Setup, typename Body>
+double runBenchmark(const std::string& name, std::size_t sampleCount, Setup&& setup, Body&& body) {
+  using Clock = std::chrono::steady_clock;
+
+  setup();
+  body();
+
+  std::vector<double> samples;
+  samples.reserve(sampleCount);
+  for (std::size_t i = 0; i < sampleCount; ++i) {
+    setup();
+    const auto start = Clock::now();
+    body();
+    const auto end = Clock::now();
+    samples.push_back(std::chrono::duration<double>(end - start).count());
+  }
+
+  double mean = 0.0;
+  for (double sample : samples) {
+    mean += sample;
+  }
+  mean /= static_cast<double>(samples.size());
+
+  double variance = 0.0;
+  for (double sample : samples) {
+    variance += (sample - mean) * (sample - mean);
+  }
+  variance /= samples.size() > 1 ? static_cast<double>(samples.size() - 1) : 1.0;
+  const double standardError = std::sqrt(variance / static_cast<double>(samples.size()));
+  const double relativeMarginOfError = mean > 0.0 ? (standardError * 1.96 / mean) * 100.0 : 0.0;
+
+  std::printf(
+      "%s x %.2f ops/sec ±%.2f%% (%zu runs sampled)\n",
+      name.c_str(),
+      mean > 0.0 ? 1.0 / mean : 0.0,
+      relativeMarginOfError,
+      samples.size());
+  return mean;
+}
+
+template <typename Body>
+double runBenchmark(const std::string& name, std::size_t sampleCount, Body&& body) {
+  return runBenchmark(name, sampleCount, [] {}, std::forward<Body>(body));
+}
+
+// Number of global operator new calls made so far by this process.
+std::size_t allocationCount();
+
+// Prints a counter collected alongside a benchmark (host ops, skipped
+// comparisons, allocations, ...).
+inline void reportMetric(const std::string& name, double value, const char* unit) {
+  std::printf("  %s: %.2f %s\n", name.c_str(), value, unit);
+}
+
+} // namespace react::bench
@@ -0,0 +1,206 @@
+#include "BenchmarkHarness.h"
+
+#include "react-dom/client/ReactDOMComponent.h"
+#include "react-dom/client/ReactDOMDiffProperties.h"
+#include "TestRuntime.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+constexpr std::size_t kChildCount = 10000;
+
+// Props for diffing: strings, numbers and one event handler, with a tenth of
+// the values, and one prop name at each end, differing between `generation`
+// 0 and 1.
+jsi::Value diffProps(jsi::Runtime& rt, std::size_t propCount, int generation) {
+  jsi::Object props(rt);
+  for (std::size_t i = 0; i < propCount; ++i) {
+    const std::string name = "data-prop-" + std::to_string(i);
+    const bool changed = i % 10 == 3;
+    if (i % 2 == 0) {
+      props.setProperty(rt, name.c_str(), jsi::String::createFromUtf8(rt, changed && generation == 1 ? "next" : "value"));
+    } else {
+      props.setProperty(rt, name.c_str(), static_cast<double>(changed ? i + generation : i));
+    }
+  }
+  props.setProperty(rt, "onClick", jsi::Object(rt));
+  props.setProperty(rt, generation == 0 ? "title" : "role", jsi::String::createFromUtf8(rt, "extra"));
+  return jsi::Value(rt, props);
+}
+
+constexpr const char* kAnimatedStyleNames[] = {
+  "position", "display", "top", "left", "width", "height", "margin", "padding",
+  "color", "backgroundColor", "borderRadius", "boxShadow", "fontSize", "fontWeight",
+  "lineHeight", "zIndex", "cursor", "overflow", "transform", "opacity",
+};
+
+// Props of an element whose 20-property style animates `transform` and
+// `opacity` by frame, as a fresh style object each render.
+jsi::Object animationFrameProps(jsi::Runtime& rt, int frame) {
+  jsi::Object style(rt);
+  for (const char* name : kAnimatedStyleNames) {
+    style.setProperty(rt, name, 10.0);
+  }
+  style.setProperty(rt, "transform", jsi::String::createFromUtf8(rt, "translateX(" + std::to_string(frame) + "px)"));
+  style.setProperty(rt, "opacity", static_cast<double>(frame % 100) / 100);
+  jsi::Object props(rt);
+  props.setProperty(rt, "id", jsi::String::createFromUtf8(rt, "sprite"));
+  props.setProperty(rt, "style", style);
+  return props;
+}
+
+} // namespace
+
+void runReactDOMComponentBenchmarks() {
+  test::TestRuntime rt;
+  jsi::Object props(rt);
+
+  std::vector<std::shared_ptr<ReactDOMInstance>> items;
+  items.reserve(kChildCount);
+  for (std::size_t i = 0; i < kChildCount; ++i) {
+    items.push_back(std::make_shared<ReactDOMComponent>(rt, "li", props));
+  }
+  std::vector<std::shared_ptr<ReactDOMInstance>> shuffled = items;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+
+  std::shared_ptr<ReactDOMComponent> parent;
+  auto freshParent = [&] {
+    if (parent) {
+      parent->removeAllChildren();
+    }
+    parent = std::make_shared<ReactDOMComponent>(rt, "ul", props);
+  };
+  auto filledParent = [&] {
+    freshParent();
+    parent->appendChildren(items.data(), items.data() + items.size());
+  };
+
+  runBenchmark("child list append one by one (10k children)", 10, freshParent, [&] {
+    for (const auto& item : items) {
+      parent->appendChild(item);
+    }
+  });
+
+  runBenchmark("child list insert at head (10k children)", 10, freshParent, [&] {
+    for (const auto& item : items) {
+      parent->insertChildBefore(item, parent->children.empty() ? nullptr : parent->children[0]);
+    }
+  });
+
+  runBenchmark("child list remove in random order (10k children)", 10, filledParent, [&] {
+    for (const auto& item : shuffled) {
+      parent->removeChild(item);
+    }
+  });
+
+  // Moves every child before a random sibling, as a keyed shuffle does.
+  runBenchmark("child list move before random sibling (10k children)", 10, filledParent, [&] {
+    for (std::size_t i = 0; i < kChildCount; ++i) {
+      parent->insertChildBefore(shuffled[i], items[(i * 7919) % kChildCount]);
+    }
+  });
+
+  std::size_t checksum = 0;
+  runBenchmark("child list positional reads after each move (10k children)", 10, filledParent, [&] {
+    for (std::size_t i = 0; i < kChildCount; i += 10) {
+      parent->insertChildBefore(items[i], nullptr);
+      checksum += static_cast<std::size_t>(parent->children[kChildCount / 2].use_count());
+    }
+  });
+  reportMetric("checksum", static_cast<double>(checksum), "");
+  freshParent();
+
+  // One attribute changed per commit on an element with 30 props.
+  constexpr int kPropCount = 30;
+  constexpr int kUpdates = 10000;
+  jsi::Object manyProps(rt);
+  for (int i = 0; i < kPropCount; ++i) {
+    manyProps.setProperty(rt, ("data-" + std::to_string(i)).c_str(), jsi::String::createFromUtf8(rt, "value"));
+  }
+  jsi::Object attributes(rt);
+  jsi::Object payload(rt);
+  payload.setProperty(rt, "attributes", attributes);
+  auto element = std::make_shared<ReactDOMComponent>(rt, "div", manyProps);
+  runBenchmark("applyUpdate one attribute of 30 props (10k commits)", 10, [&] {
+    for (int i = 0; i < kUpdates; ++i) {
+      const double value = static_cast<double>(i);
+      manyProps.setProperty(rt, "data-0", value);
+      attributes.setProperty(rt, "data-0", value);
+      element->applyUpdate(manyProps, payload);
+    }
+  });
+
+  // Every prop of a 30-prop element changed per commit, as a native payload
+  // of DOM attribute and style names.
+  constexpr const char* kPropNames[] = {
+    "id", "title", "className", "role", "tabIndex", "width", "height", "color",
+    "display", "position", "top", "left", "margin", "padding", "opacity",
+    "fontSize", "lineHeight", "cursor", "zIndex", "href", "alt", "src",
+    "value", "placeholder", "aria-label", "data-row", "data-column",
+    "data-state", "data-index", "data-owner",
+  };
+  static_assert(sizeof(kPropNames) / sizeof(kPropNames[0]) == kPropCount, "one name per prop");
+  jsi::Object namedProps(rt);
+  for (const char* name : kPropNames) {
+    namedProps.setProperty(rt, name, 0.0);
+  }
+  auto target = std::make_shared<ReactDOMComponent>(rt, "div", namedProps);
+  UpdatePayload nativePayload;
+  runBenchmark("applyUpdate 30 changed props, native payload (10k commits)", 10, [&] {
+    for (int i = 0; i < kUpdates; ++i) {
+      nativePayload.clear();
+      for (const char* name : kPropNames) {
+        nativePayload.set(name, UpdatePayloadValue::number(static_cast<double>(i)));
+      }
+      target->applyUpdate(nativePayload);
+    }
+  });
+
+  for (const std::size_t propCount : {5, 50, 500}) {
+    const jsi::Value previous = diffProps(rt, propCount, 0);
+    const jsi::Value next = diffProps(rt, propCount, 1);
+    const std::size_t diffCount = 100000 / propCount;
+    std::size_t changes = 0;
+    runBenchmark(
+        "diffReactDOMProperties (" + std::to_string(propCount) + " props, " + std::to_string(diffCount) + " diffs)",
+        10,
+        [&] {
+          for (std::size_t i = 0; i < diffCount; ++i) {
+            const auto diff = diffReactDOMProperties(rt, previous, next);
+            changes = diff.attributesToSet.size() + diff.attributesToRemove.size();
+          }
+        });
+    reportMetric("attribute changes per diff", static_cast<double>(changes), "");
+  }
+
+  // Style animation: each frame is diffed against the last and committed as
+  // a payload. The host traffic is the CSS declarations the payloads carry.
+  constexpr int kFrames = 2000;
+  std::vector<jsi::Object> frames;
+  frames.reserve(kFrames);
+  for (int i = 0; i < kFrames; ++i) {
+    frames.push_back(animationFrameProps(rt, i));
+  }
+  auto sprite = std::make_shared<ReactDOMComponent>(rt, "div", frames[0]);
+  std::size_t declarations = 0;
+  runBenchmark("style animation, 2 of 20 properties per frame (2k frames)", 10, [&] {
+    declarations = 0;
+    for (int i = 1; i < kFrames; ++i) {
+      const auto diff = diffReactDOMProperties(rt, jsi::Value(rt, frames[i - 1]), jsi::Value(rt, frames[i]));
+      declarations += diff.stylesToSet.size() + diff.stylesToRemove.size();
+      sprite->applyUpdate(frames[i], createReactDOMUpdatePayload(rt, diff));
+    }
+  });
+  reportMetric("style declarations sent per frame", static_cast<double>(declarations) / (kFrames - 1), "");
+}
+
+} // namespace react::bench
@@ -0,0 +1,190 @@
+#include "BenchmarkHarness.h"
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberConcurrentUpdates.h"
+#include "react-reconciler/ReactFiberLane.h"
+#include "react-reconciler/ReactWorkTags.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+constexpr std::size_t kSpineDepth = 32;
+constexpr std::size_t kLeafCount = 1000;
+constexpr std::size_t kUpdatesPerBatch = 100000;
+constexpr std::size_t kDeepSpineDepth = 256;
+constexpr std::size_t kDeepBranchDepth = 8;
+constexpr std::size_t kDeepLeafCount = 10000;
+
+struct UpdateTree {
+  FiberRoot rootState{};
+  std::vector<std::unique_ptr<FiberNode>> fibers{};
+  std::vector<FiberNode*> leaves{};
+
+  FiberNode* add(WorkTag tag, FiberNode* parent) {
+    fibers.emplace_back(createFiber(tag));
+    FiberNode* fiber = fibers.back().get();
+    fiber->returnFiber = parent;
+    if (parent != nullptr) {
+      fiber->sibling = parent->child;
+      parent->child = fiber;
+    }
+    return fiber;
+  }
+
+  void resetLanes() {
+    for (auto& fiber : fibers) {
+      fiber->lanes = NoLanes;
+      fiber->childLanes = NoLanes;
+    }
+    rootState.pendingLanes = NoLanes;
+  }
+};
+
+std::unique_ptr<UpdateTree> buildUpdateTree() {
+  auto tree = std::make_unique<UpdateTree>();
+  tree->rootState.tag = RootTag::ConcurrentRoot;
+  FiberNode* root = tree->add(WorkTag::HostRoot, nullptr);
+  root->stateNode = &tree->rootState;
+  tree->rootState.current = root;
+
+  FiberNode* spine = root;
+  for (std::size_t depth = 0; depth < kSpineDepth; ++depth) {
+    spine = tree->add(WorkTag::HostComponent, spine);
+  }
+  for (std::size_t i = 0; i < kLeafCount; ++i) {
+    tree->leaves.push_back(tree->add(WorkTag::FunctionComponent, spine));
+  }
+  return tree;
+}
+
+// A deep shared spine with every leaf at the end of its own short branch.
+std::unique_ptr<UpdateTree> buildDeepUpdateTree() {
+  auto tree = std::make_unique<UpdateTree>();
+  tree->rootState.tag = RootTag::ConcurrentRoot;
+  FiberNode* root = tree->add(WorkTag::HostRoot, nullptr);
+  root->stateNode = &tree->rootState;
+  tree->rootState.current = root;
+
+  FiberNode* spine = root;
+  for (std::size_t depth = 0; depth < kDeepSpineDepth; ++depth) {
+    spine = tree->add(WorkTag::HostComponent, spine);
+  }
+  for (std::size_t i = 0; i < kDeepLeafCount; ++i) {
+    FiberNode* branch = spine;
+    for (std::size_t depth = 0; depth < kDeepBranchDepth; ++depth) {
+      branch = tree->add(WorkTag::HostComponent, branch);
+    }
+    tree->leaves.push_back(tree->add(WorkTag::FunctionComponent, branch));
+  }
+  return tree;
+}
+
+void runDeepTreeLeafUpdateBenchmarks() {
+  auto tree = buildDeepUpdateTree();
+
+  runBenchmark(
+      "batched propagation (10k leaf updates, depth 264)",
+      20,
+      [&] {
+        tree->resetLanes();
+        for (FiberNode* leaf : tree->leaves) {
+          enqueueConcurrentRenderForLane(leaf, DefaultLane);
+        }
+      },
+      [] { finishQueueingConcurrentUpdates(); });
+
+  reportMetric(
+      "ancestor visits per batched flush",
+      static_cast<double>(ConcurrentUpdatesTestHelper::getLastFlushAncestorVisits()),
+      "fibers");
+
+  // Baseline: one full return-path walk per leaf update.
+  runBenchmark(
+      "per-update propagation (10k leaf updates, depth 264)",
+      20,
+      [&] { tree->resetLanes(); },
+      [&] {
+        for (FiberNode* leaf : tree->leaves) {
+          unsafe_markUpdateLaneFromFiberToRoot(leaf, DefaultLane);
+        }
+      });
+
+  reportMetric(
+      "ancestor visits per-update",
+      static_cast<double>(kDeepLeafCount * (kDeepSpineDepth + kDeepBranchDepth + 1)),
+      "fibers");
+}
+
+} // namespace
+
+void runReactFiberConcurrentUpdatesBenchmarks() {
+  auto tree = buildUpdateTree();
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<std::size_t> pickLeaf(0, kLeafCount - 1);
+  std::vector<std::size_t> targets(kUpdatesPerBatch);
+  for (auto& target : targets) {
+    target = pickLeaf(random);
+  }
+
+  std::vector<ConcurrentUpdate> updates(kUpdatesPerBatch);
+  std::vector<ConcurrentUpdateQueue> queues(kLeafCount);
+
+  auto enqueueBatch = [&] {
+    tree->resetLanes();
+    for (auto& queue : queues) {
+      queue.pending = nullptr;
+    }
+    for (std::size_t i = 0; i < kUpdatesPerBatch; ++i) {
+      updates[i].lane = DefaultLane;
+      enqueueConcurrentHookUpdate(tree->leaves[targets[i]], &queues[targets[i]], &updates[i], DefaultLane);
+    }
+  };
+
+  runBenchmark(
+      "finishQueueingConcurrentUpdates (100k updates, 1k leaves, depth 32)",
+      20,
+      enqueueBatch,
+      [] { finishQueueingConcurrentUpdates(); });
+
+  // Baseline: the ungrouped flush, splicing each update and walking its
+  // return path once per update.
+  runBenchmark(
+      "ungrouped flush (100k updates, 1k leaves, depth 32)",
+      20,
+      [&] {
+        tree->resetLanes();
+        for (auto& queue : queues) {
+          queue.pending = nullptr;
+        }
+      },
+      [&] {
+        for (std::size_t i = 0; i < kUpdatesPerBatch; ++i) {
+          auto& queue = queues[targets[i]];
+          ConcurrentUpdate* update = &updates[i];
+          if (queue.pending == nullptr) {
+            update->next = update;
+          } else {
+            update->next = queue.pending->next;
+            queue.pending->next = update;
+          }
+          queue.pending = update;
+          unsafe_markUpdateLaneFromFiberToRoot(tree->leaves[targets[i]], DefaultLane);
+        }
+      });
+
+  reportMetric(
+      "concurrent queue ring capacity after batches",
+      static_cast<double>(ConcurrentUpdatesTestHelper::getQueueCapacity()),
+      "entries");
+
+  runDeepTreeLeafUpdateBenchmarks();
+}
+
+} // namespace react::bench
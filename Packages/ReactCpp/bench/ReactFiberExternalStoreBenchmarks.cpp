@@ -0,0 +1,124 @@
+#include "BenchmarkHarness.h"
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberConcurrentUpdates.h"
+#include "react-reconciler/ReactFiberExternalStore.h"
+#include "react-reconciler/ReactFiberLane.h"
+#include "react-reconciler/ReactFiberRootScheduler.h"
+#include "runtime/ReactRuntime.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+constexpr std::size_t kSubscriberCount = 10000;
+constexpr std::size_t kSlotCount = 1000;
+constexpr std::size_t kWritesPerSample = 100;
+
+// Each subscriber selects one of 1000 slots, so a write to a slot changes the
+// selection of 10 subscribers and leaves the other 9990 unchanged.
+struct SlotState {
+  std::vector<int> slots = std::vector<int>(kSlotCount, 0);
+};
+
+struct SelectSlot {
+  std::size_t slot;
+  int operator()(const SlotState& state) const {
+    return state.slots[slot];
+  }
+};
+
+struct SubscriberTree {
+  FiberRoot root{};
+  FiberNode* hostRoot{nullptr};
+  std::vector<FiberNode*> consumers{};
+
+  SubscriberTree() {
+    hostRoot = createFiber(WorkTag::HostRoot);
+    hostRoot->stateNode = &root;
+    root.current = hostRoot;
+    FiberNode* previous = nullptr;
+    for (std::size_t i = 0; i < kSubscriberCount; ++i) {
+      FiberNode* consumer = createFiber(WorkTag::FunctionComponent);
+      consumer->returnFiber = hostRoot;
+      if (previous == nullptr) {
+        hostRoot->child = consumer;
+      } else {
+        previous->sibling = consumer;
+      }
+      previous = consumer;
+      consumers.push_back(consumer);
+    }
+  }
+
+  ~SubscriberTree() {
+    for (FiberNode* consumer : consumers) {
+      delete consumer->alternate;
+      delete consumer;
+    }
+    delete hostRoot->alternate;
+    delete hostRoot;
+  }
+};
+
+} // namespace
+
+void runReactFiberExternalStoreBenchmarks() {
+  ReactRuntime runtime;
+  SubscriberTree tree;
+  std::size_t nextSlot = 0;
+
+  {
+    ExternalStore<SlotState> store(runtime, SlotState{});
+    std::vector<std::unique_ptr<ExternalStoreSubscription<SlotState, SelectSlot>>> subscriptions;
+    subscriptions.reserve(kSubscriberCount);
+    for (std::size_t i = 0; i < kSubscriberCount; ++i) {
+      subscriptions.push_back(store.subscribe(*tree.consumers[i], SelectSlot{i % kSlotCount}));
+    }
+
+    const double seconds = runBenchmark(
+        "batched external store notify (10k subscribers, 100 writes)", 20, [&] {
+          for (std::size_t write = 0; write < kWritesPerSample; ++write) {
+            const std::size_t slot = nextSlot++ % kSlotCount;
+            store.update([slot](SlotState& state) { ++state.slots[slot]; });
+          }
+        });
+    reportMetric("store writes", kWritesPerSample / seconds, "writes/sec");
+    reportMetric("fibers scheduled per write", static_cast<double>(store.getLastNotifyStats().scheduledFibers), "");
+    reportMetric("root passes per write", static_cast<double>(store.getLastNotifyStats().scheduledRoots), "");
+  }
+
+  // Baseline: one listener per subscriber, each scheduling and flushing its
+  // own sync pass when its selection changes.
+  {
+    SlotState state;
+    std::vector<int> selections(kSubscriberCount, 0);
+    std::size_t rootPasses = 0;
+    const double seconds = runBenchmark(
+        "per-subscriber notify (10k subscribers, 100 writes)", 20, [&] {
+          for (std::size_t write = 0; write < kWritesPerSample; ++write) {
+            ++state.slots[nextSlot++ % kSlotCount];
+            rootPasses = 0;
+            for (std::size_t i = 0; i < kSubscriberCount; ++i) {
+              const int next = state.slots[i % kSlotCount];
+              if (next == selections[i]) {
+                continue;
+              }
+              selections[i] = next;
+              FiberRoot* root = enqueueConcurrentRenderForLane(tree.consumers[i], SyncLane);
+              finishQueueingConcurrentUpdates();
+              ensureRootIsScheduled(runtime, *root);
+              ++rootPasses;
+            }
+          }
+        });
+    reportMetric("store writes", kWritesPerSample / seconds, "writes/sec");
+    reportMetric("root passes per write", static_cast<double>(rootPasses), "");
+  }
+}
+
+} // namespace react::bench
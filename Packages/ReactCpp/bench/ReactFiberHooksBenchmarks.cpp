@@ -0,0 +1,225 @@
+#include "BenchmarkHarness.h"
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberHooks.h"
+#include "runtime/ReactRuntime.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+constexpr std::size_t kComponentCount = 10000;
+constexpr std::size_t kHooksPerComponent = 5;
+constexpr std::size_t kItemsPerComponent = 256;
+
+struct ComponentPair {
+  FiberNode* current{nullptr};
+  FiberNode* workInProgress{nullptr};
+};
+
+// The layout ReactFiberHooks.js uses: one heap node per hook, cloned node by
+// node for every work-in-progress render.
+struct LinkedHook {
+  void* memoizedState{nullptr};
+  void* baseState{nullptr};
+  void* baseQueue{nullptr};
+  void* queue{nullptr};
+  LinkedHook* next{nullptr};
+};
+
+void freeLinkedHooks(LinkedHook* hook) {
+  while (hook != nullptr) {
+    LinkedHook* next = hook->next;
+    delete hook;
+    hook = next;
+  }
+}
+
+// The derived value a compiled component would memoize: a filtered count over
+// the list it receives as props.
+std::uintptr_t countVisibleItems(const std::vector<int>& items) {
+  std::uintptr_t count = 0;
+  for (int item : items) {
+    count += (item % 3 == 0) ? 1 : 0;
+  }
+  return count;
+}
+
+} // namespace
+
+void runReactFiberHooksBenchmarks() {
+  ReactRuntime runtime;
+  std::vector<ComponentPair> components(kComponentCount);
+  std::uintptr_t sink = 0;
+
+  auto component = [&](std::size_t) {
+    std::uintptr_t sum = 0;
+    for (std::size_t i = 0; i < kHooksPerComponent; ++i) {
+      Hook& hook = nextWorkInProgressHook(runtime);
+      sum += reinterpret_cast<std::uintptr_t>(hook.memoizedState);
+      hook.memoizedState = reinterpret_cast<void*>(sum + i + 1);
+    }
+    return sum;
+  };
+
+  runBenchmark(
+      "hook slots mount (10k components x 5 hooks)",
+      20,
+      [&] {
+        for (auto& pair : components) {
+          if (pair.current != nullptr) {
+            releaseHookSlots(*pair.current);
+            delete pair.current->alternate;
+            delete pair.current;
+          }
+          pair.current = createFiber(WorkTag::FunctionComponent);
+          pair.workInProgress = nullptr;
+        }
+      },
+      [&] {
+        for (auto& pair : components) {
+          sink += renderWithHooks(runtime, nullptr, *pair.current, component, 0, DefaultLane);
+        }
+      });
+
+  runBenchmark(
+      "hook slots update (10k components x 5 hooks)",
+      20,
+      [&] {
+        for (auto& pair : components) {
+          pair.workInProgress = createWorkInProgress(pair.current, nullptr);
+        }
+      },
+      [&] {
+        for (auto& pair : components) {
+          sink += renderWithHooks(runtime, pair.current, *pair.workInProgress, component, 0, DefaultLane);
+          std::swap(pair.current, pair.workInProgress);
+        }
+      });
+
+  for (auto& pair : components) {
+    releaseHookSlots(*pair.current);
+    delete pair.current->alternate;
+    delete pair.current;
+  }
+
+  // Baseline: linked hook objects, cloned one allocation per hook per update.
+  std::vector<LinkedHook*> currentLists(kComponentCount, nullptr);
+  std::vector<LinkedHook*> workInProgressLists(kComponentCount, nullptr);
+  for (auto& list : currentLists) {
+    LinkedHook** tail = &list;
+    for (std::size_t i = 0; i < kHooksPerComponent; ++i) {
+      *tail = new LinkedHook();
+      tail = &(*tail)->next;
+    }
+  }
+
+  runBenchmark(
+      "linked hook list update (10k components x 5 hooks)",
+      20,
+      [&] {
+        for (std::size_t c = 0; c < kComponentCount; ++c) {
+          // The list left on the alternate by the previous render is garbage
+          // once this render starts; JS leaves it to the GC, C++ frees it.
+          freeLinkedHooks(workInProgressLists[c]);
+          workInProgressLists[c] = nullptr;
+          LinkedHook** tail = &workInProgressLists[c];
+          std::uintptr_t sum = 0;
+          std::size_t i = 0;
+          for (LinkedHook* hook = currentLists[c]; hook != nullptr; hook = hook->next, ++i) {
+            auto* clone = new LinkedHook(*hook);
+            clone->next = nullptr;
+            sum += reinterpret_cast<std::uintptr_t>(clone->memoizedState);
+            clone->memoizedState = reinterpret_cast<void*>(sum + i + 1);
+            *tail = clone;
+            tail = &clone->next;
+          }
+          sink += sum;
+        }
+      });
+
+  for (std::size_t c = 0; c < kComponentCount; ++c) {
+    freeLinkedHooks(currentLists[c]);
+    freeLinkedHooks(workInProgressLists[c]);
+  }
+
+  // useMemoCache: each component keeps its input and derived value in a
+  // two-slot block and skips the computation while the input is unchanged.
+  std::vector<std::vector<int>> items(kComponentCount, std::vector<int>(kItemsPerComponent));
+  for (std::size_t c = 0; c < kComponentCount; ++c) {
+    for (std::size_t i = 0; i < kItemsPerComponent; ++i) {
+      items[c][i] = static_cast<int>(c + i);
+    }
+  }
+  std::vector<std::uintptr_t> derived(kComponentCount);
+
+  auto memoizedComponent = [&](std::size_t c) {
+    std::vector<const void*>& cache = useMemoCache(runtime, 2);
+    if (cache[0] != &items[c]) {
+      derived[c] = countVisibleItems(items[c]);
+      cache[0] = &items[c];
+      cache[1] = &derived[c];
+    }
+    return *static_cast<const std::uintptr_t*>(cache[1]);
+  };
+
+  for (auto& pair : components) {
+    pair.current = createFiber(WorkTag::FunctionComponent);
+    pair.workInProgress = nullptr;
+  }
+  for (std::size_t c = 0; c < kComponentCount; ++c) {
+    sink += renderWithHooks(runtime, nullptr, *components[c].current, memoizedComponent, c, DefaultLane);
+  }
+
+  runBenchmark(
+      "memo cache update (10k components, unchanged input)",
+      20,
+      [&] {
+        for (auto& pair : components) {
+          pair.workInProgress = createWorkInProgress(pair.current, nullptr);
+        }
+      },
+      [&] {
+        for (std::size_t c = 0; c < kComponentCount; ++c) {
+          auto& pair = components[c];
+          sink += renderWithHooks(runtime, pair.current, *pair.workInProgress, memoizedComponent, c, DefaultLane);
+          std::swap(pair.current, pair.workInProgress);
+        }
+      });
+
+  runBenchmark(
+      "recomputed derived value (10k components, unchanged input)",
+      20,
+      [&] {
+        for (auto& pair : components) {
+          pair.workInProgress = createWorkInProgress(pair.current, nullptr);
+        }
+      },
+      [&] {
+        for (std::size_t c = 0; c < kComponentCount; ++c) {
+          auto& pair = components[c];
+          sink += renderWithHooks(
+              runtime,
+              pair.current,
+              *pair.workInProgress,
+              [&](std::size_t index) { return countVisibleItems(items[index]); },
+              c,
+              DefaultLane);
+          std::swap(pair.current, pair.workInProgress);
+        }
+      });
+
+  for (auto& pair : components) {
+    releaseHookSlots(*pair.current);
+    delete pair.current->alternate;
+    delete pair.current;
+  }
+
+  reportMetric("checksum", static_cast<double>(sink & 0xffff), "");
+}
+
+} // namespace react::bench
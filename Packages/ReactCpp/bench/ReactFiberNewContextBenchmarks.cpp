@@ -0,0 +1,189 @@
+#include "BenchmarkHarness.h"
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberNewContext.h"
+#include "runtime/ReactRuntime.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+constexpr std::size_t kPanelCount = 10;
+constexpr std::size_t kRowsPerPanel = 100;
+constexpr std::size_t kCellsPerRow = 49;
+constexpr std::size_t kConsumerCount = 10;
+
+int gValueA = 0;
+int gValueB = 0;
+
+// provider -> app -> 10 panels -> 100 rows each -> 49 cells each: ~50k fibers.
+struct ContextTree {
+  ReactContext context{&gValueA};
+  ReactContextProviderProps oldProps{&gValueA};
+  ReactContextProviderProps newProps{&gValueB};
+  FiberNode* providerCurrent{nullptr};
+  FiberNode* provider{nullptr};
+  std::vector<FiberNode*> fibers{};
+
+  ContextTree() {
+    providerCurrent = createFiber(WorkTag::ContextProvider);
+    provider = createFiber(WorkTag::ContextProvider);
+    provider->type = &context;
+    provider->alternate = providerCurrent;
+    providerCurrent->alternate = provider;
+    fibers.push_back(provider);
+
+    FiberNode* app = add(*provider, nullptr);
+    FiberNode* previousPanel = nullptr;
+    for (std::size_t p = 0; p < kPanelCount; ++p) {
+      FiberNode* panel = add(*app, previousPanel);
+      previousPanel = panel;
+      FiberNode* previousRow = nullptr;
+      for (std::size_t r = 0; r < kRowsPerPanel; ++r) {
+        FiberNode* row = add(*panel, previousRow);
+        previousRow = row;
+        FiberNode* previousCell = nullptr;
+        for (std::size_t c = 0; c < kCellsPerRow; ++c) {
+          previousCell = add(*row, previousCell);
+        }
+      }
+    }
+  }
+
+  ~ContextTree() {
+    for (FiberNode* fiber : fibers) {
+      delete fiber;
+    }
+    delete providerCurrent;
+  }
+
+  FiberNode* add(FiberNode& parent, FiberNode* previousSibling) {
+    FiberNode* fiber = createFiber(WorkTag::FunctionComponent);
+    fiber->returnFiber = &parent;
+    if (previousSibling == nullptr) {
+      parent.child = fiber;
+    } else {
+      previousSibling->sibling = fiber;
+    }
+    fibers.push_back(fiber);
+    return fiber;
+  }
+
+  void subscribe(ReactRuntime& runtime, FiberNode& consumer) {
+    prepareToReadContext(runtime, consumer, DefaultLane);
+    readContext(runtime, context);
+    resetContextDependencies(runtime);
+  }
+
+  void resetWork() {
+    for (FiberNode* fiber : fibers) {
+      fiber->lanes = NoLanes;
+      fiber->childLanes = NoLanes;
+      fiber->flags = NoFlags;
+    }
+  }
+};
+
+struct RenderCounters {
+  std::size_t consumerRenders{0};
+  std::size_t fiberRenders{0};
+};
+
+void renderFiber(ReactRuntime& runtime, ContextTree& tree, FiberNode& fiber, bool lazy, RenderCounters& counters);
+
+// The begin phase over fiber's children: fibers without scheduled work bail
+// out, and under lazy propagation they first search their subtree for
+// consumers of changed providers above them, as bailoutOnAlreadyFinishedWork
+// does.
+void beginChildren(ReactRuntime& runtime, ContextTree& tree, FiberNode& parent, bool lazy, RenderCounters& counters) {
+  for (FiberNode* child = parent.child; child != nullptr; child = child->sibling) {
+    bool hasWork = includesSomeLane(child->lanes, DefaultLane);
+    if (!hasWork && lazy && child->dependencies != nullptr) {
+      hasWork = checkIfContextChanged(*child->dependencies);
+    }
+    if (hasWork) {
+      renderFiber(runtime, tree, *child, lazy, counters);
+      continue;
+    }
+    if (lazy && !includesSomeLane(child->childLanes, DefaultLane)) {
+      lazilyPropagateParentContextChanges(*child, *child, DefaultLane);
+    }
+    if (includesSomeLane(child->childLanes, DefaultLane)) {
+      beginChildren(runtime, tree, *child, lazy, counters);
+    }
+  }
+}
+
+// A rendered component hands new elements to its children, so unmemoized
+// children render too instead of bailing out.
+void renderFiber(ReactRuntime& runtime, ContextTree& tree, FiberNode& fiber, bool lazy, RenderCounters& counters) {
+  if (fiber.dependencies != nullptr) {
+    tree.subscribe(runtime, fiber);
+    ++counters.consumerRenders;
+  }
+  ++counters.fiberRenders;
+  fiber.lanes = NoLanes;
+  for (FiberNode* child = fiber.child; child != nullptr; child = child->sibling) {
+    renderFiber(runtime, tree, *child, lazy, counters);
+  }
+}
+
+void renderProviderUpdate(ReactRuntime& runtime, ContextTree& tree, bool lazy, RenderCounters& counters) {
+  tree.provider->pendingProps = &tree.newProps;
+  tree.providerCurrent->memoizedProps = &tree.oldProps;
+  pushProvider(runtime, *tree.provider, tree.context, tree.newProps.value);
+  if (!lazy) {
+    propagateContextChange(*tree.provider, tree.context, DefaultLane);
+  }
+  beginChildren(runtime, tree, *tree.provider, lazy, counters);
+  popProvider(runtime, tree.context, *tree.provider);
+}
+
+void runScenario(const char* label, const std::vector<std::size_t>& consumerIndices) {
+  ReactRuntime runtime;
+  ContextTree tree;
+  for (std::size_t index : consumerIndices) {
+    tree.subscribe(runtime, *tree.fibers[index]);
+  }
+
+  for (bool lazy : {false, true}) {
+    RenderCounters counters;
+    const std::string name = std::string(lazy ? "lazy" : "eager") + " context propagation (" + label + ")";
+    runBenchmark(
+        name,
+        30,
+        [&] {
+          tree.resetWork();
+          counters = RenderCounters{};
+        },
+        [&] { renderProviderUpdate(runtime, tree, lazy, counters); });
+    reportMetric("consumer renders", static_cast<double>(counters.consumerRenders), "");
+    reportMetric("fiber renders", static_cast<double>(counters.fiberRenders), "");
+  }
+}
+
+} // namespace
+
+void runReactFiberNewContextBenchmarks() {
+  const std::size_t fibersPerPanel = 1 + kRowsPerPanel * (1 + kCellsPerRow);
+
+  // Ten consumers scattered over leaf cells, one per panel.
+  std::vector<std::size_t> leafConsumers;
+  for (std::size_t p = 0; p < kConsumerCount; ++p) {
+    leafConsumers.push_back(2 + p * fibersPerPanel + 1 + (p * 7 % kRowsPerPanel) * (1 + kCellsPerRow) + 1 + p);
+  }
+  runScenario("50k fibers, 10 leaf consumers", leafConsumers);
+
+  // Ten consumers near the top whose re-render reaches their whole subtree,
+  // which the eager walk has already searched before rendering starts.
+  std::vector<std::size_t> panelConsumers;
+  for (std::size_t p = 0; p < kConsumerCount; ++p) {
+    panelConsumers.push_back(2 + p * fibersPerPanel);
+  }
+  runScenario("50k fibers, 10 panel consumers", panelConsumers);
+}
+
+} // namespace react::bench
@@ -0,0 +1,119 @@
+#include "BenchmarkHarness.h"
+
+#include "react-reconciler/ReactCapturedValue.h"
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberClassUpdateQueue.h"
+#include "react-reconciler/ReactFiberLane.h"
+#include "react-reconciler/ReactFiberRootArena.h"
+#include "react-reconciler/ReactFiberSuspenseComponent.h"
+#include "react-reconciler/ReactFiberThrow.h"
+#include "react-reconciler/ReactFiberWorkLoop.h"
+#include "react-reconciler/ReactWorkTags.h"
+#include "runtime/ReactRuntime.h"
+
+#include <memory>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+constexpr std::size_t kBoundaryCount = 10000;
+
+struct ErrorTree {
+  FiberRoot rootState{};
+  std::vector<std::unique_ptr<FiberNode>> boundaries{};
+  std::vector<std::unique_ptr<FiberNode>> sources{};
+};
+
+std::unique_ptr<ErrorTree> buildErrorTree() {
+  auto tree = std::make_unique<ErrorTree>();
+  tree->rootState.tag = RootTag::ConcurrentRoot;
+  for (std::size_t i = 0; i < kBoundaryCount; ++i) {
+    tree->boundaries.emplace_back(createFiber(WorkTag::ClassComponent));
+    tree->sources.emplace_back(createFiber(WorkTag::FunctionComponent));
+    tree->sources.back()->returnFiber = tree->boundaries.back().get();
+  }
+  return tree;
+}
+
+} // namespace
+
+void runReactFiberRootArenaBenchmarks() {
+  ReactRuntime runtime;
+  auto tree = buildErrorTree();
+  static char thrownError[] = "error";
+
+  // Every boundary captures one error and records a retry entry, then the
+  // root commits idle and drops the retry queues at once. The captured
+  // updates stay on the boundaries' class queues.
+  runBenchmark(
+      "captured errors + retry queues, arena release (10k boundaries)",
+      20,
+      [&] {
+        setWorkInProgressRoot(runtime, &tree->rootState);
+        setWorkInProgressRootRenderLanes(runtime, DefaultLane);
+      },
+      [&] {
+        for (std::size_t i = 0; i < kBoundaryCount; ++i) {
+          throwException(
+              runtime,
+              tree->rootState,
+              tree->boundaries[i].get(),
+              *tree->sources[i],
+              thrownError,
+              DefaultLane);
+          auto* retryQueue =
+              tree->rootState.retryQueueArena.createForFiber<RetryQueue>(*tree->sources[i]);
+          retryQueue->insert(nullptr);
+        }
+        releaseRootRetryQueueArenaIfIdle(tree->rootState);
+      });
+
+  reportMetric(
+      "root arena bytes reserved after renders",
+      static_cast<double>(
+          tree->rootState.updateQueueArena.bytesReserved() + tree->rootState.retryQueueArena.bytesReserved()),
+      "bytes");
+
+  // Baseline: the same bookkeeping with one heap allocation per queue and
+  // update, freed object by object.
+  runBenchmark(
+      "captured errors + retry queues, per-object heap (10k boundaries)",
+      20,
+      [&] {
+        setWorkInProgressRoot(runtime, &tree->rootState);
+        setWorkInProgressRootRenderLanes(runtime, DefaultLane);
+      },
+      [&] {
+        std::vector<std::unique_ptr<ClassUpdateQueue>> queues;
+        std::vector<std::unique_ptr<ClassUpdate>> updates;
+        std::vector<std::unique_ptr<RetryQueue>> retryQueues;
+        for (std::size_t i = 0; i < kBoundaryCount; ++i) {
+          setWorkInProgressThrownValue(runtime, thrownError);
+          renderDidError(runtime);
+          CapturedValue errorInfo = createCapturedValueAtFiber(thrownError, tree->sources[i].get());
+          auto update = std::make_unique<ClassUpdate>();
+          update->lane = DefaultLane;
+          update->tag = ClassUpdateTag::CaptureUpdate;
+          initializeClassErrorUpdate(*update, tree->rootState, *tree->boundaries[i], errorInfo);
+          auto queue = std::make_unique<ClassUpdateQueue>();
+          queue->firstBaseUpdate = update.get();
+          queue->lastBaseUpdate = update.get();
+          tree->boundaries[i]->updateQueue = queue.get();
+          queues.push_back(std::move(queue));
+          updates.push_back(std::move(update));
+          retryQueues.push_back(std::make_unique<RetryQueue>());
+          retryQueues.back()->insert(nullptr);
+          tree->sources[i]->updateQueue = retryQueues.back().get();
+        }
+        for (std::size_t i = 0; i < kBoundaryCount; ++i) {
+          tree->boundaries[i]->updateQueue = nullptr;
+          tree->sources[i]->updateQueue = nullptr;
+        }
+      });
+
+  setWorkInProgressRoot(runtime, nullptr);
+}
+
+} // namespace react::bench
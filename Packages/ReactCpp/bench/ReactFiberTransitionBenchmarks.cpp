@@ -0,0 +1,240 @@
+#include "BenchmarkHarness.h"
+#include "TestFunctionComponents.h"
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberHooks.h"
+#include "react-reconciler/ReactFiberLane.h"
+#include "react-reconciler/ReactFiberTransition.h"
+#include "react-reconciler/ReactFiberWorkLoop.h"
+#include "runtime/ReactRuntime.h"
+#include "scheduler/Scheduler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+constexpr std::size_t kRowCount = 2000;
+constexpr std::size_t kKeystrokeCount = 20;
+constexpr double kKeystrokeIntervalMs = 50.0;
+constexpr std::size_t kFilterPassesPerRow = 4000;
+
+enum class FilterMode {
+  Blocking,
+  DeferredValue,
+  Transition,
+};
+
+// App -> [Input, Results -> 2000 rows]. Every keystroke updates the input;
+// re-filtering all rows takes about half a keystroke interval, so a sync
+// filter delays the input echo by that much.
+struct TypingState {
+  FilterMode mode{FilterMode::Blocking};
+  const std::string* text{nullptr};
+  const std::string* transitionQuery{nullptr};
+  const std::string* renderingQuery{nullptr};
+  std::uint64_t sink{0};
+};
+
+TypingState gTyping;
+
+const void* renderApp(ReactRuntime&, const void*) {
+  return gTyping.text;
+}
+
+const void* renderInput(ReactRuntime&, const void*) {
+  gTyping.sink += gTyping.text->size();
+  return nullptr;
+}
+
+const void* renderResults(ReactRuntime& runtime, const void*) {
+  const std::string* query = gTyping.text;
+  if (gTyping.mode == FilterMode::DeferredValue) {
+    // The prefixes outlive the session, so comparing pointers compares text.
+    query = useDeferredValue(runtime, gTyping.text);
+  } else if (gTyping.mode == FilterMode::Transition) {
+    query = gTyping.transitionQuery;
+  }
+  gTyping.renderingQuery = query;
+  return query;
+}
+
+// Scores the row label against the query, standing in for a filter that
+// does real work per row.
+const void* renderRow(ReactRuntime&, const void* props) {
+  const auto& label = *static_cast<const std::string*>(props);
+  const std::string& query = *gTyping.renderingQuery;
+  std::uint64_t score = label.find(query) != std::string::npos ? 1 : 0;
+  for (std::size_t pass = 0; pass < kFilterPassesPerRow; ++pass) {
+    score = score * 6364136223846793005ULL + label[pass % label.size()] + query.size();
+  }
+  gTyping.sink += score;
+  return nullptr;
+}
+
+const test::TestFunctionComponent kApp{"App", &renderApp};
+const test::TestFunctionComponent kInput{"Input", &renderInput};
+const test::TestFunctionComponent kResults{"Results", &renderResults};
+const test::TestFunctionComponent kRow{"Row", &renderRow};
+
+struct TypingTree {
+  FiberRoot root{};
+  FiberNode* hostRoot{nullptr};
+  FiberNode* app{nullptr};
+  FiberNode* input{nullptr};
+  FiberNode* results{nullptr};
+  std::vector<FiberNode*> rows{};
+
+  explicit TypingTree(std::vector<std::string>& labels) {
+    hostRoot = createFiber(WorkTag::HostRoot);
+    hostRoot->stateNode = &root;
+    root.current = hostRoot;
+    app = test::appendTestComponent(kApp, *hostRoot, nullptr);
+    input = test::appendTestComponent(kInput, *app, nullptr);
+    results = test::appendTestComponent(kResults, *app, input);
+    for (std::string& label : labels) {
+      FiberNode* row = test::appendTestComponent(kRow, *results, rows.empty() ? nullptr : rows.back());
+      row->pendingProps = &label;
+      rows.push_back(row);
+    }
+  }
+
+  ~TypingTree() {
+    for (FiberNode* row : rows) {
+      release(row);
+    }
+    release(results);
+    release(input);
+    release(app);
+    delete hostRoot->alternate;
+    delete hostRoot;
+  }
+
+  static void release(FiberNode* fiber) {
+    releaseHookSlots(*fiber);
+    delete fiber->alternate;
+    delete fiber;
+  }
+};
+
+struct TypingResult {
+  std::vector<double> latenciesMs{};
+  std::size_t filterCommits{0};
+  std::size_t sessions{0};
+};
+
+// Types kKeystrokeCount characters, one every kKeystrokeIntervalMs. Between
+// keystrokes the host loop runs scheduler tasks, like a browser event loop
+// running React's work between input events. Latency is measured from when
+// a keystroke was due to when its sync update committed.
+void typeQuery(
+    ReactRuntime& runtime,
+    TypingTree& tree,
+    const std::vector<std::string>& prefixes,
+    TypingResult& result) {
+  ++result.sessions;
+  gTyping.text = &prefixes[0];
+  gTyping.transitionQuery = &prefixes[0];
+  runtime.runWithPriority(SchedulerPriority::ImmediatePriority, [&] { scheduleFiberUpdate(runtime, *tree.app); });
+
+  double due = runtime.now();
+  std::size_t keystroke = 1;
+  while (keystroke < prefixes.size() || runtime.hasPendingTasks()) {
+    if (keystroke < prefixes.size() && runtime.now() >= due) {
+      const std::string& text = prefixes[keystroke++];
+      gTyping.text = &text;
+      if (gTyping.mode == FilterMode::Transition) {
+        runtime.runWithPriority(SchedulerPriority::ImmediatePriority, [&] {
+          scheduleFiberUpdate(runtime, *tree.input);
+          startTransition(runtime, [&] {
+            gTyping.transitionQuery = &text;
+            scheduleFiberUpdate(runtime, *tree.results);
+          });
+        });
+      } else {
+        FiberNode& target = gTyping.mode == FilterMode::Blocking ? *tree.results : *tree.app;
+        runtime.runWithPriority(SchedulerPriority::ImmediatePriority, [&] {
+          scheduleFiberUpdate(runtime, *tree.input);
+          scheduleFiberUpdate(runtime, target);
+        });
+      }
+      result.latenciesMs.push_back(runtime.now() - due);
+      if (gTyping.mode == FilterMode::Blocking) {
+        ++result.filterCommits;
+      }
+      due += kKeystrokeIntervalMs;
+      continue;
+    }
+    if (runtime.hasPendingTasks()) {
+      const Lanes before = tree.root.pendingLanes;
+      runtime.runNextTask();
+      if (before != NoLanes && tree.root.pendingLanes == NoLanes) {
+        ++result.filterCommits;
+      }
+    }
+  }
+}
+
+double percentile(std::vector<double> values, double fraction) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  const auto index = static_cast<std::size_t>(fraction * static_cast<double>(values.size() - 1));
+  return values[index];
+}
+
+} // namespace
+
+void runReactFiberTransitionBenchmarks() {
+  std::vector<std::string> labels;
+  labels.reserve(kRowCount);
+  for (std::size_t i = 0; i < kRowCount; ++i) {
+    labels.push_back("row " + std::to_string(i) + " transition deferred value filter");
+  }
+  const std::string typed = "transition deferred value filter";
+  std::vector<std::string> prefixes;
+  for (std::size_t length = 0; length <= kKeystrokeCount; ++length) {
+    prefixes.push_back(typed.substr(0, length));
+  }
+
+  const struct {
+    FilterMode mode;
+    const char* name;
+  } modes[] = {
+      {FilterMode::Blocking, "blocking filter"},
+      {FilterMode::DeferredValue, "useDeferredValue filter"},
+      {FilterMode::Transition, "startTransition filter"},
+  };
+
+  for (const auto& entry : modes) {
+    ReactRuntime runtime;
+    // typeQuery polls hasPendingTasks between keystrokes rather than waiting
+    // for host callbacks.
+    runtime.setTaskDriver([] {});
+    test::installTestComponents(runtime);
+    gTyping = TypingState{};
+    gTyping.mode = entry.mode;
+    TypingResult result;
+    runBenchmark(
+        std::string("typing session, ") + entry.name + " (2000 rows, 20 keys @ 50ms)", 2, [&] {
+          TypingTree tree(labels);
+          typeQuery(runtime, tree, prefixes, result);
+        });
+    reportMetric("input latency p50", percentile(result.latenciesMs, 0.5), "ms");
+    reportMetric("input latency max", percentile(result.latenciesMs, 1.0), "ms");
+    reportMetric(
+        "filter commits per session",
+        static_cast<double>(result.filterCommits) / static_cast<double>(result.sessions),
+        "");
+  }
+
+  reportMetric("checksum", static_cast<double>(gTyping.sink & 0xffff), "");
+}
+
+} // namespace react::bench
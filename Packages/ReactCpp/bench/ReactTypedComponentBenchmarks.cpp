@@ -0,0 +1,242 @@
+#include "BenchmarkHarness.h"
+
+#include "react-dom/client/ReactDOMComponent.h"
+#include "runtime/ReactHostInterface.h"
+#include "runtime/ReactJSXRuntime.h"
+#include "runtime/ReactRuntime.h"
+#include "runtime/ReactTypedComponent.h"
+#include "runtime/ReactWasmBridge.h"
+#include "runtime/ReactWindowedList.h"
+#include "TestRuntime.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+constexpr std::size_t kRowCount = 1000;
+constexpr std::size_t kWindowedRowCount = 100000;
+constexpr std::size_t kScrollStepCount = 100;
+// A 600-unit viewport scrolled one 120-unit wheel tick per step.
+constexpr double kViewportHeight = 600;
+constexpr double kScrollStep = 120;
+
+struct RowData {
+  int id;
+  std::string label;
+  bool selected;
+};
+
+struct Row {
+  struct Props {
+    int id;
+    std::string label;
+    bool selected;
+    auto tie() const {
+      return std::tie(id, label, selected);
+    }
+  };
+
+  static TypedElement render(const Props& props) {
+    return typedHost(
+        "li",
+        {{"className", std::string(props.selected ? "row selected" : "row")}, {"dataId", double(props.id)}},
+        {typedText(props.label)});
+  }
+};
+
+double windowedRowHeight(std::size_t index) {
+  return index % 5 == 0 ? 48.0 : 24.0;
+}
+
+TypedElement windowedRow(std::size_t index) {
+  return typedComponent<Row>({static_cast<int>(index), "Row " + std::to_string(index), false});
+}
+
+// Counts the host calls a scroll step makes.
+struct ScrollHostCounts : HostInterface {
+  std::size_t creates{0};
+  std::size_t childCalls{0};
+
+  std::shared_ptr<ReactDOMInstance> createHostInstance(
+      jsi::Runtime& runtime,
+      const std::string& type,
+      const jsi::Object& props) override {
+    ++creates;
+    return HostInterface::createHostInstance(runtime, type, props);
+  }
+
+  std::shared_ptr<ReactDOMInstance> createHostTextInstance(jsi::Runtime& runtime, const std::string& text) override {
+    ++creates;
+    return HostInterface::createHostTextInstance(runtime, text);
+  }
+
+  void appendHostChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child) override {
+    ++childCalls;
+    HostInterface::appendHostChild(std::move(parent), std::move(child));
+  }
+
+  void removeHostChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child) override {
+    ++childCalls;
+    HostInterface::removeHostChild(std::move(parent), std::move(child));
+  }
+
+  void insertHostChildBefore(
+      std::shared_ptr<ReactDOMInstance> parent,
+      std::shared_ptr<ReactDOMInstance> child,
+      std::shared_ptr<ReactDOMInstance> beforeChild) override {
+    ++childCalls;
+    HostInterface::insertHostChildBefore(std::move(parent), std::move(child), std::move(beforeChild));
+  }
+
+  void resetCounts() {
+    creates = childCalls = 0;
+  }
+};
+
+TypedElement typedList(const std::vector<RowData>& rows) {
+  std::vector<TypedElement> children;
+  children.reserve(rows.size());
+  for (const auto& row : rows) {
+    children.push_back(typedComponent<Row>({row.id, row.label, row.selected}, std::to_string(row.id)));
+  }
+  return typedHost("ul", {}, std::move(children));
+}
+
+// The same tree as JSX host elements, rendered through the wasm layout and the
+// JSI reconciler, which diffs every row's props on each render.
+jsx::WasmSerializedLayout jsiList(jsi::Runtime& rt, const std::vector<RowData>& rows) {
+  auto stringValue = [&rt](const std::string& text) {
+    return jsi::Value(rt, jsi::String::createFromUtf8(rt, text));
+  };
+
+  jsi::Array children(rt, rows.size());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    const auto& row = rows[i];
+    jsx::PropList props;
+    props.emplace_back("className", stringValue(row.selected ? "row selected" : "row"));
+    props.emplace_back("dataId", jsi::Value(static_cast<double>(row.id)));
+    props.emplace_back("children", stringValue(row.label));
+    auto element = jsx::jsx(rt, stringValue("li"), std::move(props), stringValue(std::to_string(row.id)));
+    children.setValueAtIndex(rt, i, jsx::createJsxHostValue(rt, element));
+  }
+
+  jsx::PropList listProps;
+  listProps.emplace_back("children", jsi::Value(rt, children));
+  auto list = jsx::jsxs(rt, stringValue("ul"), std::move(listProps));
+  return jsx::serializeToWasm(rt, *list);
+}
+
+} // namespace
+
+void runReactTypedComponentBenchmarks() {
+  test::TestRuntime rt;
+  ReactRuntime runtime;
+  jsi::Object rootProps(rt);
+
+  std::vector<RowData> rows;
+  rows.reserve(kRowCount);
+  for (std::size_t i = 0; i < kRowCount; ++i) {
+    rows.push_back({static_cast<int>(i), "Row " + std::to_string(i), false});
+  }
+
+  std::size_t toggle = 0;
+  auto selectNextRow = [&] {
+    rows[toggle % kRowCount].selected = false;
+    ++toggle;
+    rows[toggle % kRowCount].selected = true;
+  };
+
+  auto typedContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+  runtime.renderTypedRootSync(rt, typedList(rows), typedContainer);
+  std::size_t bailouts = 0;
+  runBenchmark(
+      "typed components update (1000 memoized rows, 1 changed)",
+      20,
+      [&] { selectNextRow(); },
+      [&] {
+        runtime.renderTypedRootSync(rt, typedList(rows), typedContainer);
+        bailouts = runtime.getLastTypedRenderStats().memoBailouts;
+      });
+  reportMetric("typed memo bailouts per render", static_cast<double>(bailouts), "");
+
+  auto jsiContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+  jsx::WasmSerializedLayout layout = jsiList(rt, rows);
+  __wasm_memory_buffer = layout.buffer.data();
+  runtime.renderRootSync(rt, layout.rootOffset, jsiContainer);
+  runBenchmark(
+      "jsi elements update (1000 rows, 1 changed)",
+      20,
+      [&] { selectNextRow(); },
+      [&] {
+        layout = jsiList(rt, rows);
+        __wasm_memory_buffer = layout.buffer.data();
+        runtime.renderRootSync(rt, layout.rootOffset, jsiContainer);
+      });
+  __wasm_memory_buffer = nullptr;
+
+  // A 100k-row list: mounting every row against mounting the window, then
+  // scrolling the window one wheel tick at a time.
+  {
+    std::vector<TypedElement> allRows;
+    allRows.reserve(kWindowedRowCount);
+    for (std::size_t i = 0; i < kWindowedRowCount; ++i) {
+      allRows.push_back(windowedRow(i));
+      allRows.back().key = std::to_string(i);
+    }
+    const TypedElement fullList = typedHost("div", {}, std::move(allRows));
+    ReactRuntime fullRuntime;
+    runBenchmark(
+        "full list mount (100k rows)",
+        3,
+        [&] { fullRuntime.reset(); },
+        [&] {
+          auto fullContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+          fullRuntime.renderTypedRootSync(rt, fullList, fullContainer);
+        });
+
+    ReactRuntime windowRuntime;
+    auto host = std::make_shared<ScrollHostCounts>();
+    windowRuntime.setHostInterface(host);
+    WindowedList list({kWindowedRowCount, &windowedRowHeight, &windowedRow});
+    list.setViewport(0, kViewportHeight);
+    std::shared_ptr<ReactDOMComponent> windowContainer;
+    runBenchmark(
+        "windowed list mount (100k rows)",
+        5,
+        [&] {
+          if (windowContainer) {
+            windowRuntime.unregisterRootContainer(windowContainer.get());
+          }
+          windowContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+        },
+        [&] { windowRuntime.renderTypedRootSync(rt, list.render(), windowContainer); });
+    reportMetric("mounted rows", static_cast<double>(list.window().size()), "");
+
+    double scrollOffset = 0;
+    const double seconds = runBenchmark(
+        "windowed list scroll (100k rows, 100 steps)",
+        20,
+        [&] { host->resetCounts(); },
+        [&] {
+          for (std::size_t step = 0; step < kScrollStepCount; ++step) {
+            scrollOffset += kScrollStep;
+            if (scrollOffset + kViewportHeight > list.layout().totalHeight()) {
+              scrollOffset = 0;
+            }
+            list.setViewport(scrollOffset, kViewportHeight);
+            windowRuntime.renderTypedRootSync(rt, list.render(), windowContainer);
+          }
+        });
+    reportMetric("time per scroll step", seconds / kScrollStepCount * 1e6, "us");
+    reportMetric("host creates per step", static_cast<double>(host->creates) / kScrollStepCount, "");
+    reportMetric("host child calls per step", static_cast<double>(host->childCalls) / kScrollStepCount, "");
+  }
+}
+
+} // namespace react::bench
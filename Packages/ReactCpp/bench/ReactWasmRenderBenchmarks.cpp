@@ -0,0 +1,637 @@
+#include "BenchmarkHarness.h"
+
+#include "react-dom/client/ReactDOMComponent.h"
+#include "runtime/ReactHostInterface.h"
+#include "runtime/ReactJSXRuntime.h"
+#include "runtime/ReactRuntime.h"
+#include "runtime/ReactWasmBridge.h"
+#include "TestRuntime.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace react::bench {
+
+namespace {
+
+namespace jsi = facebook::jsi;
+
+constexpr std::size_t kWidgetCount = 12;
+constexpr std::size_t kMetricsPerWidget = 8;
+constexpr std::size_t kKeyedRowCount = 10000;
+constexpr std::size_t kKeyedEditCount = 100;
+constexpr std::size_t kBulkRowCount = 50000;
+// Each row is an <li> and its text: 50k host nodes.
+constexpr std::size_t kHostCallRowCount = 25000;
+// Each table row is <tr><td>label</td><td>value</td></tr>: five nodes.
+constexpr std::size_t kTableRowCount = 4000;
+constexpr std::size_t kTableNodeCount = kTableRowCount * 5;
+constexpr std::size_t kUpdateTableRowCount = 2000;
+constexpr std::size_t kNumericRowCount = 10000;
+constexpr std::size_t kNumericCellsPerRow = 10;
+constexpr std::size_t kSwatchCount = 5000;
+constexpr std::size_t kSwatchPropUpdates = kSwatchCount * 3;
+
+jsi::Value stringValue(jsi::Runtime& rt, const std::string& text) {
+  return jsi::Value(rt, jsi::String::createFromUtf8(rt, text));
+}
+
+jsi::Value hostElement(jsi::Runtime& rt, const char* type, jsx::PropList props) {
+  return jsx::createJsxHostValue(rt, jsx::jsx(rt, stringValue(rt, type), std::move(props)));
+}
+
+// A dashboard of widgets with a handful of metric rows each; one metric value
+// ticks per render and everything else is unchanged.
+jsx::WasmSerializedLayout dashboard(jsi::Runtime& rt, std::size_t tick) {
+  jsi::Array widgets(rt, kWidgetCount);
+  for (std::size_t w = 0; w < kWidgetCount; ++w) {
+    jsi::Array rows(rt, kMetricsPerWidget + 1);
+
+    jsx::PropList headerProps;
+    headerProps.emplace_back("className", stringValue(rt, "widget-header"));
+    headerProps.emplace_back("children", stringValue(rt, "Widget " + std::to_string(w)));
+    rows.setValueAtIndex(rt, 0, hostElement(rt, "header", std::move(headerProps)));
+
+    for (std::size_t m = 0; m < kMetricsPerWidget; ++m) {
+      const bool ticking = w == 0 && m == 0;
+      const double value = ticking ? static_cast<double>(tick) : static_cast<double>(w * 100 + m);
+
+      jsx::PropList labelProps;
+      labelProps.emplace_back("className", stringValue(rt, "metric-label"));
+      labelProps.emplace_back("children", stringValue(rt, "Metric " + std::to_string(m)));
+
+      jsx::PropList valueProps;
+      valueProps.emplace_back("className", stringValue(rt, "metric-value"));
+      valueProps.emplace_back("dataTrend", stringValue(rt, ticking && tick % 2 == 1 ? "up" : "flat"));
+      valueProps.emplace_back("children", jsi::Value(value));
+
+      jsi::Array cells(rt, 2);
+      cells.setValueAtIndex(rt, 0, hostElement(rt, "span", std::move(labelProps)));
+      cells.setValueAtIndex(rt, 1, hostElement(rt, "span", std::move(valueProps)));
+
+      jsx::PropList rowProps;
+      rowProps.emplace_back("className", stringValue(rt, "metric"));
+      rowProps.emplace_back("dataMetric", stringValue(rt, std::to_string(m)));
+      rowProps.emplace_back("role", stringValue(rt, "row"));
+      rowProps.emplace_back("children", jsi::Value(rt, cells));
+      rows.setValueAtIndex(rt, m + 1, hostElement(rt, "div", std::move(rowProps)));
+    }
+
+    jsx::PropList widgetProps;
+    widgetProps.emplace_back("className", stringValue(rt, "widget"));
+    widgetProps.emplace_back("id", stringValue(rt, "widget-" + std::to_string(w)));
+    widgetProps.emplace_back("width", jsi::Value(320.0));
+    widgetProps.emplace_back("height", jsi::Value(240.0));
+    widgetProps.emplace_back("draggable", jsi::Value(true));
+    widgetProps.emplace_back("children", jsi::Value(rt, rows));
+    widgets.setValueAtIndex(rt, w, hostElement(rt, "section", std::move(widgetProps)));
+  }
+
+  jsx::PropList rootProps;
+  rootProps.emplace_back("className", stringValue(rt, "dashboard"));
+  rootProps.emplace_back("children", jsi::Value(rt, widgets));
+  return jsx::serializeToWasm(rt, *jsx::jsxs(rt, stringValue(rt, "main"), std::move(rootProps)));
+}
+
+// A <ul> of keyed <li> rows, one per entry of `order`.
+jsx::WasmSerializedLayout keyedList(jsi::Runtime& rt, const std::vector<std::size_t>& order) {
+  jsi::Array rows(rt, order.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    jsx::PropList rowProps;
+    rowProps.emplace_back("className", stringValue(rt, "row"));
+    rowProps.emplace_back("children", stringValue(rt, "Row " + std::to_string(order[i])));
+    rows.setValueAtIndex(
+        rt,
+        i,
+        jsx::createJsxHostValue(
+            rt, jsx::jsx(rt, stringValue(rt, "li"), std::move(rowProps), stringValue(rt, std::to_string(order[i])))));
+  }
+
+  jsx::PropList listProps;
+  listProps.emplace_back("children", jsi::Value(rt, rows));
+  return jsx::serializeToWasm(rt, *jsx::jsxs(rt, stringValue(rt, "ul"), std::move(listProps)));
+}
+
+// A table of `rowCount` rows, 20k nodes by default. `revision` changes the
+// value cell's text and the row's data attribute of every
+// `changedRowStride`-th row.
+jsx::WasmSerializedLayout table(
+    jsi::Runtime& rt,
+    std::size_t revision,
+    std::size_t changedRowStride = 1,
+    std::size_t rowCount = kTableRowCount) {
+  jsi::Array rows(rt, rowCount);
+  for (std::size_t i = 0; i < rowCount; ++i) {
+    const std::size_t rowRevision = i % changedRowStride == 0 ? revision : 0;
+    jsx::PropList labelProps;
+    labelProps.emplace_back("className", stringValue(rt, "label"));
+    labelProps.emplace_back("children", stringValue(rt, "Item " + std::to_string(i)));
+
+    jsx::PropList valueProps;
+    valueProps.emplace_back("className", stringValue(rt, "value"));
+    valueProps.emplace_back("align", stringValue(rt, "right"));
+    valueProps.emplace_back("children", jsi::Value(static_cast<double>(i * 10 + rowRevision)));
+
+    jsi::Array cells(rt, 2);
+    cells.setValueAtIndex(rt, 0, hostElement(rt, "td", std::move(labelProps)));
+    cells.setValueAtIndex(rt, 1, hostElement(rt, "td", std::move(valueProps)));
+
+    jsx::PropList rowProps;
+    rowProps.emplace_back("className", stringValue(rt, i % 2 == 0 ? "even" : "odd"));
+    rowProps.emplace_back("dataRevision", jsi::Value(static_cast<double>(rowRevision)));
+    rowProps.emplace_back("children", jsi::Value(rt, cells));
+    rows.setValueAtIndex(
+        rt,
+        i,
+        jsx::createJsxHostValue(
+            rt, jsx::jsx(rt, stringValue(rt, "tr"), std::move(rowProps), stringValue(rt, std::to_string(i)))));
+  }
+
+  jsx::PropList tableProps;
+  tableProps.emplace_back("children", jsi::Value(rt, rows));
+  return jsx::serializeToWasm(rt, *jsx::jsxs(rt, stringValue(rt, "tbody"), std::move(tableProps)));
+}
+
+// Rows of a "Row <n>" label cell and ten numeric cells, 100k numbers in all.
+// `revision` shifts every number, so an update rewrites every numeric cell.
+jsx::WasmSerializedLayout numericTable(jsi::Runtime& rt, std::size_t revision) {
+  jsi::Array rows(rt, kNumericRowCount);
+  for (std::size_t i = 0; i < kNumericRowCount; ++i) {
+    jsi::Array cells(rt, kNumericCellsPerRow + 1);
+    jsi::Array label(rt, 2);
+    label.setValueAtIndex(rt, 0, stringValue(rt, "Row "));
+    label.setValueAtIndex(rt, 1, jsi::Value(static_cast<double>(i)));
+    jsx::PropList labelProps;
+    labelProps.emplace_back("children", jsi::Value(rt, label));
+    cells.setValueAtIndex(rt, 0, hostElement(rt, "th", std::move(labelProps)));
+    for (std::size_t c = 0; c < kNumericCellsPerRow; ++c) {
+      jsx::PropList cellProps;
+      cellProps.emplace_back(
+          "children", jsi::Value(static_cast<double>(i * kNumericCellsPerRow + c + revision) * 0.25));
+      cells.setValueAtIndex(rt, c + 1, hostElement(rt, "td", std::move(cellProps)));
+    }
+
+    jsx::PropList rowProps;
+    rowProps.emplace_back("children", jsi::Value(rt, cells));
+    rows.setValueAtIndex(rt, i, hostElement(rt, "tr", std::move(rowProps)));
+  }
+
+  jsx::PropList tableProps;
+  tableProps.emplace_back("children", jsi::Value(rt, rows));
+  return jsx::serializeToWasm(rt, *jsx::jsxs(rt, stringValue(rt, "tbody"), std::move(tableProps)));
+}
+
+// Childless swatches whose className, title and width change with every
+// `revision`, so each render commits three prop updates per element.
+jsx::WasmSerializedLayout swatches(jsi::Runtime& rt, std::size_t revision) {
+  jsi::Array items(rt, kSwatchCount);
+  for (std::size_t i = 0; i < kSwatchCount; ++i) {
+    jsx::PropList props;
+    props.emplace_back("className", stringValue(rt, revision % 2 == 0 ? "swatch" : "swatch active"));
+    props.emplace_back("title", stringValue(rt, "Swatch " + std::to_string(i + revision)));
+    props.emplace_back("width", jsi::Value(static_cast<double>(i + revision)));
+    props.emplace_back("role", stringValue(rt, "option"));
+    items.setValueAtIndex(rt, i, hostElement(rt, "div", std::move(props)));
+  }
+
+  jsx::PropList paletteProps;
+  paletteProps.emplace_back("children", jsi::Value(rt, items));
+  return jsx::serializeToWasm(rt, *jsx::jsxs(rt, stringValue(rt, "section"), std::move(paletteProps)));
+}
+
+struct CountingHostInterface : HostInterface {
+  std::size_t creates{0};
+  std::size_t appends{0};
+  std::size_t inserts{0};
+  std::size_t removes{0};
+  // Host calls that attach, move or detach children; bulk calls count once
+  // here and per node above.
+  std::size_t childCalls{0};
+
+  std::shared_ptr<ReactDOMInstance> createHostInstance(
+      jsi::Runtime& runtime,
+      const std::string& type,
+      const jsi::Object& props) override {
+    ++creates;
+    return HostInterface::createHostInstance(runtime, type, props);
+  }
+
+  std::shared_ptr<ReactDOMInstance> createHostTextInstance(jsi::Runtime& runtime, const std::string& text) override {
+    ++creates;
+    return HostInterface::createHostTextInstance(runtime, text);
+  }
+
+  void appendHostChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child) override {
+    ++childCalls;
+    ++appends;
+    HostInterface::appendHostChild(std::move(parent), std::move(child));
+  }
+
+  void removeHostChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child) override {
+    ++childCalls;
+    ++removes;
+    HostInterface::removeHostChild(std::move(parent), std::move(child));
+  }
+
+  void insertHostChildBefore(
+      std::shared_ptr<ReactDOMInstance> parent,
+      std::shared_ptr<ReactDOMInstance> child,
+      std::shared_ptr<ReactDOMInstance> beforeChild) override {
+    ++childCalls;
+    ++inserts;
+    HostInterface::insertHostChildBefore(std::move(parent), std::move(child), std::move(beforeChild));
+  }
+
+  void removeAllHostChildren(std::shared_ptr<ReactDOMInstance> parent) override {
+    ++childCalls;
+    removes += parent->children.size();
+    HostInterface::removeAllHostChildren(std::move(parent));
+  }
+
+  void replaceHostChildren(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last) override {
+    ++childCalls;
+    removes += parent->children.size();
+    appends += static_cast<std::size_t>(last - first);
+    HostInterface::replaceHostChildren(std::move(parent), first, last);
+  }
+
+  void appendHostChildren(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last) override {
+    ++childCalls;
+    appends += static_cast<std::size_t>(last - first);
+    HostInterface::appendHostChildren(std::move(parent), first, last);
+  }
+
+  void moveHostChildrenBefore(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last,
+      std::shared_ptr<ReactDOMInstance> beforeChild) override {
+    ++childCalls;
+    inserts += static_cast<std::size_t>(last - first);
+    HostInterface::moveHostChildrenBefore(std::move(parent), first, last, std::move(beforeChild));
+  }
+
+  void resetCounts() {
+    creates = appends = inserts = removes = childCalls = 0;
+  }
+};
+
+void forgetFingerprints(ReactDOMInstance& instance) {
+  instance.propsFingerprint = 0;
+  instance.subtreeHash = 0;
+  for (const auto& child : instance.children) {
+    forgetFingerprints(*child);
+  }
+}
+
+} // namespace
+
+void runReactWasmRenderBenchmarks() {
+  test::TestRuntime rt;
+  ReactRuntime runtime;
+  jsi::Object rootProps(rt);
+  auto container = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+
+  std::size_t tick = 0;
+  jsx::WasmSerializedLayout layout = dashboard(rt, tick);
+  __wasm_memory_buffer = layout.buffer.data();
+  runtime.renderRootSync(rt, layout.rootOffset, container);
+
+  auto nextLayout = [&] {
+    layout = dashboard(rt, ++tick);
+    __wasm_memory_buffer = layout.buffer.data();
+  };
+
+  runBenchmark(
+      "dashboard re-render with props fingerprints",
+      20,
+      nextLayout,
+      [&] { runtime.renderRootSync(rt, layout.rootOffset, container); });
+  const PropsFingerprintStats stats = runtime.propsFingerprintStats();
+
+  runBenchmark(
+      "dashboard re-render diffing every element",
+      20,
+      [&] {
+        nextLayout();
+        forgetFingerprints(*container);
+      },
+      [&] { runtime.renderRootSync(rt, layout.rootOffset, container); });
+  __wasm_memory_buffer = nullptr;
+
+  reportMetric("subtrees skipped per render", static_cast<double>(stats.skippedSubtrees), "");
+  reportMetric("elements skipped per render", static_cast<double>(stats.matchedElements), "");
+  reportMetric("elements diffed per render", static_cast<double>(stats.diffedElements), "");
+  reportMetric("prop comparisons skipped per render", static_cast<double>(stats.skippedPropComparisons), "");
+
+  // Per-node cost of rendering a 20k-node layout: mount into an empty
+  // container, an unchanged re-render, and a re-render changing every row.
+  {
+    ReactRuntime tableRuntime;
+    jsx::WasmSerializedLayout first = table(rt, 0);
+    jsx::WasmSerializedLayout second = table(rt, 1);
+    std::shared_ptr<ReactDOMComponent> tableContainer;
+    std::size_t revision = 0;
+
+    const double mountSeconds = runBenchmark(
+        "table mount (20k nodes)",
+        10,
+        [&] {
+          tableContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+          __wasm_memory_buffer = first.buffer.data();
+        },
+        [&] { tableRuntime.renderRootSync(rt, first.rootOffset, tableContainer); });
+    reportMetric("per node", mountSeconds * 1e9 / kTableNodeCount, "ns");
+
+    const double unchangedSeconds = runBenchmark(
+        "table re-render, unchanged (20k nodes)",
+        10,
+        [&] { __wasm_memory_buffer = first.buffer.data(); },
+        [&] { tableRuntime.renderRootSync(rt, first.rootOffset, tableContainer); });
+    reportMetric("per node", unchangedSeconds * 1e9 / kTableNodeCount, "ns");
+
+    const double changedSeconds = runBenchmark(
+        "table re-render, every row changed (20k nodes)",
+        10,
+        [&] {
+          jsx::WasmSerializedLayout& next = ++revision % 2 == 1 ? second : first;
+          __wasm_memory_buffer = next.buffer.data();
+        },
+        [&] {
+          const jsx::WasmSerializedLayout& next = revision % 2 == 1 ? second : first;
+          tableRuntime.renderRootSync(rt, next.rootOffset, tableContainer);
+        });
+    reportMetric("per node", changedSeconds * 1e9 / kTableNodeCount, "ns");
+
+    // A mostly static frame: every 40th row changes its attribute and value
+    // text, 200 of the 20k nodes.
+    jsx::WasmSerializedLayout sparse = table(rt, 1, 40);
+    revision = 0;
+    __wasm_memory_buffer = first.buffer.data();
+    tableRuntime.renderRootSync(rt, first.rootOffset, tableContainer);
+    const double sparseSeconds = runBenchmark(
+        "table re-render, 1% of nodes changed (20k nodes)",
+        20,
+        [&] {
+          jsx::WasmSerializedLayout& next = ++revision % 2 == 1 ? sparse : first;
+          __wasm_memory_buffer = next.buffer.data();
+        },
+        [&] {
+          const jsx::WasmSerializedLayout& next = revision % 2 == 1 ? sparse : first;
+          tableRuntime.renderRootSync(rt, next.rootOffset, tableContainer);
+        });
+    reportMetric("frame time", sparseSeconds * 1e3, "ms");
+    __wasm_memory_buffer = nullptr;
+  }
+
+  // Heap allocations made by a 10k-node update that changes every row.
+  {
+    ReactRuntime updateRuntime;
+    std::array<jsx::WasmSerializedLayout, 2> layouts{
+        table(rt, 0, 1, kUpdateTableRowCount), table(rt, 1, 1, kUpdateTableRowCount)};
+    auto updateContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+    std::size_t revision = 0;
+    std::size_t allocations = 0;
+    __wasm_memory_buffer = layouts[0].buffer.data();
+    updateRuntime.renderRootSync(rt, layouts[0].rootOffset, updateContainer);
+
+    runBenchmark(
+        "table update (10k nodes)",
+        20,
+        [&] { __wasm_memory_buffer = layouts[++revision % 2].buffer.data(); },
+        [&] {
+          const std::size_t before = allocationCount();
+          updateRuntime.renderRootSync(rt, layouts[revision % 2].rootOffset, updateContainer);
+          allocations = allocationCount() - before;
+        });
+    reportMetric("allocations per render", static_cast<double>(allocations), "");
+    __wasm_memory_buffer = nullptr;
+  }
+
+  // Text-heavy table: mounting 100k numeric cells, then changing all of them.
+  {
+    ReactRuntime numericRuntime;
+    auto numericHost = std::make_shared<CountingHostInterface>();
+    numericRuntime.setHostInterface(numericHost);
+    std::array<jsx::WasmSerializedLayout, 2> layouts{numericTable(rt, 0), numericTable(rt, 1)};
+    std::shared_ptr<ReactDOMComponent> numericContainer;
+    std::size_t revision = 0;
+
+    runBenchmark(
+        "numeric table mount (100k cells)",
+        5,
+        [&] {
+          numericContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+          __wasm_memory_buffer = layouts[0].buffer.data();
+          numericHost->resetCounts();
+        },
+        [&] { numericRuntime.renderRootSync(rt, layouts[0].rootOffset, numericContainer); });
+    reportMetric("host nodes created", static_cast<double>(numericHost->creates), "");
+
+    runBenchmark(
+        "numeric table update (100k cells)",
+        10,
+        [&] { __wasm_memory_buffer = layouts[++revision % 2].buffer.data(); },
+        [&] { numericRuntime.renderRootSync(rt, layouts[revision % 2].rootOffset, numericContainer); });
+    __wasm_memory_buffer = nullptr;
+  }
+
+  // Prop-update throughput: every render commits three changed props on each
+  // of 5000 elements.
+  {
+    ReactRuntime swatchRuntime;
+    std::array<jsx::WasmSerializedLayout, 2> layouts{swatches(rt, 0), swatches(rt, 1)};
+    auto swatchContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+    std::size_t revision = 0;
+    __wasm_memory_buffer = layouts[0].buffer.data();
+    swatchRuntime.renderRootSync(rt, layouts[0].rootOffset, swatchContainer);
+
+    const double seconds = runBenchmark(
+        "prop updates (5000 elements x 3 props)",
+        20,
+        [&] { __wasm_memory_buffer = layouts[++revision % 2].buffer.data(); },
+        [&] { swatchRuntime.renderRootSync(rt, layouts[revision % 2].rootOffset, swatchContainer); });
+    reportMetric("prop updates per second", kSwatchPropUpdates / seconds, "");
+    __wasm_memory_buffer = nullptr;
+  }
+
+  // Keyed list edits: every sample re-renders the rows in key order, then
+  // measures the render of the edited order.
+  ReactRuntime listRuntime;
+  auto host = std::make_shared<CountingHostInterface>();
+  listRuntime.setHostInterface(host);
+  auto listContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+
+  std::vector<std::size_t> baseOrder(kKeyedRowCount);
+  std::iota(baseOrder.begin(), baseOrder.end(), 0);
+  jsx::WasmSerializedLayout baseLayout = keyedList(rt, baseOrder);
+
+  const struct {
+    const char* name;
+    std::function<void(std::vector<std::size_t>&)> edit;
+  } edits[] = {
+      {"shuffle",
+       [](std::vector<std::size_t>& order) { std::shuffle(order.begin(), order.end(), std::mt19937(42)); }},
+      {"reverse", [](std::vector<std::size_t>& order) { std::reverse(order.begin(), order.end()); }},
+      {"insert 100 at head",
+       [](std::vector<std::size_t>& order) {
+         std::vector<std::size_t> head(kKeyedEditCount);
+         std::iota(head.begin(), head.end(), kKeyedRowCount);
+         order.insert(order.begin(), head.begin(), head.end());
+       }},
+      {"delete 100 at tail", [](std::vector<std::size_t>& order) { order.resize(order.size() - kKeyedEditCount); }},
+  };
+
+  for (const auto& entry : edits) {
+    std::vector<std::size_t> order = baseOrder;
+    entry.edit(order);
+    jsx::WasmSerializedLayout editedLayout = keyedList(rt, order);
+
+    runBenchmark(
+        std::string("keyed list ") + entry.name + " (10k rows)",
+        10,
+        [&] {
+          __wasm_memory_buffer = baseLayout.buffer.data();
+          listRuntime.renderRootSync(rt, baseLayout.rootOffset, listContainer);
+          __wasm_memory_buffer = editedLayout.buffer.data();
+          host->resetCounts();
+        },
+        [&] { listRuntime.renderRootSync(rt, editedLayout.rootOffset, listContainer); });
+    __wasm_memory_buffer = nullptr;
+
+    reportMetric("host inserts", static_cast<double>(host->inserts), "");
+    reportMetric("host appends", static_cast<double>(host->appends), "");
+    reportMetric("host removes", static_cast<double>(host->removes), "");
+    reportMetric("host creates", static_cast<double>(host->creates), "");
+  }
+
+  // Keyed list churn: every render swaps all 10k rows for rows with new
+  // keys, with the host instance pool off and then on.
+  {
+    std::vector<std::size_t> nextOrder(kKeyedRowCount);
+    std::iota(nextOrder.begin(), nextOrder.end(), kKeyedRowCount);
+    std::array<jsx::WasmSerializedLayout, 2> layouts{baseLayout, keyedList(rt, nextOrder)};
+
+    for (const std::size_t capacity : {std::size_t{0}, kKeyedRowCount}) {
+      ReactRuntime churnRuntime;
+      churnRuntime.setHostInstancePoolCapacity(capacity);
+      auto churnContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+      std::size_t revision = 0;
+      std::size_t allocations = 0;
+      __wasm_memory_buffer = layouts[0].buffer.data();
+      churnRuntime.renderRootSync(rt, layouts[0].rootOffset, churnContainer);
+
+      runBenchmark(
+          std::string("keyed list churn, ") + (capacity > 0 ? "pooled" : "unpooled") + " (10k rows)",
+          10,
+          [&] { __wasm_memory_buffer = layouts[++revision % 2].buffer.data(); },
+          [&] {
+            const std::size_t before = allocationCount();
+            churnRuntime.renderRootSync(rt, layouts[revision % 2].rootOffset, churnContainer);
+            allocations = allocationCount() - before;
+          });
+      reportMetric("allocations per render", static_cast<double>(allocations), "");
+      const HostInstancePoolStats& stats = churnRuntime.hostInstancePoolStats();
+      reportMetric(
+          "pool hit rate",
+          stats.hits + stats.misses > 0 ? 100.0 * static_cast<double>(stats.hits) / (stats.hits + stats.misses) : 0.0,
+          "%");
+      __wasm_memory_buffer = nullptr;
+    }
+  }
+
+  // Host call overhead: mounting 50k nodes through a host written against
+  // HostInterface, which the runtime adapts, and through the runtime's
+  // default host.
+  {
+    std::vector<std::size_t> order(kHostCallRowCount);
+    std::iota(order.begin(), order.end(), 0);
+    jsx::WasmSerializedLayout layout = keyedList(rt, order);
+    for (const bool adapted : {true, false}) {
+      ReactRuntime mountRuntime;
+      if (adapted) {
+        mountRuntime.setHostInterface(std::make_shared<HostInterface>());
+      }
+      std::shared_ptr<ReactDOMComponent> mountContainer;
+      runBenchmark(
+          std::string("host mount, ") + (adapted ? "HostInterface adapter" : "default host") + " (50k nodes)",
+          10,
+          [&] {
+            if (mountContainer) {
+              mountRuntime.unregisterRootContainer(mountContainer.get());
+            }
+            mountContainer = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+            __wasm_memory_buffer = layout.buffer.data();
+          },
+          [&] { mountRuntime.renderRootSync(rt, layout.rootOffset, mountContainer); });
+      __wasm_memory_buffer = nullptr;
+
+      // The host calls alone: a text commit on each of 50k nodes.
+      std::vector<std::shared_ptr<ReactDOMInstance>> texts;
+      texts.reserve(kHostCallRowCount * 2);
+      for (std::size_t i = 0; i < kHostCallRowCount * 2; ++i) {
+        texts.push_back(mountRuntime.createTextInstance(rt, "Row label that outgrows SSO"));
+      }
+      const std::string labels[] = {"Row label that outgrows SSO", "Row label, revised past SSO"};
+      std::size_t revision = 0;
+      const double seconds = runBenchmark(
+          std::string("host text commits, ") + (adapted ? "HostInterface adapter" : "default host") + " (50k nodes)",
+          20,
+          [&] { ++revision; },
+          [&] {
+            const std::string& previous = labels[(revision + 1) % 2];
+            const std::string& next = labels[revision % 2];
+            for (const auto& text : texts) {
+              mountRuntime.commitTextUpdate(text, previous, next);
+            }
+          });
+      reportMetric("per host call", seconds / static_cast<double>(texts.size()) * 1e9, "ns");
+    }
+  }
+
+  // Mounting a 50k-row list into an empty parent and clearing it again.
+  std::vector<std::size_t> bulkOrder(kBulkRowCount);
+  std::iota(bulkOrder.begin(), bulkOrder.end(), 0);
+  jsx::WasmSerializedLayout bulkLayout = keyedList(rt, bulkOrder);
+  jsx::WasmSerializedLayout emptyLayout = keyedList(rt, {});
+  auto renderList = [&](jsx::WasmSerializedLayout& layout) {
+    __wasm_memory_buffer = layout.buffer.data();
+    listRuntime.renderRootSync(rt, layout.rootOffset, listContainer);
+  };
+
+  runBenchmark(
+      "list mount (50k rows)",
+      5,
+      [&] {
+        renderList(emptyLayout);
+        __wasm_memory_buffer = bulkLayout.buffer.data();
+        host->resetCounts();
+      },
+      [&] { listRuntime.renderRootSync(rt, bulkLayout.rootOffset, listContainer); });
+  reportMetric("host child calls", static_cast<double>(host->childCalls), "");
+
+  runBenchmark(
+      "list clear (50k rows)",
+      5,
+      [&] {
+        renderList(bulkLayout);
+        __wasm_memory_buffer = emptyLayout.buffer.data();
+        host->resetCounts();
+      },
+      [&] { listRuntime.renderRootSync(rt, emptyLayout.rootOffset, listContainer); });
+  reportMetric("host child calls", static_cast<double>(host->childCalls), "");
+  __wasm_memory_buffer = nullptr;
+}
+
+} // namespace react::bench
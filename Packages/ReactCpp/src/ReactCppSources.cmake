@@ -4,25 +4,40 @@ set(REACT_CPP_SOURCE_FILES
     ${_REACT_CPP_SRC_DIR}/react-dom/client/ReactDOMComponent.cpp
     ${_REACT_CPP_SRC_DIR}/react-dom/client/ReactDOMDiffProperties.cpp
     ${_REACT_CPP_SRC_DIR}/react-dom/client/ReactDOMInstance.cpp
+    ${_REACT_CPP_SRC_DIR}/react-dom/client/ReactDOMPropAtoms.cpp
+    ${_REACT_CPP_SRC_DIR}/react-dom/client/ReactDOMStyleValue.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberConcurrentUpdates.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactCapturedValue.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiber.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberAsyncAction.cpp
+    ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberBeginWork.cpp
+    ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberExternalStore.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberErrorLogger.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberHiddenContext.cpp
+    ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberHooks.cpp
+    ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberNewContext.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberClassUpdateQueue.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberStack.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberSuspenseContext.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberThenable.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberThrow.cpp
+    ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberTransition.cpp
+    ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberRootArena.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberRootScheduler.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactWakeable.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactUpdateQueue.cpp
     ${_REACT_CPP_SRC_DIR}/react-reconciler/ReactFiberWorkLoop.cpp
+    ${_REACT_CPP_SRC_DIR}/runtime/ReactHostInstancePool.cpp
     ${_REACT_CPP_SRC_DIR}/runtime/ReactHostInterface.cpp
+    ${_REACT_CPP_SRC_DIR}/runtime/ReactHostInterfaceV2.cpp
     ${_REACT_CPP_SRC_DIR}/runtime/ReactJSXRuntime.cpp
+    ${_REACT_CPP_SRC_DIR}/runtime/ReactRenderScratchArena.cpp
     ${_REACT_CPP_SRC_DIR}/runtime/ReactRuntime.cpp
+    ${_REACT_CPP_SRC_DIR}/runtime/ReactTextChildren.cpp
+    ${_REACT_CPP_SRC_DIR}/runtime/ReactTypedComponent.cpp
+    ${_REACT_CPP_SRC_DIR}/runtime/ReactUpdatePayload.cpp
     ${_REACT_CPP_SRC_DIR}/runtime/ReactWasmBridge.cpp
+    ${_REACT_CPP_SRC_DIR}/runtime/ReactWindowedList.cpp
     ${_REACT_CPP_SRC_DIR}/shared/ReactOwnerStackReset.cpp
     ${_REACT_CPP_SRC_DIR}/shared/ReactSharedInternals.cpp
     ${_REACT_CPP_SRC_DIR}/shared/ReactSymbols.cpp
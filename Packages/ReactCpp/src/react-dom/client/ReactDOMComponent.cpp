@@ -1,16 +1,20 @@
 #include "ReactDOMComponent.h"
 
+#include "ReactDOMStyleValue.h"
+#include "runtime/ReactTextChildren.h"
+
 #include <algorithm>
+#include <optional>
 
 namespace jsi = facebook::jsi;
 
 namespace react {
 
 namespace {
-std::unordered_map<std::string, jsi::Value> cloneProps(
+void copyProps(
   jsi::Runtime& rt,
-  const jsi::Object& props) {
-  std::unordered_map<std::string, jsi::Value> result;
+  const jsi::Object& props,
+  ReactDOMPropMap& result) {
   jsi::Array propertyNames = props.getPropertyNames(rt);
   size_t length = propertyNames.size(rt);
   result.reserve(length);
@@ -25,104 +29,204 @@ std::unordered_map<std::string, jsi::Value> cloneProps(
     jsi::PropNameID nameID = jsi::PropNameID::forUtf8(rt, key);
     jsi::Value value = props.getProperty(rt, nameID);
 
-    result.emplace(std::move(key), jsi::Value(rt, value));
+    result.emplace(internPropName(key), jsi::Value(rt, value));
   }
+}
 
+ReactDOMPropMap cloneProps(
+  jsi::Runtime& rt,
+  const jsi::Object& props) {
+  ReactDOMPropMap result;
+  copyProps(rt, props, result);
   return result;
 }
 } // namespace
 
 ReactDOMComponent::ReactDOMComponent(jsi::Runtime& rt, std::string type, const jsi::Object& props)
-  : runtime_(&rt),
-    isText_(false),
+  : ReactDOMInstance(HostNodeKind::Element),
+    runtime_(&rt),
     type_(std::move(type)),
-    props_(cloneProps(rt, props)) {}
+    props_(cloneProps(rt, props)) {
+  collectEventHandlers();
+  collectStyles();
+}
 
 ReactDOMComponent::ReactDOMComponent(jsi::Runtime& rt, std::string type, const std::string& textContent)
-  : runtime_(&rt),
-    isText_(true),
+  : ReactDOMInstance(HostNodeKind::Text),
+    runtime_(&rt),
     type_(std::move(type)),
     textContent_(textContent) {}
 
-void ReactDOMComponent::appendChild(std::shared_ptr<ReactDOMInstance> child) {
-  if (!child || isText_) {
-    return;
-  }
+void ReactDOMComponent::resetForReuse(jsi::Runtime& rt, const jsi::Object& props) {
+  resetInstanceState(rt);
+  nodeKind_ = HostNodeKind::Element;
+  // clear() keeps the bucket array, so refilling reuses it.
+  props_.clear();
+  copyProps(rt, props, props_);
+  collectEventHandlers();
+  collectStyles();
+}
 
-  auto existing = std::find_if(children.begin(), children.end(), [&](const std::shared_ptr<ReactDOMInstance>& current) {
-    return current.get() == child.get();
-  });
+void ReactDOMComponent::resetForReuse(jsi::Runtime& rt, const std::string& textContent) {
+  resetInstanceState(rt);
+  nodeKind_ = HostNodeKind::Text;
+  props_.clear();
+  textContent_ = textContent;
+}
 
-  if (existing != children.end()) {
+void ReactDOMComponent::resetInstanceState(jsi::Runtime& rt) {
+  runtime_ = &rt;
+  unlinkAllChildren();
+  parent.reset();
+  key.clear();
+  className.clear();
+  propsFingerprint = 0;
+  subtreeHash = 0;
+  textContent_.clear();
+  eventHandlers_.clear();
+  styles_.clear();
+  stringProps_.clear();
+}
+
+void ReactDOMComponent::collectEventHandlers() {
+  for (const auto& [atom, value] : props_) {
+    if (value.isObject() && isEventPropAtom(atom)) {
+      eventHandlers_.emplace(atom, jsi::Value(*runtime_, value));
+    }
+  }
+}
+
+void ReactDOMComponent::collectStyles() {
+  styles_.clear();
+  auto it = props_.find(kStyleAtom);
+  if (it == props_.end() || !it->second.isObject()) {
     return;
   }
 
-  children.push_back(child);
-  child->parent = shared_from_this();
+  jsi::Runtime& rt = *runtime_;
+  jsi::Object style = it->second.getObject(rt);
+  jsi::Array names = style.getPropertyNames(rt);
+  size_t length = names.size(rt);
+  for (size_t i = 0; i < length; ++i) {
+    jsi::Value nameValue = names.getValueAtIndex(rt, i);
+    if (!nameValue.isString()) {
+      continue;
+    }
+    jsi::String name = nameValue.getString(rt);
+    const PropAtom atom = internPropName(name.utf8(rt));
+    std::string value = dangerousStyleValue(rt, propAtomName(atom), style.getProperty(rt, name));
+    if (!value.empty()) {
+      styles_[atom] = std::move(value);
+    }
+  }
 }
 
-void ReactDOMComponent::removeChild(std::shared_ptr<ReactDOMInstance> child) {
-  if (!child) {
+void ReactDOMComponent::appendChild(std::shared_ptr<ReactDOMInstance> child) {
+  if (!child || isTextInstance() || hasChild(*child)) {
     return;
   }
 
-  auto it = std::find_if(children.begin(), children.end(), [&](const std::shared_ptr<ReactDOMInstance>& current) {
-    return current.get() == child.get();
-  });
+  linkChild(std::move(child), nullptr);
+  invalidateSubtreeHash();
+}
 
-  if (it == children.end()) {
+void ReactDOMComponent::removeChild(std::shared_ptr<ReactDOMInstance> child) {
+  if (!child || !hasChild(*child)) {
     return;
   }
 
-  (*it)->parent.reset();
-  children.erase(it);
+  unlinkChild(*child);
+  invalidateSubtreeHash();
 }
 
 void ReactDOMComponent::insertChildBefore(
   std::shared_ptr<ReactDOMInstance> child,
   std::shared_ptr<ReactDOMInstance> beforeChild) {
-  if (!child || isText_) {
+  if (!child || isTextInstance()) {
     return;
   }
 
-  auto removeIt = std::find_if(children.begin(), children.end(), [&](const std::shared_ptr<ReactDOMInstance>& current) {
-    return current.get() == child.get();
-  });
-  if (removeIt != children.end()) {
-    children.erase(removeIt);
+  // A beforeChild that is not a child of this instance appends.
+  linkChild(std::move(child), beforeChild.get());
+  invalidateSubtreeHash();
+}
+
+void ReactDOMComponent::removeAllChildren() {
+  if (children.empty()) {
+    return;
   }
+  unlinkAllChildren();
+  invalidateSubtreeHash();
+}
 
-  if (!beforeChild) {
-    appendChild(child);
+void ReactDOMComponent::replaceChildren(ReactDOMInstanceIterator first, ReactDOMInstanceIterator last) {
+  if (isTextInstance()) {
     return;
   }
+  unlinkAllChildren();
+  appendChildren(first, last);
+  invalidateSubtreeHash();
+}
 
-  auto beforeIt = std::find_if(children.begin(), children.end(), [&](const std::shared_ptr<ReactDOMInstance>& current) {
-    return current.get() == beforeChild.get();
-  });
+void ReactDOMComponent::appendChildren(
+  ReactDOMInstanceIterator first,
+  ReactDOMInstanceIterator last) {
+  if (isTextInstance() || first == last) {
+    return;
+  }
+
+  for (; first != last; ++first) {
+    const auto& child = *first;
+    // Like appendChild, leave children that are already attached here alone.
+    if (!child || hasChild(*child)) {
+      continue;
+    }
+    linkChild(child, nullptr);
+  }
+  invalidateSubtreeHash();
+}
 
-  if (beforeIt == children.end()) {
-    appendChild(child);
+void ReactDOMComponent::moveChildrenBefore(
+  ReactDOMInstanceIterator first,
+  ReactDOMInstanceIterator last,
+  std::shared_ptr<ReactDOMInstance> beforeChild) {
+  if (isTextInstance() || first == last) {
     return;
   }
 
-  child->parent = shared_from_this();
-  children.insert(beforeIt, child);
+  // Moving beforeChild itself leaves nothing to anchor on, so the run goes
+  // to the end.
+  ReactDOMInstance* anchor = beforeChild.get();
+  if (std::find(first, last, beforeChild) != last) {
+    anchor = nullptr;
+  }
+  for (; first != last; ++first) {
+    if (*first) {
+      linkChild(*first, anchor);
+    }
+  }
+  invalidateSubtreeHash();
 }
 
 void ReactDOMComponent::setAttribute(
   const std::string& key,
   const jsi::Value& value) {
+  setAttribute(internPropName(key), value);
+}
+
+void ReactDOMComponent::setAttribute(PropAtom atom, const jsi::Value& value) {
   if (!runtime_) {
     return;
   }
 
+  propsFingerprint = 0;
+  invalidateSubtreeHash();
   if (value.isUndefined()) {
-    removeAttribute(key);
+    removeAttribute(atom);
     return;
   }
 
-  if (key == "class" || key == "className") {
+  if (atom == kClassAtom || atom == kClassNameAtom) {
     if (value.isString()) {
       className = value.asString(*runtime_).utf8(*runtime_);
     } else if (value.isNull()) {
@@ -130,63 +234,87 @@ void ReactDOMComponent::setAttribute(
     }
   }
 
-  if (key == "textContent") {
+  if (atom == kTextContentAtom) {
     if (value.isString()) {
       setTextContent(value.asString(*runtime_).utf8(*runtime_));
     } else if (value.isNumber()) {
-      setTextContent(std::to_string(value.getNumber()));
+      setTextContent(numberToText(value.getNumber()));
     } else if (value.isNull()) {
       setTextContent("");
     }
     return;
   }
 
-  if (isReactDOMEventPropKey(key)) {
+  if (isEventPropAtom(atom)) {
     if (value.isNull()) {
-      eventHandlers_.erase(key);
-      props_.erase(key);
+      eventHandlers_.erase(atom);
+      removeProp(atom);
       return;
     }
 
     if (value.isObject()) {
-      eventHandlers_[key] = jsi::Value(*runtime_, value);
+      eventHandlers_[atom] = jsi::Value(*runtime_, value);
     } else {
-      eventHandlers_.erase(key);
+      eventHandlers_.erase(atom);
     }
   }
 
-  setProp(key, value);
+  setProp(atom, value);
+  if (atom == kStyleAtom) {
+    collectStyles();
+  }
 }
 
 void ReactDOMComponent::removeAttribute(const std::string& key) {
-  if (key == "class" || key == "className") {
+  // A name that was never interned cannot be among the props, but the
+  // write still counts as a change.
+  const PropAtom atom = findPropAtom(key);
+  if (atom == PropAtom::None) {
+    propsFingerprint = 0;
+    invalidateSubtreeHash();
+    return;
+  }
+  removeAttribute(atom);
+}
+
+void ReactDOMComponent::removeAttribute(PropAtom atom) {
+  propsFingerprint = 0;
+  invalidateSubtreeHash();
+  if (atom == kClassAtom || atom == kClassNameAtom) {
     className.clear();
   }
-  if (key == "textContent") {
+  if (atom == kTextContentAtom) {
     textContent_.clear();
-    props_.erase("textContent");
+    removeProp(kTextContentAtom);
     return;
   }
-  if (isReactDOMEventPropKey(key)) {
-    eventHandlers_.erase(key);
+  if (isEventPropAtom(atom)) {
+    eventHandlers_.erase(atom);
+  }
+  if (atom == kStyleAtom) {
+    styles_.clear();
   }
-  removeProp(key);
+  removeProp(atom);
 }
 
 jsi::Value ReactDOMComponent::getAttribute(
   jsi::Runtime& rt,
   const std::string& key) const {
-  auto eventIt = eventHandlers_.find(key);
+  return getAttribute(rt, findPropAtom(key));
+}
+
+jsi::Value ReactDOMComponent::getAttribute(jsi::Runtime& rt, PropAtom atom) const {
+  auto eventIt = eventHandlers_.find(atom);
   if (eventIt != eventHandlers_.end()) {
     return jsi::Value(rt, eventIt->second);
   }
 
-  auto it = props_.find(key);
+  auto it = props_.find(atom);
   if (it == props_.end()) {
-    if (key == "class" || key == "className") {
+    if (atom == kClassAtom || atom == kClassNameAtom) {
       return jsi::Value(jsi::String::createFromUtf8(rt, className));
     }
-    if (key == "textContent") {
+    if (atom == kTextContentAtom) {
       return jsi::Value(jsi::String::createFromUtf8(rt, textContent_));
     }
     return jsi::Value::undefined();
@@ -195,14 +323,31 @@ jsi::Value ReactDOMComponent::getAttribute(
   return jsi::Value(rt, it->second);
 }
 
+void ReactDOMComponent::setStyleProperty(PropAtom atom, std::string value) {
+  propsFingerprint = 0;
+  invalidateSubtreeHash();
+  if (value.empty()) {
+    styles_.erase(atom);
+  } else {
+    styles_[atom] = std::move(value);
+  }
+}
+
+void ReactDOMComponent::removeStyleProperty(PropAtom atom) {
+  propsFingerprint = 0;
+  invalidateSubtreeHash();
+  styles_.erase(atom);
+}
+
 void ReactDOMComponent::setTextContent(const std::string& text) {
   textContent_ = text;
+  invalidateSubtreeHash();
   if (!runtime_) {
     return;
   }
 
-  if (!isText_) {
-    props_["textContent"] = jsi::Value(jsi::String::createFromUtf8(*runtime_, text));
+  if (!isTextInstance()) {
+    assignProp(kTextContentAtom, jsi::Value(jsi::String::createFromUtf8(*runtime_, text)));
   }
 }
 
@@ -210,18 +355,34 @@ const std::string& ReactDOMComponent::getTextContent() const {
   return textContent_;
 }
 
-void ReactDOMComponent::setProp(
-  const std::string& key,
-  const jsi::Value& value) {
+void ReactDOMComponent::setProp(PropAtom atom, const jsi::Value& value) {
   if (!runtime_) {
     return;
   }
 
-  props_[key] = jsi::Value(*runtime_, value);
+  assignProp(atom, jsi::Value(*runtime_, value));
+}
+
+void ReactDOMComponent::assignProp(PropAtom atom, jsi::Value value) {
+  stringProps_.erase(atom);
+  props_[atom] = std::move(value);
 }
 
-void ReactDOMComponent::removeProp(const std::string& key) {
-  props_.erase(key);
+void ReactDOMComponent::removeProp(PropAtom atom) {
+  stringProps_.erase(atom);
+  props_.erase(atom);
+}
+
+const std::string* ReactDOMComponent::getStringProp(PropAtom atom) const {
+  auto it = props_.find(atom);
+  if (it == props_.end() || !it->second.isString() || !runtime_) {
+    return nullptr;
+  }
+  auto [cached, inserted] = stringProps_.try_emplace(atom);
+  if (inserted) {
+    cached->second = it->second.getString(*runtime_).utf8(*runtime_);
+  }
+  return &cached->second;
 }
 
 void ReactDOMComponent::applyUpdate(
@@ -233,13 +394,13 @@ void ReactDOMComponent::applyUpdate(
 
   jsi::Runtime& rt = *runtime_;
 
-  if (isText_) {
+  if (isTextInstance()) {
     if (payload.hasProperty(rt, "text")) {
       jsi::Value textValue = payload.getProperty(rt, "text");
       if (textValue.isString()) {
         textContent_ = textValue.asString(rt).utf8(rt);
       } else if (textValue.isNumber()) {
-        textContent_ = std::to_string(textValue.getNumber());
+        textContent_ = numberToText(textValue.getNumber());
       } else if (textValue.isNull() || textValue.isUndefined()) {
         textContent_.clear();
       }
@@ -247,7 +408,15 @@ void ReactDOMComponent::applyUpdate(
     return;
   }
 
-  props_ = cloneProps(rt, newProps);
+  // The payload lists every changed prop except `children`, so patching
+  // props_ with it and refreshing `children` leaves it equal to newProps
+  // without enumerating them.
+  jsi::PropNameID childrenProp = jsi::PropNameID::forUtf8(rt, "children");
+  if (newProps.hasProperty(rt, childrenProp)) {
+    assignProp(kChildrenAtom, newProps.getProperty(rt, childrenProp));
+  } else {
+    removeProp(kChildrenAtom);
+  }
 
   auto applySetFromObject = [&](const char* propertyName) {
     jsi::PropNameID nameID = jsi::PropNameID::forUtf8(rt, propertyName);
@@ -271,7 +440,7 @@ void ReactDOMComponent::applyUpdate(
       std::string key = nameValue.asString(rt).utf8(rt);
       jsi::PropNameID entryID = jsi::PropNameID::forUtf8(rt, key);
       jsi::Value entryValue = object.getProperty(rt, entryID);
-      setAttribute(key, entryValue);
+      setAttribute(internPropName(key), entryValue);
     }
   };
 
@@ -307,17 +476,131 @@ void ReactDOMComponent::applyUpdate(
   applyRemovalFromArray("removedAttributes");
   applyRemovalFromArray("removedEvents");
 
+  // Style changes come after the attributes, which may have replaced or
+  // removed the whole style. The `style` prop is refreshed from newProps
+  // like `children`, since the payload names only the changed properties.
+  bool stylesChanged = false;
+  jsi::PropNameID stylesProp = jsi::PropNameID::forUtf8(rt, "styles");
+  if (payload.hasProperty(rt, stylesProp)) {
+    jsi::Value stylesValue = payload.getProperty(rt, stylesProp);
+    if (stylesValue.isObject()) {
+      jsi::Object styles = stylesValue.asObject(rt);
+      jsi::Array names = styles.getPropertyNames(rt);
+      size_t length = names.size(rt);
+      for (size_t i = 0; i < length; ++i) {
+        jsi::Value nameValue = names.getValueAtIndex(rt, i);
+        if (!nameValue.isString()) {
+          continue;
+        }
+        jsi::String name = nameValue.getString(rt);
+        jsi::Value value = styles.getProperty(rt, name);
+        std::string text = value.isString() ? value.getString(rt).utf8(rt) : std::string();
+        setStyleProperty(internPropName(name.utf8(rt)), std::move(text));
+        stylesChanged = true;
+      }
+    }
+  }
+
+  jsi::PropNameID removedStylesProp = jsi::PropNameID::forUtf8(rt, "removedStyles");
+  if (payload.hasProperty(rt, removedStylesProp)) {
+    jsi::Value removedValue = payload.getProperty(rt, removedStylesProp);
+    if (removedValue.isObject() && removedValue.getObject(rt).isArray(rt)) {
+      jsi::Array removed = removedValue.getObject(rt).getArray(rt);
+      size_t length = removed.size(rt);
+      for (size_t i = 0; i < length; ++i) {
+        jsi::Value nameValue = removed.getValueAtIndex(rt, i);
+        if (!nameValue.isString()) {
+          continue;
+        }
+        const PropAtom atom = findPropAtom(nameValue.getString(rt).utf8(rt));
+        if (atom != PropAtom::None) {
+          removeStyleProperty(atom);
+        }
+        stylesChanged = true;
+      }
+    }
+  }
+
+  if (stylesChanged) {
+    jsi::PropNameID styleProp = jsi::PropNameID::forUtf8(rt, "style");
+    if (newProps.hasProperty(rt, styleProp)) {
+      assignProp(kStyleAtom, newProps.getProperty(rt, styleProp));
+    } else {
+      removeProp(kStyleAtom);
+    }
+  }
+
   jsi::PropNameID textProp = jsi::PropNameID::forUtf8(rt, "text");
   if (payload.hasProperty(rt, textProp)) {
     jsi::Value textValue = payload.getProperty(rt, textProp);
     if (textValue.isString()) {
       setTextContent(textValue.asString(rt).utf8(rt));
     } else if (textValue.isNumber()) {
-      setTextContent(std::to_string(textValue.getNumber()));
+      setTextContent(numberToText(textValue.getNumber()));
     } else if (textValue.isNull() || textValue.isUndefined()) {
       setTextContent("");
     }
   }
 }
 
+void ReactDOMComponent::applyUpdate(const UpdatePayload& payload) {
+  if (!runtime_ || isTextInstance()) {
+    return;
+  }
+
+  jsi::Runtime& rt = *runtime_;
+  // Style ops patch a copy of the style object, made on the first one, so a
+  // style object that other props share is left as it was.
+  std::optional<jsi::Object> style;
+  for (const auto& op : payload.ops) {
+    if (!op.style) {
+      if (op.remove) {
+        removeAttribute(op.atom);
+      } else {
+        setAttribute(op.atom, updatePayloadValueToJsi(rt, op.value));
+      }
+      continue;
+    }
+
+    if (!style) {
+      style = copyStyleObject();
+    }
+    jsi::PropNameID name =
+      jsi::PropNameID::forUtf8(rt, reinterpret_cast<const uint8_t*>(op.name.data()), op.name.size());
+    if (op.remove) {
+      style->deleteProperty(rt, name);
+      removeStyleProperty(op.atom);
+    } else {
+      style->setProperty(rt, name, updatePayloadValueToJsi(rt, op.value));
+      setStyleProperty(op.atom, updatePayloadStyleText(op.name, op.value));
+    }
+  }
+
+  if (style) {
+    assignProp(kStyleAtom, jsi::Value(std::move(*style)));
+  }
+}
+
+jsi::Object ReactDOMComponent::copyStyleObject() const {
+  jsi::Runtime& rt = *runtime_;
+  jsi::Object copy(rt);
+  auto it = props_.find(kStyleAtom);
+  if (it == props_.end() || !it->second.isObject()) {
+    return copy;
+  }
+
+  jsi::Object style = it->second.getObject(rt);
+  jsi::Array names = style.getPropertyNames(rt);
+  size_t length = names.size(rt);
+  for (size_t i = 0; i < length; ++i) {
+    jsi::Value nameValue = names.getValueAtIndex(rt, i);
+    if (!nameValue.isString()) {
+      continue;
+    }
+    jsi::String name = nameValue.getString(rt);
+    copy.setProperty(rt, name, style.getProperty(rt, name));
+  }
+  return copy;
+}
+
 } // namespace react
@@ -2,15 +2,19 @@
 
 #include "ReactDOMDiffProperties.h"
 #include "ReactDOMInstance.h"
+#include "ReactDOMPropAtoms.h"
+#include "runtime/ReactUpdatePayload.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
 
 namespace react {
 
-class ReactDOMComponent
-  : public ReactDOMInstance,
-    public std::enable_shared_from_this<ReactDOMComponent> {
+using ReactDOMPropMap = std::unordered_map<PropAtom, facebook::jsi::Value>;
+// Inline style by CSS property, holding the text dangerousStyleValue gives.
+using ReactDOMStyleMap = std::unordered_map<PropAtom, std::string>;
+
+class ReactDOMComponent : public ReactDOMInstance {
 public:
   ReactDOMComponent(
     facebook::jsi::Runtime& rt,
@@ -26,6 +30,15 @@ public:
   void insertChildBefore(
     std::shared_ptr<ReactDOMInstance> child,
     std::shared_ptr<ReactDOMInstance> beforeChild) override;
+  void removeAllChildren() override;
+  void replaceChildren(ReactDOMInstanceIterator first, ReactDOMInstanceIterator last) override;
+  void appendChildren(
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last) override;
+  void moveChildrenBefore(
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last,
+    std::shared_ptr<ReactDOMInstance> beforeChild) override;
 
   void setAttribute(
     const std::string& key,
@@ -35,42 +48,80 @@ public:
     facebook::jsi::Runtime& rt,
     const std::string& key) const override;
 
+  void setAttribute(PropAtom atom, const facebook::jsi::Value& value);
+  void removeAttribute(PropAtom atom);
+  facebook::jsi::Value getAttribute(facebook::jsi::Runtime& rt, PropAtom atom) const;
+
+  // Per-property style updates, as the `styles` and `removedStyles` parts of
+  // an update payload carry them. They leave the `style` prop alone.
+  void setStyleProperty(PropAtom atom, std::string value);
+  void removeStyleProperty(PropAtom atom);
+
   void setTextContent(const std::string& text) override;
   const std::string& getTextContent() const override;
 
   void applyUpdate(
     const facebook::jsi::Object& newProps,
     const facebook::jsi::Object& payload);
+  void applyUpdate(const UpdatePayload& payload);
+
+  // Return an unmounted instance to the state the matching constructor
+  // leaves it in, so a host instance pool can hand it out again.
+  void resetForReuse(
+    facebook::jsi::Runtime& rt,
+    const facebook::jsi::Object& props);
+  void resetForReuse(
+    facebook::jsi::Runtime& rt,
+    const std::string& textContent);
 
   const std::string& getType() const {
     return type_;
   }
 
   bool isTextInstance() const {
-    return isText_;
+    return nodeKind_ == HostNodeKind::Text;
   }
 
-  const std::unordered_map<std::string, facebook::jsi::Value>& getProps() const {
+  const ReactDOMPropMap& getProps() const {
     return props_;
   }
 
-  const std::unordered_map<std::string, facebook::jsi::Value>& getEventHandlers() const {
+  // UTF-8 text of a string prop, or nullptr when the prop is missing or not
+  // a string. Copied out of the runtime on first read and kept until the
+  // prop is written, so repeated diffs compare native strings.
+  const std::string* getStringProp(PropAtom atom) const;
+
+  const ReactDOMPropMap& getEventHandlers() const {
     return eventHandlers_;
   }
 
+  const ReactDOMStyleMap& getStyles() const {
+    return styles_;
+  }
+
 private:
-  void setProp(
-    const std::string& key,
-    const facebook::jsi::Value& value);
+  void resetInstanceState(facebook::jsi::Runtime& rt);
+  // Registers the event handlers among props_, as setAttribute would.
+  void collectEventHandlers();
+  // Rebuilds styles_ from the `style` prop, when it is an object.
+  void collectStyles();
+  // A new object with the properties of the `style` prop, or an empty one
+  // when the prop is not an object.
+  facebook::jsi::Object copyStyleObject() const;
+
+  void setProp(PropAtom atom, const facebook::jsi::Value& value);
+  void assignProp(PropAtom atom, facebook::jsi::Value value);
 
-  void removeProp(const std::string& key);
+  void removeProp(PropAtom atom);
 
   facebook::jsi::Runtime* runtime_{nullptr};
-  bool isText_{false};
   std::string type_;
   std::string textContent_;
-  std::unordered_map<std::string, facebook::jsi::Value> props_;
-  std::unordered_map<std::string, facebook::jsi::Value> eventHandlers_;
+  ReactDOMPropMap props_;
+  ReactDOMPropMap eventHandlers_;
+  ReactDOMStyleMap styles_;
+  // Filled by getStringProp; an entry is dropped whenever its prop is written.
+  mutable std::unordered_map<PropAtom, std::string> stringProps_;
 };
 
 } // namespace react
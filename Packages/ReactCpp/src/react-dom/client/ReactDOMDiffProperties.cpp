@@ -1,6 +1,10 @@
 #include "ReactDOMDiffProperties.h"
 
+#include "ReactDOMStyleValue.h"
+#include "runtime/ReactTextChildren.h"
+
 #include <algorithm>
+#include <memory>
 
 namespace jsi = facebook::jsi;
 
@@ -14,23 +18,7 @@ std::string coerceTextValue(jsi::Runtime& rt, const jsi::Value& value) {
   }
 
   if (value.isNumber()) {
-    double number = value.getNumber();
-    if (number == 0) {
-      return "0";
-    }
-    std::string asText = std::to_string(number);
-    if (asText.find('.') != std::string::npos) {
-      while (!asText.empty() && asText.back() == '0') {
-        asText.pop_back();
-      }
-      if (!asText.empty() && asText.back() == '.') {
-        asText.pop_back();
-      }
-      if (asText.empty()) {
-        asText = "0";
-      }
-    }
-    return asText;
+    return numberToText(value.getNumber());
   }
 
   if (value.isNull() || value.isUndefined()) {
@@ -50,29 +38,73 @@ std::string coerceTextValue(jsi::Runtime& rt, const jsi::Value& value) {
   return std::string();
 }
 
-void collectKeys(jsi::Runtime& rt, const jsi::Value& value, std::vector<std::string>& out) {
+struct PropEntry {
+  ReactDOMPropKey key;
+  jsi::Value value;
+};
+
+// Reads the props of `value`, except `children`, sorted by key. A name with
+// no atom yet is kept as a string rather than interned.
+std::vector<PropEntry> collectSortedProps(jsi::Runtime& rt, const jsi::Value& value) {
+  std::vector<PropEntry> props;
   if (!value.isObject()) {
-    return;
+    return props;
   }
 
   jsi::Object object = value.asObject(rt);
   jsi::Array names = object.getPropertyNames(rt);
   size_t length = names.size(rt);
-  out.reserve(out.size() + length);
+  props.reserve(length);
 
   for (size_t i = 0; i < length; ++i) {
     jsi::Value keyValue = names.getValueAtIndex(rt, i);
     if (!keyValue.isString()) {
       continue;
     }
-    std::string key = keyValue.asString(rt).utf8(rt);
-    if (key == "children") {
+    jsi::String key = std::move(keyValue).getString(rt);
+    std::string name = key.utf8(rt);
+    const PropAtom atom = findPropAtom(name);
+    if (atom == kChildrenAtom) {
       continue;
     }
-    if (std::find(out.begin(), out.end(), key) == out.end()) {
-      out.push_back(std::move(key));
+    if (atom != PropAtom::None) {
+      name.clear();
     }
+    props.push_back(PropEntry{ReactDOMPropKey{atom, std::move(name)}, object.getProperty(rt, key)});
   }
+
+  std::sort(props.begin(), props.end(), [](const PropEntry& a, const PropEntry& b) { return a.key < b.key; });
+  return props;
+}
+
+// Orders two entries by key for mergeSortedKeys.
+template <typename Entry>
+int compareKeys(const Entry& previous, const Entry& next) {
+  return previous.key < next.key ? -1 : next.key < previous.key ? 1 : 0;
+}
+
+// Value::strictEquals, but values of different types, and primitives other
+// than strings, are compared without calling into the runtime.
+bool strictEqualValues(jsi::Runtime& rt, const jsi::Value& a, const jsi::Value& b) {
+  if (a.isNumber()) {
+    return b.isNumber() && a.getNumber() == b.getNumber();
+  }
+  if (a.isBool()) {
+    return b.isBool() && a.getBool() == b.getBool();
+  }
+  if (a.isUndefined()) {
+    return b.isUndefined();
+  }
+  if (a.isNull()) {
+    return b.isNull();
+  }
+  if (a.isString()) {
+    return b.isString() && jsi::Value::strictEquals(rt, a, b);
+  }
+  if (a.isObject()) {
+    return b.isObject() && jsi::Value::strictEquals(rt, a, b);
+  }
+  return jsi::Value::strictEquals(rt, a, b);
 }
 
 jsi::Value cloneValue(jsi::Runtime& rt, const jsi::Value& value) {
@@ -91,6 +123,170 @@ jsi::Value cloneValue(jsi::Runtime& rt, const jsi::Value& value) {
   return jsi::Value(rt, value);
 }
 
+// One declaration of a style object as a diff read it. Numbers stay
+// numbers and strings stay raw text, so values compare without the runtime;
+// any other value clears its property and is kept as empty text.
+struct StyleDeclaration {
+  ReactDOMPropKey key;
+  bool isNumber{false};
+  double number{0};
+  std::string text;
+
+  bool sameValue(const StyleDeclaration& other) const {
+    return isNumber ? other.isNumber && number == other.number : !other.isNumber && text == other.text;
+  }
+
+  std::string domText() const {
+    return isNumber ? dangerousStyleNumber(key.getName(), number) : dangerousStyleText(text);
+  }
+};
+
+// Kept on a style object as its native state once it has been diffed as the
+// next style, so the following diff, where it is the previous style, does
+// not read it again. It holds the values the object was diffed with, even
+// if the object is mutated afterwards.
+struct StyleDeclarations : jsi::NativeState {
+  std::vector<StyleDeclaration> declarations;
+};
+
+// Reads the declarations of `style` sorted by key, like collectSortedProps,
+// but keeping each value as a number or text instead of a jsi::Value.
+std::vector<StyleDeclaration> readStyleDeclarations(jsi::Runtime& rt, const jsi::Value& style) {
+  std::vector<StyleDeclaration> declarations;
+  if (!style.isObject()) {
+    return declarations;
+  }
+
+  jsi::Object object = style.getObject(rt);
+  jsi::Array names = object.getPropertyNames(rt);
+  size_t length = names.size(rt);
+  declarations.resize(length);
+
+  size_t count = 0;
+  for (size_t i = 0; i < length; ++i) {
+    jsi::Value keyValue = names.getValueAtIndex(rt, i);
+    if (!keyValue.isString()) {
+      continue;
+    }
+    jsi::String key = std::move(keyValue).getString(rt);
+    StyleDeclaration& declaration = declarations[count++];
+    declaration.key.name = key.utf8(rt);
+    declaration.key.atom = findPropAtom(declaration.key.name);
+    if (declaration.key.atom != PropAtom::None) {
+      declaration.key.name.clear();
+    }
+    jsi::Value value = object.getProperty(rt, key);
+    if (value.isNumber()) {
+      declaration.isNumber = true;
+      declaration.number = value.getNumber();
+    } else if (value.isString()) {
+      declaration.text = std::move(value).getString(rt).utf8(rt);
+    }
+  }
+  declarations.resize(count);
+
+  std::sort(declarations.begin(), declarations.end(), [](const StyleDeclaration& a, const StyleDeclaration& b) {
+    return a.key < b.key;
+  });
+  return declarations;
+}
+
+// The declarations of the previous style: the ones cached on it, or, for a
+// style that was never diffed as the next one, read now.
+std::shared_ptr<const StyleDeclarations> previousStyleDeclarations(jsi::Runtime& rt, const jsi::Value& style) {
+  if (style.isObject()) {
+    jsi::Object object = style.getObject(rt);
+    if (object.hasNativeState(rt)) {
+      if (auto cached = std::dynamic_pointer_cast<const StyleDeclarations>(object.getNativeState(rt))) {
+        return cached;
+      }
+    }
+  }
+  auto declarations = std::make_shared<StyleDeclarations>();
+  declarations->declarations = readStyleDeclarations(rt, style);
+  return declarations;
+}
+
+// The declarations of the next style, always read afresh, and cached on it
+// unless it already carries other native state.
+std::shared_ptr<const StyleDeclarations> nextStyleDeclarations(jsi::Runtime& rt, const jsi::Value& style) {
+  auto declarations = std::make_shared<StyleDeclarations>();
+  declarations->declarations = readStyleDeclarations(rt, style);
+  if (style.isObject()) {
+    jsi::Object object = style.getObject(rt);
+    if (!object.hasNativeState(rt) ||
+        std::dynamic_pointer_cast<StyleDeclarations>(object.getNativeState(rt))) {
+      object.setNativeState(rt, declarations);
+    }
+  }
+  return declarations;
+}
+
+// Lists the CSS properties that differ between two style objects; a
+// previous style that is not an object counts as empty, and the same object
+// on both sides has no changes. Properties whose new value clears them are
+// removed, as upstream's setValueForStyles writes "" for them.
+void diffStyles(
+  jsi::Runtime& rt,
+  const jsi::Value& previousStyle,
+  const jsi::Value& nextStyle,
+  ReactDOMDiffPropertiesResult& result) {
+  if (previousStyle.isObject() && strictEqualValues(rt, previousStyle, nextStyle)) {
+    return;
+  }
+  const auto previousDeclarations = previousStyleDeclarations(rt, previousStyle);
+  const auto nextDeclarations = nextStyleDeclarations(rt, nextStyle);
+  const std::vector<StyleDeclaration>& previous = previousDeclarations->declarations;
+  const std::vector<StyleDeclaration>& next = nextDeclarations->declarations;
+
+  auto handleNext = [&](const StyleDeclaration* previousDeclaration, const StyleDeclaration& nextDeclaration) {
+    if (previousDeclaration && previousDeclaration->sameValue(nextDeclaration)) {
+      return;
+    }
+    std::string value = nextDeclaration.domText();
+    if (!value.empty()) {
+      result.stylesToSet.push_back(ReactDOMStyleChange{nextDeclaration.key, std::move(value)});
+    } else if (previousDeclaration) {
+      result.stylesToRemove.push_back(nextDeclaration.key);
+    }
+  };
+
+  mergeSortedKeys(
+    previous.begin(),
+    previous.end(),
+    next.begin(),
+    next.end(),
+    compareKeys<StyleDeclaration>,
+    [&](const StyleDeclaration& removed) { result.stylesToRemove.push_back(removed.key); },
+    handleNext);
+}
+
+jsi::String keyString(jsi::Runtime& rt, const ReactDOMPropKey& key) {
+  const std::string_view name = key.getName();
+  return jsi::String::createFromUtf8(rt, reinterpret_cast<const uint8_t*>(name.data()), name.size());
+}
+
+jsi::PropNameID keyPropName(jsi::Runtime& rt, const ReactDOMPropKey& key) {
+  const std::string_view name = key.getName();
+  return jsi::PropNameID::forUtf8(rt, reinterpret_cast<const uint8_t*>(name.data()), name.size());
+}
+
+jsi::Array keyArray(jsi::Runtime& rt, const std::vector<ReactDOMPropKey>& keys) {
+  jsi::Array array(rt, keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    array.setValueAtIndex(rt, i, keyString(rt, keys[i]));
+  }
+  return array;
+}
+
+jsi::Object changeObject(jsi::Runtime& rt, const std::vector<ReactDOMPropChange>& changes) {
+  jsi::Object object(rt);
+  for (const auto& change : changes) {
+    object.setProperty(rt, keyPropName(rt, change), change.value);
+  }
+  return object;
+}
+
 } // namespace
 
 bool ReactDOMDiffPropertiesResult::hasChanges() const {
@@ -98,22 +294,13 @@ bool ReactDOMDiffPropertiesResult::hasChanges() const {
     !attributesToRemove.empty() ||
     !eventsToSet.empty() ||
     !eventsToRemove.empty() ||
+    !stylesToSet.empty() ||
+    !stylesToRemove.empty() ||
     textContent.has_value();
 }
 
 bool isReactDOMEventPropKey(const std::string& key) {
-  if (key.size() <= 2) {
-    return false;
-  }
-
-  const char first = key[0];
-  const char second = key[1];
-  if (!((first == 'o' || first == 'O') && (second == 'n' || second == 'N'))) {
-    return false;
-  }
-
-  unsigned char third = static_cast<unsigned char>(key[2]);
-  return third >= 'A' && third <= 'Z';
+  return isEventPropName(key);
 }
 
 ReactDOMDiffPropertiesResult diffReactDOMProperties(
@@ -122,80 +309,101 @@ ReactDOMDiffPropertiesResult diffReactDOMProperties(
   const jsi::Value& nextProps) {
   ReactDOMDiffPropertiesResult result;
 
-  std::vector<std::string> keys;
-  collectKeys(rt, previousProps, keys);
-  collectKeys(rt, nextProps, keys);
+  const std::vector<PropEntry> previous = collectSortedProps(rt, previousProps);
+  const std::vector<PropEntry> next = collectSortedProps(rt, nextProps);
 
-  auto pushUnique = [](std::vector<std::string>& list, const std::string& value) {
-    if (std::find(list.begin(), list.end(), value) == list.end()) {
-      list.push_back(value);
-    }
-  };
-
-  auto handleRemoval = [&](const std::string& key, bool isEvent) {
-    if (isEvent) {
-      pushUnique(result.eventsToRemove, key);
-    } else if (key == "className" || key == "class") {
-      result.attributesToSet.erase(key);
-      pushUnique(result.attributesToRemove, key);
-    } else if (key == "textContent") {
+  auto handleRemoval = [&](const ReactDOMPropKey& key) {
+    if (key.isEvent()) {
+      result.eventsToRemove.push_back(key);
+    } else if (key.atom == kTextContentAtom) {
       result.textContent = std::string();
     } else {
-      pushUnique(result.attributesToRemove, key);
+      result.attributesToRemove.push_back(key);
     }
   };
 
-  jsi::Object previousObject = previousProps.isObject() ? previousProps.asObject(rt) : jsi::Object(rt);
-  jsi::Object nextObject = nextProps.isObject() ? nextProps.asObject(rt) : jsi::Object(rt);
-
-  for (const std::string& key : keys) {
-    bool isEvent = isReactDOMEventPropKey(key);
-    jsi::PropNameID nameID = jsi::PropNameID::forUtf8(rt, key);
-
-    bool nextHas = nextProps.isObject() && nextObject.hasProperty(rt, nameID);
-    bool previousHas = previousProps.isObject() && previousObject.hasProperty(rt, nameID);
-
-    jsi::Value previousValue = previousHas ? previousObject.getProperty(rt, nameID) : jsi::Value::undefined();
-    jsi::Value nextValue = nextHas ? nextObject.getProperty(rt, nameID) : jsi::Value::undefined();
-
-    if (!nextHas) {
-      if (previousHas) {
-        handleRemoval(key, isEvent);
-      }
-      continue;
-    }
-
-    if (isEvent) {
+  // `previousValue` is null when the previous props lack the prop.
+  auto handleNext = [&](const ReactDOMPropKey& key, const jsi::Value* previousValue, const jsi::Value& nextValue) {
+    if (key.isEvent()) {
       if (nextValue.isNull() || nextValue.isUndefined()) {
-        handleRemoval(key, true);
-        continue;
-      }
-
-      if (!previousHas || !jsi::Value::strictEquals(rt, previousValue, nextValue)) {
-        result.eventsToSet.emplace(key, cloneValue(rt, nextValue));
+        handleRemoval(key);
+      } else if (!previousValue || !strictEqualValues(rt, *previousValue, nextValue)) {
+        result.eventsToSet.push_back(ReactDOMPropChange{key, cloneValue(rt, nextValue)});
       }
-      continue;
+      return;
     }
 
-    if (key == "textContent") {
+    if (key.atom == kTextContentAtom) {
       std::string text = coerceTextValue(rt, nextValue);
-      std::string previousText = previousHas ? coerceTextValue(rt, previousValue) : std::string();
-      if (!previousHas || text != previousText) {
+      if (!previousValue || text != coerceTextValue(rt, *previousValue)) {
         result.textContent = std::move(text);
       }
-      continue;
+      return;
+    }
+
+    if (key.atom == kStyleAtom && nextValue.isObject()) {
+      if (previousValue && !previousValue->isObject() && !previousValue->isNull() && !previousValue->isUndefined()) {
+        result.attributesToRemove.push_back(key);
+      }
+      const jsi::Value noStyle;
+      diffStyles(rt, previousValue ? *previousValue : noStyle, nextValue, result);
+      return;
     }
 
-    if (!nextValue.isUndefined() && !(nextValue.isNull() && !previousHas)) {
-      if (!previousHas || !jsi::Value::strictEquals(rt, previousValue, nextValue)) {
-        result.attributesToSet.emplace(key, cloneValue(rt, nextValue));
+    if (!nextValue.isUndefined() && !(nextValue.isNull() && !previousValue)) {
+      if (!previousValue || !strictEqualValues(rt, *previousValue, nextValue)) {
+        result.attributesToSet.push_back(ReactDOMPropChange{key, cloneValue(rt, nextValue)});
       }
     } else {
-      handleRemoval(key, false);
+      handleRemoval(key);
     }
-  }
+  };
+
+  mergeSortedKeys(
+    previous.begin(),
+    previous.end(),
+    next.begin(),
+    next.end(),
+    compareKeys<PropEntry>,
+    [&](const PropEntry& removed) { handleRemoval(removed.key); },
+    [&](const PropEntry* previousEntry, const PropEntry& nextEntry) {
+      handleNext(nextEntry.key, previousEntry ? &previousEntry->value : nullptr, nextEntry.value);
+    });
 
   return result;
 }
 
+jsi::Object createReactDOMUpdatePayload(jsi::Runtime& rt, const ReactDOMDiffPropertiesResult& diff) {
+  jsi::Object payload(rt);
+  if (!diff.attributesToSet.empty()) {
+    payload.setProperty(rt, "attributes", changeObject(rt, diff.attributesToSet));
+  }
+  if (!diff.eventsToSet.empty()) {
+    payload.setProperty(rt, "events", changeObject(rt, diff.eventsToSet));
+  }
+  if (!diff.attributesToRemove.empty()) {
+    payload.setProperty(rt, "removedAttributes", keyArray(rt, diff.attributesToRemove));
+  }
+  if (!diff.eventsToRemove.empty()) {
+    payload.setProperty(rt, "removedEvents", keyArray(rt, diff.eventsToRemove));
+  }
+  if (!diff.stylesToSet.empty()) {
+    jsi::Object styles(rt);
+    for (const auto& change : diff.stylesToSet) {
+      styles.setProperty(
+        rt,
+        keyPropName(rt, change),
+        jsi::String::createFromUtf8(rt, change.value));
+    }
+    payload.setProperty(rt, "styles", styles);
+  }
+  if (!diff.stylesToRemove.empty()) {
+    payload.setProperty(rt, "removedStyles", keyArray(rt, diff.stylesToRemove));
+  }
+  if (diff.textContent) {
+    payload.setProperty(rt, "text", jsi::String::createFromUtf8(rt, *diff.textContent));
+  }
+  return payload;
+}
+
 } // namespace react
@@ -1,18 +1,63 @@
 #pragma once
 
+#include "ReactDOMPropAtoms.h"
 #include "jsi/jsi.h"
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace react {
 
+// A prop named by its atom, or, when its name was never interned, by the
+// name itself: diffing looks names up without interning them, so props
+// with generated keys do not grow the atom table. Keys sort by atom, and
+// names without an atom sort first, by name.
+struct ReactDOMPropKey {
+  PropAtom atom{PropAtom::None};
+  // Empty unless `atom` is None.
+  std::string name;
+
+  std::string_view getName() const {
+    return atom != PropAtom::None ? propAtomName(atom) : std::string_view(name);
+  }
+
+  bool isEvent() const {
+    return atom != PropAtom::None ? isEventPropAtom(atom) : isEventPropName(name);
+  }
+
+  bool operator<(const ReactDOMPropKey& other) const {
+    return atom != other.atom ? atom < other.atom : name < other.name;
+  }
+
+  bool operator==(const ReactDOMPropKey& other) const {
+    return atom == other.atom && name == other.name;
+  }
+};
+
+struct ReactDOMPropChange : ReactDOMPropKey {
+  facebook::jsi::Value value;
+};
+
+// A CSS property change, with the value already in the form
+// dangerousStyleValue gives it.
+struct ReactDOMStyleChange : ReactDOMPropKey {
+  std::string value;
+};
+
+// Each list is sorted by key and names a prop at most once.
+//
+// A `style` object is diffed per CSS property into the style lists rather
+// than set as an attribute, so hosts apply them after the attribute lists:
+// a string style that gives way to an object is removed as an attribute
+// first.
 struct ReactDOMDiffPropertiesResult {
-  std::unordered_map<std::string, facebook::jsi::Value> attributesToSet;
-  std::vector<std::string> attributesToRemove;
-  std::unordered_map<std::string, facebook::jsi::Value> eventsToSet;
-  std::vector<std::string> eventsToRemove;
+  std::vector<ReactDOMPropChange> attributesToSet;
+  std::vector<ReactDOMPropKey> attributesToRemove;
+  std::vector<ReactDOMPropChange> eventsToSet;
+  std::vector<ReactDOMPropKey> eventsToRemove;
+  std::vector<ReactDOMStyleChange> stylesToSet;
+  std::vector<ReactDOMPropKey> stylesToRemove;
   std::optional<std::string> textContent;
 
   bool hasChanges() const;
@@ -20,9 +65,56 @@ struct ReactDOMDiffPropertiesResult {
 
 bool isReactDOMEventPropKey(const std::string& key);
 
+// The merge both props diffs are built on. Walks two ranges sorted by key,
+// each naming a key at most once, in one pass: `onRemoved(previous)` for a
+// key only the previous range has, and `onNext(previous, next)` for every
+// entry of the next range, with a pointer to the previous entry of the same
+// key or nullptr. `compare(previous, next)` orders a pair like strcmp.
+template <typename PreviousIt, typename NextIt, typename Compare, typename OnRemoved, typename OnNext>
+void mergeSortedKeys(
+  PreviousIt previousIt,
+  PreviousIt previousEnd,
+  NextIt nextIt,
+  NextIt nextEnd,
+  Compare&& compare,
+  OnRemoved&& onRemoved,
+  OnNext&& onNext) {
+  using PreviousPointer = decltype(&*previousIt);
+  while (previousIt != previousEnd || nextIt != nextEnd) {
+    const int order = previousIt == previousEnd ? 1 : nextIt == nextEnd ? -1 : compare(*previousIt, *nextIt);
+    if (order < 0) {
+      onRemoved(*previousIt);
+      ++previousIt;
+    } else if (order > 0) {
+      onNext(PreviousPointer{nullptr}, *nextIt);
+      ++nextIt;
+    } else {
+      onNext(&*previousIt, *nextIt);
+      ++previousIt;
+      ++nextIt;
+    }
+  }
+}
+
+// Diffs two props objects, ignoring `children`. Each side is read into an
+// array sorted by key with one property read per prop, and the arrays are
+// merged, so the diff is O(n log n) in the number of props. Values of
+// different types differ without a runtime call. Two `style` objects are
+// merged the same way, and only CSS properties whose values differ are
+// listed; the next style's declarations are kept on it as native state, so
+// the following diff does not read it again. Names are looked up with
+// findPropAtom, never interned.
 ReactDOMDiffPropertiesResult diffReactDOMProperties(
   facebook::jsi::Runtime& rt,
   const facebook::jsi::Value& previousProps,
   const facebook::jsi::Value& nextProps);
 
+// The update payload ReactDOMComponent::applyUpdate and the hosts read:
+// `attributes`, `events` and `styles` objects of new values,
+// `removedAttributes`, `removedEvents` and `removedStyles` arrays of names,
+// and `text`. Empty parts are left out.
+facebook::jsi::Object createReactDOMUpdatePayload(
+  facebook::jsi::Runtime& rt,
+  const ReactDOMDiffPropertiesResult& diff);
+
 } // namespace react
@@ -1,7 +1,107 @@
 #include "ReactDOMInstance.h"
 
+#include "ReactDOMPropAtoms.h"
+#include "runtime/ReactTextChildren.h"
+
 namespace react {
 
+const std::shared_ptr<ReactDOMInstance>& ReactDOMChildList::operator[](std::size_t index) const {
+  if (index >= index_.size()) {
+    const ReactDOMInstance* node = index_.empty() ? first_ : index_.back()->nextSibling_;
+    while (index_.size() <= index) {
+      node->indexPosition_ = index_.size();
+      index_.push_back(node);
+      node = node->nextSibling_;
+    }
+  }
+  return index_[index]->heldByParent_;
+}
+
+void ReactDOMChildList::truncateIndexAt(const ReactDOMInstance& child) {
+  const std::size_t position = child.indexPosition_;
+  if (position < index_.size() && index_[position] == &child) {
+    index_.resize(position);
+  }
+}
+
+ReactDOMInstance::~ReactDOMInstance() {
+  unlinkAllChildren();
+}
+
+void ReactDOMInstance::linkChild(std::shared_ptr<ReactDOMInstance> child, ReactDOMInstance* beforeChild) {
+  ReactDOMInstance& node = *child;
+  if (beforeChild != nullptr && beforeChild->parentInstance_ != this) {
+    beforeChild = nullptr;
+  }
+  if (beforeChild == &node) {
+    return;
+  }
+  if (node.parentInstance_ != nullptr) {
+    node.parentInstance_->unlinkChild(node);
+  }
+
+  if (beforeChild != nullptr) {
+    children.truncateIndexAt(*beforeChild);
+  } else if (children.index_.size() == children.size_) {
+    node.indexPosition_ = children.size_;
+    children.index_.push_back(&node);
+  }
+
+  ReactDOMInstance* previous = beforeChild != nullptr ? beforeChild->previousSibling_ : children.last_;
+  node.parentInstance_ = this;
+  node.previousSibling_ = previous;
+  node.nextSibling_ = beforeChild;
+  (previous != nullptr ? previous->nextSibling_ : children.first_) = &node;
+  (beforeChild != nullptr ? beforeChild->previousSibling_ : children.last_) = &node;
+  ++children.size_;
+
+  node.parent = weak_from_this();
+  node.heldByParent_ = std::move(child);
+}
+
+std::shared_ptr<ReactDOMInstance> ReactDOMInstance::unlinkChild(ReactDOMInstance& child) {
+  children.truncateIndexAt(child);
+  ReactDOMInstance* const previous = child.previousSibling_;
+  ReactDOMInstance* const next = child.nextSibling_;
+  (previous != nullptr ? previous->nextSibling_ : children.first_) = next;
+  (next != nullptr ? next->previousSibling_ : children.last_) = previous;
+  --children.size_;
+
+  child.parentInstance_ = nullptr;
+  child.previousSibling_ = nullptr;
+  child.nextSibling_ = nullptr;
+  child.parent.reset();
+  return std::move(child.heldByParent_);
+}
+
+void ReactDOMInstance::unlinkAllChildren() {
+  ReactDOMInstance* node = children.first_;
+  children.first_ = nullptr;
+  children.last_ = nullptr;
+  children.size_ = 0;
+  children.index_.clear();
+  while (node != nullptr) {
+    ReactDOMInstance* const next = node->nextSibling_;
+    node->parentInstance_ = nullptr;
+    node->previousSibling_ = nullptr;
+    node->nextSibling_ = nullptr;
+    node->parent.reset();
+    // May destroy `node`, which then releases its own children.
+    node->heldByParent_.reset();
+    node = next;
+  }
+}
+
+ReactDOMInstanceList ReactDOMInstance::takeChildren() {
+  ReactDOMInstanceList taken;
+  taken.reserve(children.size());
+  while (children.first_ != nullptr) {
+    taken.push_back(unlinkChild(*children.first_));
+  }
+  invalidateSubtreeHash();
+  return taken;
+}
+
 void ReactDOMInstance::setKey(std::string keyValue) {
   key = std::move(keyValue);
 }
@@ -10,26 +110,66 @@ const std::string& ReactDOMInstance::getKey() const {
   return key;
 }
 
+void ReactDOMInstance::removeAllChildren() {
+  const ReactDOMInstanceList existing(children.begin(), children.end());
+  for (const auto& child : existing) {
+    removeChild(child);
+  }
+}
+
+void ReactDOMInstance::replaceChildren(ReactDOMInstanceIterator first, ReactDOMInstanceIterator last) {
+  removeAllChildren();
+  appendChildren(first, last);
+}
+
+void ReactDOMInstance::appendChildren(
+  ReactDOMInstanceIterator first,
+  ReactDOMInstanceIterator last) {
+  for (; first != last; ++first) {
+    appendChild(*first);
+  }
+}
+
+void ReactDOMInstance::moveChildrenBefore(
+  ReactDOMInstanceIterator first,
+  ReactDOMInstanceIterator last,
+  std::shared_ptr<ReactDOMInstance> beforeChild) {
+  for (; first != last; ++first) {
+    insertChildBefore(*first, beforeChild);
+  }
+}
+
+void ReactDOMInstance::invalidateSubtreeHash() {
+  subtreeHash = 0;
+  // Ancestors of an instance without a hash have none either, so the walk
+  // stops at the first one already reset.
+  for (auto node = parent.lock(); node && node->subtreeHash != 0; node = node->parent.lock()) {
+    node->subtreeHash = 0;
+  }
+}
+
 facebook::jsi::Value ReactDOMInstance::get(
   facebook::jsi::Runtime& rt,
   const facebook::jsi::PropNameID& name) {
   auto nameStr = name.utf8(rt);
-  if (nameStr == "tagName") {
+  const PropAtom atom = findPropAtom(nameStr);
+  if (atom == kTagNameAtom) {
     return facebook::jsi::String::createFromUtf8(rt, tagName);
   }
-  if (nameStr == "className") {
+  if (atom == kClassNameAtom) {
     return facebook::jsi::String::createFromUtf8(rt, className);
   }
-  if (nameStr == "key") {
+  if (atom == kKeyAtom) {
     return facebook::jsi::String::createFromUtf8(rt, key);
   }
-  if (nameStr == "textContent") {
+  if (atom == kTextContentAtom) {
     return facebook::jsi::String::createFromUtf8(rt, getTextContent());
   }
-  if (nameStr == "children") {
+  if (atom == kChildrenAtom) {
     facebook::jsi::Array array(rt, children.size());
-    for (size_t i = 0; i < children.size(); ++i) {
-      array.setValueAtIndex(rt, i, facebook::jsi::Object::createFromHostObject(rt, children[i]));
+    size_t index = 0;
+    for (const auto& child : children) {
+      array.setValueAtIndex(rt, index++, facebook::jsi::Object::createFromHostObject(rt, child));
     }
     return array;
   }
@@ -46,22 +186,23 @@ void ReactDOMInstance::set(
   const facebook::jsi::PropNameID& name,
   const facebook::jsi::Value& value) {
   auto nameStr = name.utf8(rt);
-  if (nameStr == "className" && value.isString()) {
+  const PropAtom atom = findPropAtom(nameStr);
+  if (atom == kClassNameAtom && value.isString()) {
     className = value.asString(rt).utf8(rt);
     setAttribute("class", value);
     return;
   }
 
-  if (nameStr == "key" && value.isString()) {
+  if (atom == kKeyAtom && value.isString()) {
     setKey(value.asString(rt).utf8(rt));
     return;
   }
 
-  if (nameStr == "textContent") {
+  if (atom == kTextContentAtom) {
     if (value.isString()) {
       setTextContent(value.asString(rt).utf8(rt));
     } else if (value.isNumber()) {
-      setTextContent(std::to_string(value.getNumber()));
+      setTextContent(numberToText(value.getNumber()));
     } else if (value.isNull() || value.isUndefined()) {
       setTextContent("");
     }
@@ -1,15 +1,116 @@
 #pragma once
 
 #include "jsi/jsi.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace react {
 
-class ReactDOMInstance : public facebook::jsi::HostObject {
+class ReactDOMInstance;
+
+// What a host instance represents. The reconciler reads it instead of
+// casting; only ReactDOMComponent uses Element and Text, so instances of
+// any other subclass are Opaque and left alone.
+enum class HostNodeKind : std::uint8_t {
+  Opaque,
+  Element,
+  Text,
+};
+
+using ReactDOMInstanceList = std::vector<std::shared_ptr<ReactDOMInstance>>;
+// Bulk child operations take contiguous runs of children, so callers can pass
+// any vector regardless of its allocator.
+using ReactDOMInstanceIterator = const std::shared_ptr<ReactDOMInstance>*;
+
+// Children of a host instance, kept as an intrusive doubly-linked list
+// threaded through the children themselves, so appending, inserting and
+// removing a child are O(1). Positional reads go through an index of the
+// leading children: an insertion or removal truncates it at that position,
+// and reads extend it only as far as the position they ask for. Changed only
+// through ReactDOMInstance.
+class ReactDOMChildList {
 public:
-  virtual ~ReactDOMInstance() = default;
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::shared_ptr<ReactDOMInstance>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+    explicit const_iterator(const ReactDOMInstance* node) : node_(node) {}
+
+    reference operator*() const;
+    pointer operator->() const {
+      return &**this;
+    }
+    const_iterator& operator++();
+    const_iterator operator++(int) {
+      const_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    bool operator==(const const_iterator& other) const {
+      return node_ == other.node_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return node_ != other.node_;
+    }
+
+  private:
+    const ReactDOMInstance* node_{nullptr};
+  };
+  using iterator = const_iterator;
+
+  ReactDOMChildList() = default;
+  ReactDOMChildList(const ReactDOMChildList&) = delete;
+  ReactDOMChildList& operator=(const ReactDOMChildList&) = delete;
+
+  std::size_t size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+  const_iterator begin() const {
+    return const_iterator(first_);
+  }
+  const_iterator end() const {
+    return const_iterator();
+  }
+  const std::shared_ptr<ReactDOMInstance>& front() const;
+  const std::shared_ptr<ReactDOMInstance>& back() const;
+  const std::shared_ptr<ReactDOMInstance>& operator[](std::size_t index) const;
+
+private:
+  friend class ReactDOMInstance;
+
+  // Drops the indexed children from `child` on, if it is one of them.
+  void truncateIndexAt(const ReactDOMInstance& child);
+
+  ReactDOMInstance* first_{nullptr};
+  ReactDOMInstance* last_{nullptr};
+  std::size_t size_{0};
+  // The first index_.size() children, in order.
+  mutable std::vector<const ReactDOMInstance*> index_{};
+};
+
+class ReactDOMInstance
+  : public facebook::jsi::HostObject,
+    public std::enable_shared_from_this<ReactDOMInstance> {
+public:
+  // Detaches the children one at a time, so long sibling lists do not
+  // unwind recursively.
+  virtual ~ReactDOMInstance();
+
+  HostNodeKind nodeKind() const {
+    return nodeKind_;
+  }
 
   virtual void appendChild(std::shared_ptr<ReactDOMInstance> child) = 0;
   virtual void removeChild(std::shared_ptr<ReactDOMInstance> child) = 0;
@@ -17,6 +118,20 @@ public:
     std::shared_ptr<ReactDOMInstance> child,
     std::shared_ptr<ReactDOMInstance> beforeChild) = 0;
 
+  // Bulk child operations. The defaults fall back to the single-child
+  // methods; implementations override them to do each in one pass.
+  virtual void removeAllChildren();
+  virtual void replaceChildren(ReactDOMInstanceIterator first, ReactDOMInstanceIterator last);
+  virtual void appendChildren(
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last);
+  // Places [first, last) before `beforeChild`, or at the end when it is
+  // null, taking any of them that are already children out of their slots.
+  virtual void moveChildrenBefore(
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last,
+    std::shared_ptr<ReactDOMInstance> beforeChild);
+
   virtual void setAttribute(
     const std::string& key,
     const facebook::jsi::Value& value) = 0;
@@ -38,12 +153,76 @@ public:
   std::string tagName;
   std::string className;
   std::string key;
+  // Props fingerprint of the element last committed to this instance; 0 when
+  // unknown or when the props were changed outside the reconciler.
+  std::uint64_t propsFingerprint{0};
+  // Subtree hash of the element last committed to this instance; 0 when
+  // unknown. Any change to this instance or a descendant resets it.
+  std::uint64_t subtreeHash{0};
 
   std::weak_ptr<ReactDOMInstance> parent;
-  std::vector<std::shared_ptr<ReactDOMInstance>> children;
+  ReactDOMChildList children;
+
+  ReactDOMInstance* nextSibling() const {
+    return nextSibling_;
+  }
+  ReactDOMInstance* previousSibling() const {
+    return previousSibling_;
+  }
+  bool hasChild(const ReactDOMInstance& child) const {
+    return child.parentInstance_ == this;
+  }
+  // Detaches every child and hands over the references this instance held
+  // to them.
+  ReactDOMInstanceList takeChildren();
 
 protected:
+  ReactDOMInstance() = default;
+  explicit ReactDOMInstance(HostNodeKind kind) : nodeKind_(kind) {}
+
+  // Links `child` in before `beforeChild`, or last when that is null or not
+  // a child, taking it out of its current parent or slot first.
+  void linkChild(std::shared_ptr<ReactDOMInstance> child, ReactDOMInstance* beforeChild);
+  // Unlinks `child`, which must be a child of this instance, and returns
+  // the reference this instance held to it.
+  std::shared_ptr<ReactDOMInstance> unlinkChild(ReactDOMInstance& child);
+  void unlinkAllChildren();
+
+  // Resets the subtree hash of this instance and of its ancestors.
+  void invalidateSubtreeHash();
+
   void* hostData_{nullptr};
+  HostNodeKind nodeKind_{HostNodeKind::Opaque};
+
+private:
+  friend class ReactDOMChildList;
+
+  // Sibling links and the parent's reference to this instance, set while
+  // it is linked into a parent's children.
+  ReactDOMInstance* parentInstance_{nullptr};
+  ReactDOMInstance* previousSibling_{nullptr};
+  ReactDOMInstance* nextSibling_{nullptr};
+  // Slot in the parent's child index; current only while index_ holds this
+  // instance there.
+  mutable std::size_t indexPosition_{0};
+  std::shared_ptr<ReactDOMInstance> heldByParent_{};
 };
 
+inline ReactDOMChildList::const_iterator::reference ReactDOMChildList::const_iterator::operator*() const {
+  return node_->heldByParent_;
+}
+
+inline ReactDOMChildList::const_iterator& ReactDOMChildList::const_iterator::operator++() {
+  node_ = node_->nextSibling_;
+  return *this;
+}
+
+inline const std::shared_ptr<ReactDOMInstance>& ReactDOMChildList::front() const {
+  return first_->heldByParent_;
+}
+
+inline const std::shared_ptr<ReactDOMInstance>& ReactDOMChildList::back() const {
+  return last_->heldByParent_;
+}
+
 } // namespace react
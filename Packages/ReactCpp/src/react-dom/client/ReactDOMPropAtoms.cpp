@@ -0,0 +1,182 @@
+#include "ReactDOMPropAtoms.h"
+
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace react {
+
+namespace {
+
+constexpr std::size_t kBucketCount = 256;
+constexpr std::size_t kSlotCount = 1024;
+
+static_assert(kKnownPropNameCount * 2 <= kSlotCount, "grow kSlotCount with kKnownPropNames");
+static_assert(kKnownPropNameCount < 0x10000, "known prop indices are stored as uint16_t");
+
+constexpr std::uint32_t hashPropName(std::string_view name) {
+  std::uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+constexpr std::size_t bucketOf(std::uint32_t hash) {
+  return hash % kBucketCount;
+}
+
+constexpr std::size_t slotOf(std::uint32_t hash, std::uint32_t displacement) {
+  std::uint32_t mixed = hash + displacement * 0x9e3779b9u;
+  mixed ^= mixed >> 16;
+  mixed *= 0x7feb352du;
+  mixed ^= mixed >> 15;
+  return mixed & (kSlotCount - 1);
+}
+
+// Hash and displace: names are split into buckets by hash, and each bucket,
+// largest first, gets the smallest displacement that moves all of its names
+// into free slots. A lookup is then one hash, one displacement read and one
+// slot read.
+struct KnownPropTable {
+  std::uint16_t displacements[kBucketCount]{};
+  // Index into kKnownPropNames; 0 for an empty slot.
+  std::uint16_t slots[kSlotCount]{};
+};
+
+constexpr KnownPropTable buildKnownPropTable() {
+  for (std::size_t i = 1; i < kKnownPropNameCount; ++i) {
+    for (std::size_t j = i + 1; j < kKnownPropNameCount; ++j) {
+      if (kKnownPropNames[i] == kKnownPropNames[j]) {
+        throw std::logic_error("duplicate name in kKnownPropNames");
+      }
+    }
+  }
+
+  std::uint32_t hashes[kKnownPropNameCount]{};
+  std::size_t bucketSizes[kBucketCount]{};
+  std::size_t largestBucket = 0;
+  for (std::size_t i = 1; i < kKnownPropNameCount; ++i) {
+    hashes[i] = hashPropName(kKnownPropNames[i]);
+    const std::size_t size = ++bucketSizes[bucketOf(hashes[i])];
+    largestBucket = size > largestBucket ? size : largestBucket;
+  }
+
+  KnownPropTable table{};
+  for (std::size_t size = largestBucket; size > 0; --size) {
+    for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+      if (bucketSizes[bucket] != size) {
+        continue;
+      }
+      for (std::uint32_t displacement = 0;; ++displacement) {
+        if (displacement == 0x10000) {
+          throw std::logic_error("no displacement fits a kKnownPropNames bucket");
+        }
+        std::size_t placed[kKnownPropNameCount]{};
+        std::size_t placedCount = 0;
+        bool fits = true;
+        for (std::size_t i = 1; i < kKnownPropNameCount && fits; ++i) {
+          if (bucketOf(hashes[i]) != bucket) {
+            continue;
+          }
+          const std::size_t slot = slotOf(hashes[i], displacement);
+          if (table.slots[slot] != 0) {
+            fits = false;
+          } else {
+            table.slots[slot] = static_cast<std::uint16_t>(i);
+            placed[placedCount++] = slot;
+          }
+        }
+        if (fits) {
+          table.displacements[bucket] = static_cast<std::uint16_t>(displacement);
+          break;
+        }
+        for (std::size_t k = 0; k < placedCount; ++k) {
+          table.slots[placed[k]] = 0;
+        }
+      }
+    }
+  }
+  return table;
+}
+
+constexpr KnownPropTable kKnownPropTable = buildKnownPropTable();
+
+std::size_t knownPropIndex(std::string_view name) {
+  const std::uint32_t hash = hashPropName(name);
+  const std::size_t index = kKnownPropTable.slots[slotOf(hash, kKnownPropTable.displacements[bucketOf(hash)])];
+  return index != 0 && kKnownPropNames[index] == name ? index : 0;
+}
+
+// Names outside kKnownPropNames, at atom indices from kKnownPropNameCount
+// on. A deque so the strings, which the views in `atoms` and the ones
+// propAtomName returns point into, never move.
+struct InternedPropNames {
+  std::mutex mutex;
+  std::deque<std::string> names;
+  std::unordered_map<std::string_view, PropAtom> atoms;
+};
+
+InternedPropNames& internedPropNames() {
+  static InternedPropNames interned;
+  return interned;
+}
+
+} // namespace
+
+PropAtom internPropName(std::string_view name) {
+  if (const std::size_t index = knownPropIndex(name)) {
+    return makePropAtom(index, name);
+  }
+  if (name.empty()) {
+    return PropAtom::None;
+  }
+
+  auto& interned = internedPropNames();
+  std::lock_guard<std::mutex> lock(interned.mutex);
+  auto it = interned.atoms.find(name);
+  if (it != interned.atoms.end()) {
+    return it->second;
+  }
+  const PropAtom atom = makePropAtom(kKnownPropNameCount + interned.names.size(), name);
+  const std::string& stored = interned.names.emplace_back(name);
+  interned.atoms.emplace(stored, atom);
+  return atom;
+}
+
+PropAtom findPropAtom(std::string_view name) {
+  if (const std::size_t index = knownPropIndex(name)) {
+    return makePropAtom(index, name);
+  }
+
+  auto& interned = internedPropNames();
+  std::lock_guard<std::mutex> lock(interned.mutex);
+  auto it = interned.atoms.find(name);
+  return it != interned.atoms.end() ? it->second : PropAtom::None;
+}
+
+std::string_view propAtomName(PropAtom atom) {
+  const std::size_t index = propAtomIndex(atom);
+  if (index < kKnownPropNameCount) {
+    return kKnownPropNames[index];
+  }
+
+  // Interned names never move or change, so each thread keeps its own copy
+  // of the views and takes the lock only for atoms newer than its copy.
+  thread_local std::vector<std::string_view> cachedNames;
+  const std::size_t internedIndex = index - kKnownPropNameCount;
+  if (internedIndex >= cachedNames.size()) {
+    auto& interned = internedPropNames();
+    std::lock_guard<std::mutex> lock(interned.mutex);
+    for (std::size_t i = cachedNames.size(); i < interned.names.size(); ++i) {
+      cachedNames.push_back(interned.names[i]);
+    }
+  }
+  return cachedNames[internedIndex];
+}
+
+} // namespace react
@@ -0,0 +1,151 @@
+#pragma once
+
+// Prop names as atoms: small integers that prop maps hash and compare
+// instead of strings.
+//
+// The DOM attributes, event names and style keys in kKnownPropNames have
+// fixed atoms, looked up through a perfect hash built at compile time. Any
+// other name is interned on first use and keeps its atom, and its string,
+// for the life of the process. An atom also records whether its name is an
+// event prop (`on` followed by an uppercase letter), so that check is a bit
+// test.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace react {
+
+enum class PropAtom : std::uint32_t {
+  None = 0,
+};
+
+// Whether `name` is an event prop such as "onClick".
+constexpr bool isEventPropName(std::string_view name) {
+  if (name.size() <= 2) {
+    return false;
+  }
+  const char first = name[0];
+  const char second = name[1];
+  if (!((first == 'o' || first == 'O') && (second == 'n' || second == 'N'))) {
+    return false;
+  }
+  return name[2] >= 'A' && name[2] <= 'Z';
+}
+
+// Index 0 is reserved for PropAtom::None. Names must be unique; the perfect
+// hash fails to build otherwise.
+inline constexpr std::string_view kKnownPropNames[] = {
+  "",
+  // Reserved and host instance props.
+  "children", "textContent", "tagName", "key", "ref", "dangerouslySetInnerHTML",
+  "suppressContentEditableWarning", "suppressHydrationWarning",
+  // Attributes.
+  "className", "class", "id", "style", "title", "lang", "dir", "hidden", "tabIndex",
+  "role", "slot", "draggable", "contentEditable", "spellCheck", "translate",
+  "accessKey", "inputMode", "enterKeyHint", "autoCapitalize", "is",
+  "href", "hrefLang", "target", "rel", "download", "ping", "referrerPolicy",
+  "src", "srcSet", "sizes", "alt", "width", "height", "loading", "decoding",
+  "crossOrigin", "integrity", "useMap", "poster", "preload", "autoPlay", "controls",
+  "loop", "muted", "playsInline",
+  "type", "name", "value", "defaultValue", "checked", "defaultChecked", "disabled",
+  "placeholder", "readOnly", "required", "multiple", "selected", "autoFocus",
+  "autoComplete", "min", "max", "step", "pattern", "maxLength", "minLength", "size",
+  "rows", "cols", "wrap", "accept", "capture", "form", "formAction", "htmlFor",
+  "label", "list", "action", "method", "encType", "noValidate",
+  "colSpan", "rowSpan", "headers", "scope", "span", "start", "reversed",
+  "open", "content", "charSet", "httpEquiv", "async", "defer", "nonce",
+  "viewBox", "xmlns", "fill", "stroke", "strokeWidth", "d", "x", "y", "cx", "cy",
+  "r", "rx", "ry", "x1", "x2", "y1", "y2", "points", "transform", "opacity",
+  "aria-label", "aria-labelledby", "aria-describedby", "aria-hidden",
+  "aria-expanded", "aria-selected", "aria-checked", "aria-disabled",
+  "aria-controls", "aria-live", "aria-current", "data-testid",
+  // Events.
+  "onClick", "onDoubleClick", "onContextMenu", "onAuxClick",
+  "onMouseDown", "onMouseUp", "onMouseMove", "onMouseEnter", "onMouseLeave",
+  "onMouseOver", "onMouseOut",
+  "onPointerDown", "onPointerUp", "onPointerMove", "onPointerEnter",
+  "onPointerLeave", "onPointerOver", "onPointerOut", "onPointerCancel",
+  "onGotPointerCapture", "onLostPointerCapture",
+  "onTouchStart", "onTouchMove", "onTouchEnd", "onTouchCancel",
+  "onKeyDown", "onKeyUp", "onKeyPress",
+  "onFocus", "onBlur", "onFocusIn", "onFocusOut",
+  "onChange", "onInput", "onBeforeInput", "onInvalid", "onSubmit", "onReset", "onSelect",
+  "onScroll", "onScrollEnd", "onWheel",
+  "onDrag", "onDragStart", "onDragEnd", "onDragEnter", "onDragLeave", "onDragOver",
+  "onDrop",
+  "onCopy", "onCut", "onPaste",
+  "onCompositionStart", "onCompositionUpdate", "onCompositionEnd",
+  "onLoad", "onError", "onAbort", "onPlay", "onPause", "onEnded", "onTimeUpdate",
+  "onVolumeChange", "onLoadedData", "onLoadedMetadata", "onCanPlay", "onWaiting",
+  "onAnimationStart", "onAnimationEnd", "onAnimationIteration",
+  "onTransitionEnd", "onToggle",
+  "onClickCapture", "onKeyDownCapture", "onPointerDownCapture", "onFocusCapture",
+  // Style keys not listed above.
+  "display", "position", "top", "right", "bottom", "left", "zIndex",
+  "minWidth", "maxWidth", "minHeight", "maxHeight", "boxSizing", "overflow",
+  "overflowX", "overflowY", "visibility",
+  "margin", "marginTop", "marginRight", "marginBottom", "marginLeft",
+  "padding", "paddingTop", "paddingRight", "paddingBottom", "paddingLeft",
+  "border", "borderTop", "borderRight", "borderBottom", "borderLeft",
+  "borderWidth", "borderStyle", "borderColor", "borderRadius",
+  "outline", "boxShadow",
+  "flex", "flexDirection", "flexWrap", "flexGrow", "flexShrink", "flexBasis",
+  "alignItems", "alignSelf", "alignContent", "justifyContent", "justifyItems",
+  "gap", "rowGap", "columnGap", "order",
+  "gridTemplateColumns", "gridTemplateRows", "gridColumn", "gridRow", "gridArea",
+  "color", "background", "backgroundColor", "backgroundImage", "backgroundSize",
+  "backgroundPosition", "backgroundRepeat",
+  "font", "fontFamily", "fontSize", "fontWeight", "fontStyle", "lineHeight",
+  "letterSpacing", "textAlign", "textDecoration", "textTransform",
+  "textOverflow", "whiteSpace", "wordBreak", "verticalAlign",
+  "cursor", "pointerEvents", "userSelect", "objectFit",
+  "transition", "animation", "transformOrigin", "willChange", "filter",
+};
+
+inline constexpr std::size_t kKnownPropNameCount = sizeof(kKnownPropNames) / sizeof(kKnownPropNames[0]);
+
+constexpr PropAtom makePropAtom(std::size_t index, std::string_view name) {
+  return static_cast<PropAtom>((static_cast<std::uint32_t>(index) << 1) | (isEventPropName(name) ? 1u : 0u));
+}
+
+constexpr std::size_t propAtomIndex(PropAtom atom) {
+  return static_cast<std::uint32_t>(atom) >> 1;
+}
+
+constexpr bool isEventPropAtom(PropAtom atom) {
+  return (static_cast<std::uint32_t>(atom) & 1u) != 0;
+}
+
+// The atom of a name in kKnownPropNames, for naming atoms in constants;
+// lookups at run time go through internPropName or findPropAtom.
+constexpr PropAtom knownPropAtom(std::string_view name) {
+  for (std::size_t index = 1; index < kKnownPropNameCount; ++index) {
+    if (kKnownPropNames[index] == name) {
+      return makePropAtom(index, name);
+    }
+  }
+  return PropAtom::None;
+}
+
+inline constexpr PropAtom kChildrenAtom = knownPropAtom("children");
+inline constexpr PropAtom kTextContentAtom = knownPropAtom("textContent");
+inline constexpr PropAtom kTagNameAtom = knownPropAtom("tagName");
+inline constexpr PropAtom kKeyAtom = knownPropAtom("key");
+inline constexpr PropAtom kClassNameAtom = knownPropAtom("className");
+inline constexpr PropAtom kClassAtom = knownPropAtom("class");
+inline constexpr PropAtom kStyleAtom = knownPropAtom("style");
+
+// The atom for `name`, interning it if it is new. Never returns None for a
+// non-empty name.
+PropAtom internPropName(std::string_view name);
+
+// The atom for `name` if it is known or already interned, None otherwise.
+// Lookups of arbitrary names use this so they do not grow the atom table.
+PropAtom findPropAtom(std::string_view name);
+
+// The name of `atom`; empty for None. The view stays valid for the life of
+// the process.
+std::string_view propAtomName(PropAtom atom);
+
+} // namespace react
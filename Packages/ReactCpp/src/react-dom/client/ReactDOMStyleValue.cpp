@@ -0,0 +1,51 @@
+#include "ReactDOMStyleValue.h"
+
+#include "runtime/ReactTextChildren.h"
+
+namespace jsi = facebook::jsi;
+
+namespace react {
+
+namespace {
+
+// The whitespace String.prototype.trim strips that can occur in CSS text.
+bool isTrimmedSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+} // namespace
+
+std::string dangerousStyleValue(jsi::Runtime& rt, std::string_view name, const jsi::Value& value) {
+  if (value.isNumber()) {
+    return dangerousStyleNumber(name, value.getNumber());
+  }
+  if (!value.isString()) {
+    return std::string();
+  }
+  return dangerousStyleText(value.getString(rt).utf8(rt));
+}
+
+std::string dangerousStyleNumber(std::string_view name, double number) {
+  std::string text = numberToText(number);
+  if (number != 0 && !isCustomStyleProperty(name) && !isUnitlessNumberStyle(name)) {
+    text += "px";
+  }
+  return text;
+}
+
+std::string dangerousStyleText(std::string text) {
+  std::size_t first = 0;
+  std::size_t last = text.size();
+  while (first < last && isTrimmedSpace(text[first])) {
+    ++first;
+  }
+  while (last > first && isTrimmedSpace(text[last - 1])) {
+    --last;
+  }
+  if (first != 0 || last != text.size()) {
+    text = text.substr(first, last - first);
+  }
+  return text;
+}
+
+} // namespace react
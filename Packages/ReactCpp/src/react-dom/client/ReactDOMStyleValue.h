@@ -0,0 +1,117 @@
+#pragma once
+
+// Style values as the DOM receives them, after upstream React's
+// CSSProperty.isUnitlessNumber and dangerousStyleValue.
+
+#include "jsi/jsi.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace react {
+
+// Style properties whose numbers are not lengths, so 2 stays "2" rather
+// than becoming "2px". Sorted, for the binary search in
+// isUnitlessNumberStyle.
+inline constexpr std::string_view kUnitlessNumberStyles[] = {
+  "animationIterationCount", "aspectRatio", "borderImageOutset", "borderImageSlice",
+  "borderImageWidth", "boxFlex", "boxFlexGroup", "boxOrdinalGroup", "columnCount",
+  "columns", "fillOpacity", "flex", "flexGrow", "flexNegative", "flexOrder",
+  "flexPositive", "flexShrink", "floodOpacity", "fontWeight", "gridArea", "gridColumn",
+  "gridColumnEnd", "gridColumnSpan", "gridColumnStart", "gridRow", "gridRowEnd",
+  "gridRowSpan", "gridRowStart", "lineClamp", "lineHeight", "opacity", "order",
+  "orphans", "scale", "stopOpacity", "strokeDasharray", "strokeDashoffset",
+  "strokeMiterlimit", "strokeOpacity", "strokeWidth", "tabSize", "widows", "zIndex",
+  "zoom",
+};
+
+inline constexpr std::size_t kUnitlessNumberStyleCount =
+  sizeof(kUnitlessNumberStyles) / sizeof(kUnitlessNumberStyles[0]);
+
+// Whether `name` is a custom property such as "--accent-color", which takes
+// its value verbatim.
+constexpr bool isCustomStyleProperty(std::string_view name) {
+  return name.size() > 2 && name[0] == '-' && name[1] == '-';
+}
+
+namespace detail {
+
+constexpr char lowerAsciiLetter(char c) {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Compares `entry` with the name whose first letter is `first` and whose
+// remaining letters are `tail`.
+constexpr int compareStyleName(std::string_view entry, char first, std::string_view tail) {
+  if (entry[0] != first) {
+    return entry[0] < first ? -1 : 1;
+  }
+  return entry.substr(1).compare(tail);
+}
+
+constexpr bool findUnitlessNumberStyle(char first, std::string_view tail) {
+  std::size_t low = 0;
+  std::size_t high = kUnitlessNumberStyleCount;
+  while (low < high) {
+    const std::size_t mid = low + (high - low) / 2;
+    const int order = compareStyleName(kUnitlessNumberStyles[mid], first, tail);
+    if (order == 0) {
+      return true;
+    }
+    if (order < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return false;
+}
+
+constexpr bool unitlessNumberStylesSorted() {
+  for (std::size_t i = 1; i < kUnitlessNumberStyleCount; ++i) {
+    if (!(kUnitlessNumberStyles[i - 1] < kUnitlessNumberStyles[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace detail
+
+static_assert(detail::unitlessNumberStylesSorted(), "kUnitlessNumberStyles must be sorted and unique");
+
+// Whether numbers for `name` go to the DOM without a "px" suffix. Vendor
+// prefixed names ("WebkitFlexGrow", "msGridRow") match their unprefixed
+// entry, as upstream's table lists every prefix of each name.
+constexpr bool isUnitlessNumberStyle(std::string_view name) {
+  if (name.empty()) {
+    return false;
+  }
+  if (detail::findUnitlessNumberStyle(name[0], name.substr(1))) {
+    return true;
+  }
+  for (std::string_view prefix : {"Webkit", "Moz", "ms", "O"}) {
+    if (name.size() > prefix.size() + 1 && name.substr(0, prefix.size()) == prefix &&
+        name[prefix.size()] >= 'A' && name[prefix.size()] <= 'Z') {
+      return detail::findUnitlessNumberStyle(
+        detail::lowerAsciiLetter(name[prefix.size()]), name.substr(prefix.size() + 1));
+    }
+  }
+  return false;
+}
+
+// The text the DOM gets for style `name` set to `value`. Null, undefined,
+// booleans, objects and "" give "", which clears the property; non-zero
+// numbers of length properties get "px"; strings are trimmed.
+std::string dangerousStyleValue(
+  facebook::jsi::Runtime& rt,
+  std::string_view name,
+  const facebook::jsi::Value& value);
+
+// dangerousStyleValue for a number or a string already read out of the
+// runtime.
+std::string dangerousStyleNumber(std::string_view name, double number);
+std::string dangerousStyleText(std::string text);
+
+} // namespace react
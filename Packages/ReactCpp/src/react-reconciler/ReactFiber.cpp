@@ -36,11 +36,21 @@ std::unique_ptr<FiberNode::Dependencies> cloneDependencies(
   auto clone = std::make_unique<FiberNode::Dependencies>();
   clone->lanes = source->lanes;
   clone->firstContext = source->firstContext;
+  clone->contextStorage = source->contextStorage;
   return clone;
 }
 
 } // namespace
 
+FiberNode::~FiberNode() {
+  if (queueOwnerArena != nullptr) {
+    queueOwnerArena->forgetOwner(*this);
+  }
+  if (alternate != nullptr && alternate->alternate == this) {
+    alternate->alternate = nullptr;
+  }
+}
+
 FiberNode* createFiber(
     WorkTag tag,
     void* pendingProps,
@@ -118,6 +128,7 @@ FiberNode* createWorkInProgress(FiberNode* current, void* pendingProps) {
   workInProgress->child = current->child;
   workInProgress->memoizedProps = current->memoizedProps;
   workInProgress->memoizedState = current->memoizedState;
+  workInProgress->hookStorage = current->hookStorage;
   workInProgress->updateQueue = current->updateQueue;
   workInProgress->dependencies = cloneDependencies(current->dependencies.get());
 
@@ -151,6 +162,7 @@ FiberNode* resetWorkInProgress(FiberNode* workInProgress, Lanes renderLanes) {
     workInProgress->deletions.clear();
     workInProgress->memoizedProps = nullptr;
     workInProgress->memoizedState = nullptr;
+    workInProgress->hookStorage.reset();
     workInProgress->updateQueue = nullptr;
     workInProgress->dependencies.reset();
     workInProgress->stateNode = nullptr;
@@ -168,6 +180,7 @@ FiberNode* resetWorkInProgress(FiberNode* workInProgress, Lanes renderLanes) {
     workInProgress->deletions.clear();
     workInProgress->memoizedProps = current->memoizedProps;
     workInProgress->memoizedState = current->memoizedState;
+    workInProgress->hookStorage = current->hookStorage;
     workInProgress->updateQueue = current->updateQueue;
     workInProgress->type = current->type;
     workInProgress->dependencies = cloneDependencies(current->dependencies.get());
@@ -16,10 +16,22 @@
 
 namespace react {
 
+class FiberRootArena;
+
 struct FiberNode {
+  FiberNode() = default;
+  FiberNode(const FiberNode&) = delete;
+  FiberNode& operator=(const FiberNode&) = delete;
+  // Unregisters from queueOwnerArena and unlinks the alternate's pointer
+  // back to this fiber.
+  ~FiberNode();
+
   struct Dependencies {
     Lanes lanes{NoLanes};
     void* firstContext{nullptr};
+    // Keeps the firstContext list alive while the current or work-in-progress
+    // copy of these dependencies still points at it.
+    std::shared_ptr<void> contextStorage{};
   };
 
   WorkTag tag{WorkTag::IndeterminateComponent};
@@ -40,6 +52,9 @@ struct FiberNode {
   void* memoizedProps{nullptr};
   void* updateQueue{nullptr};
   void* memoizedState{nullptr};
+  // Owns the hook slot buffers memoizedState points into for function
+  // components; shared with the alternate, which uses the other buffer.
+  std::shared_ptr<void> hookStorage{};
   std::unique_ptr<Dependencies> dependencies{};
 
   TypeOfMode mode{NoMode};
@@ -53,6 +68,10 @@ struct FiberNode {
 
   FiberNode* alternate{nullptr};
 
+  // The root arena that installed this fiber's updateQueue and clears it on
+  // release, if any.
+  FiberRootArena* queueOwnerArena{nullptr};
+
   double actualDuration{0.0};
   double actualStartTime{0.0};
   double selfBaseDuration{0.0};
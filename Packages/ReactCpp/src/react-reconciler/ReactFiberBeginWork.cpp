@@ -0,0 +1,49 @@
+#include "react-reconciler/ReactFiberBeginWork.h"
+
+#include "react-reconciler/ReactFiber.h"
+#include "runtime/ReactRuntime.h"
+
+namespace react {
+
+FiberNode* bailoutOnAlreadyFinishedWork(FiberNode& workInProgress, Lanes renderLanes) {
+  if (!includesSomeLane(renderLanes, workInProgress.childLanes)) {
+    // Nothing below has work either; keep the current children as they are.
+    return nullptr;
+  }
+  cloneChildFibers(workInProgress);
+  return workInProgress.child;
+}
+
+void cloneChildFibers(FiberNode& workInProgress) {
+  FiberNode* currentChild = workInProgress.child;
+  if (currentChild == nullptr) {
+    return;
+  }
+
+  FiberNode* newChild = createWorkInProgress(currentChild, currentChild->pendingProps);
+  workInProgress.child = newChild;
+  newChild->returnFiber = &workInProgress;
+  while (currentChild->sibling != nullptr) {
+    currentChild = currentChild->sibling;
+    newChild = newChild->sibling = createWorkInProgress(currentChild, currentChild->pendingProps);
+    newChild->returnFiber = &workInProgress;
+  }
+  newChild->sibling = nullptr;
+}
+
+FiberNode* beginWork(ReactRuntime& runtime, FiberNode* current, FiberNode& workInProgress, Lanes renderLanes) {
+  if (current != nullptr && current->memoizedProps == workInProgress.pendingProps &&
+      !includesSomeLane(workInProgress.lanes, renderLanes)) {
+    return bailoutOnAlreadyFinishedWork(workInProgress, renderLanes);
+  }
+
+  workInProgress.lanes = NoLanes;
+  if (const ComponentUpdater& updater = runtime.componentUpdater()) {
+    return updater(runtime, current, workInProgress, renderLanes);
+  }
+  // Nothing renders the fiber's type without the child reconciler, so it
+  // keeps the children it was built with.
+  return workInProgress.child;
+}
+
+} // namespace react
@@ -0,0 +1,25 @@
+#pragma once
+
+// Bailout path of react-main/packages/react-reconciler/src/ReactFiberBeginWork.js.
+//
+// A fiber whose props are unchanged and that has no work in the render lanes
+// bails out: its children are cloned into the work-in-progress tree when
+// their subtree has work, and skipped otherwise. The updateXxx paths need the
+// child reconciler (ReactChildFiber), which is not ported; until it is, a
+// fiber that does not bail out goes to the runtime's ComponentUpdater, and
+// keeps the children it was built with when none is installed.
+
+#include "react-reconciler/ReactFiberLane.h"
+
+namespace react {
+
+class FiberNode;
+class ReactRuntime;
+
+FiberNode* bailoutOnAlreadyFinishedWork(FiberNode& workInProgress, Lanes renderLanes);
+
+void cloneChildFibers(FiberNode& workInProgress);
+
+FiberNode* beginWork(ReactRuntime& runtime, FiberNode* current, FiberNode& workInProgress, Lanes renderLanes);
+
+} // namespace react
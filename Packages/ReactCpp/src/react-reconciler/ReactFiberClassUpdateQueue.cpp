@@ -1,33 +1,34 @@
 #include "react-reconciler/ReactFiberClassUpdateQueue.h"
 
-#include <utility>
+#include "react-reconciler/ReactFiberRootArena.h"
 
 namespace react {
 namespace {
 
-ClassUpdateQueue* cloneClassUpdateQueue(const ClassUpdateQueue& source) {
-  auto* queue = new ClassUpdateQueue();
+ClassUpdateQueue* cloneClassUpdateQueue(
+    FiberRootArena& arena,
+    FiberNode& fiber,
+    const ClassUpdateQueue& source) {
+  auto* queue = arena.createForFiber<ClassUpdateQueue>(fiber);
   queue->baseState = source.baseState;
 
   ClassUpdate* current = source.firstBaseUpdate;
   ClassUpdate* previousClone = nullptr;
   while (current != nullptr) {
-    auto clone = std::make_unique<ClassUpdate>();
+    auto* clone = arena.create<ClassUpdate>();
+    arena.adopt(queue, clone);
     clone->lane = current->lane;
     clone->tag = current->tag;
     clone->payload = current->payload;
     clone->callback = current->callback;
     clone->next = nullptr;
 
-    ClassUpdate* clonePtr = clone.get();
-    queue->ownedUpdates.push_back(std::move(clone));
-
     if (previousClone == nullptr) {
-      queue->firstBaseUpdate = clonePtr;
+      queue->firstBaseUpdate = clone;
     } else {
-      previousClone->next = clonePtr;
+      previousClone->next = clone;
     }
-    previousClone = clonePtr;
+    previousClone = clone;
 
     current = current->next;
   }
@@ -36,17 +37,30 @@ ClassUpdateQueue* cloneClassUpdateQueue(const ClassUpdateQueue& source) {
   return queue;
 }
 
-ClassUpdateQueue* createClassUpdateQueue(FiberNode& fiber) {
-  auto* queue = new ClassUpdateQueue();
+ClassUpdateQueue* createClassUpdateQueue(FiberRootArena& arena, FiberNode& fiber) {
+  auto* queue = arena.createForFiber<ClassUpdateQueue>(fiber);
   queue->baseState = fiber.memoizedState;
   queue->firstBaseUpdate = nullptr;
   queue->lastBaseUpdate = nullptr;
   return queue;
 }
 
+void appendClassUpdate(FiberRootArena& arena, ClassUpdateQueue& queue, ClassUpdate* update) {
+  arena.adopt(&queue, update);
+  update->next = nullptr;
+
+  if (queue.lastBaseUpdate == nullptr) {
+    queue.firstBaseUpdate = update;
+    queue.lastBaseUpdate = update;
+  } else {
+    queue.lastBaseUpdate->next = update;
+    queue.lastBaseUpdate = update;
+  }
+}
+
 } // namespace
 
-ClassUpdateQueue& ensureClassUpdateQueue(FiberNode& fiber) {
+ClassUpdateQueue& ensureClassUpdateQueue(FiberRoot& root, FiberNode& fiber) {
   auto* queue = static_cast<ClassUpdateQueue*>(fiber.updateQueue);
   if (queue != nullptr) {
     return *queue;
@@ -54,22 +68,18 @@ ClassUpdateQueue& ensureClassUpdateQueue(FiberNode& fiber) {
 
   if (FiberNode* const current = fiber.alternate) {
     if (auto* const currentQueue = static_cast<ClassUpdateQueue*>(current->updateQueue)) {
-      queue = cloneClassUpdateQueue(*currentQueue);
-      fiber.updateQueue = queue;
-      return *queue;
+      return *cloneClassUpdateQueue(root.updateQueueArena, fiber, *currentQueue);
     }
   }
 
-  queue = createClassUpdateQueue(fiber);
-  fiber.updateQueue = queue;
-  return *queue;
+  return *createClassUpdateQueue(root.updateQueueArena, fiber);
 }
 
-std::unique_ptr<ClassUpdate> createRootErrorClassUpdate(
+ClassUpdate* createRootErrorClassUpdate(
     FiberRoot& root,
     const CapturedValue& errorInfo,
     Lane lane) {
-  auto update = std::make_unique<ClassUpdate>();
+  auto* update = root.updateQueueArena.create<ClassUpdate>();
   update->lane = lane;
   update->tag = ClassUpdateTag::CaptureUpdate;
   update->payload = nullptr;
@@ -80,8 +90,8 @@ std::unique_ptr<ClassUpdate> createRootErrorClassUpdate(
   return update;
 }
 
-std::unique_ptr<ClassUpdate> createClassErrorUpdate(Lane lane) {
-  auto update = std::make_unique<ClassUpdate>();
+ClassUpdate* createClassErrorUpdate(FiberRoot& root, Lane lane) {
+  auto* update = root.updateQueueArena.create<ClassUpdate>();
   update->lane = lane;
   update->tag = ClassUpdateTag::CaptureUpdate;
   update->payload = nullptr;
@@ -108,34 +118,12 @@ void initializeClassErrorUpdate(
   };
 }
 
-void enqueueCapturedClassUpdate(FiberNode& fiber, std::unique_ptr<ClassUpdate> update) {
-  ClassUpdateQueue& queue = ensureClassUpdateQueue(fiber);
-  ClassUpdate* const updatePtr = update.get();
-  updatePtr->next = nullptr;
-  queue.ownedUpdates.push_back(std::move(update));
-
-  if (queue.lastBaseUpdate == nullptr) {
-    queue.firstBaseUpdate = updatePtr;
-    queue.lastBaseUpdate = updatePtr;
-  } else {
-    queue.lastBaseUpdate->next = updatePtr;
-    queue.lastBaseUpdate = updatePtr;
-  }
+void enqueueCapturedClassUpdate(FiberRoot& root, FiberNode& fiber, ClassUpdate* update) {
+  appendClassUpdate(root.updateQueueArena, ensureClassUpdateQueue(root, fiber), update);
 }
 
-void pushClassUpdate(FiberNode& fiber, std::unique_ptr<ClassUpdate> update) {
-  ClassUpdateQueue& queue = ensureClassUpdateQueue(fiber);
-  ClassUpdate* const updatePtr = update.get();
-  updatePtr->next = nullptr;
-  queue.ownedUpdates.push_back(std::move(update));
-
-  if (queue.lastBaseUpdate == nullptr) {
-    queue.firstBaseUpdate = updatePtr;
-    queue.lastBaseUpdate = updatePtr;
-  } else {
-    queue.lastBaseUpdate->next = updatePtr;
-    queue.lastBaseUpdate = updatePtr;
-  }
+void pushClassUpdate(FiberRoot& root, FiberNode& fiber, ClassUpdate* update) {
+  appendClassUpdate(root.updateQueueArena, ensureClassUpdateQueue(root, fiber), update);
 }
 
 } // namespace react
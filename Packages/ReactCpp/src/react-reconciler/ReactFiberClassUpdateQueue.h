@@ -6,8 +6,6 @@
 #include "react-reconciler/ReactCapturedValue.h"
 
 #include <functional>
-#include <memory>
-#include <vector>
 
 namespace react {
 
@@ -31,25 +29,28 @@ struct ClassUpdate {
   ClassUpdate* next{nullptr};
 };
 
+// Queues and updates are allocated from FiberRoot::updateQueueArena. A
+// queue is owned by the fiber it was installed on and adopts the updates
+// appended to it, so a queue that neither that fiber nor its alternate
+// points at any more is freed, updates included, at the next commit.
 struct ClassUpdateQueue {
   void* baseState{nullptr};
   ClassUpdate* firstBaseUpdate{nullptr};
   ClassUpdate* lastBaseUpdate{nullptr};
-  std::vector<std::unique_ptr<ClassUpdate>> ownedUpdates{};
 };
 
-ClassUpdateQueue& ensureClassUpdateQueue(FiberNode& fiber);
-std::unique_ptr<ClassUpdate> createRootErrorClassUpdate(
+ClassUpdateQueue& ensureClassUpdateQueue(FiberRoot& root, FiberNode& fiber);
+ClassUpdate* createRootErrorClassUpdate(
     FiberRoot& root,
     const CapturedValue& errorInfo,
     Lane lane);
-std::unique_ptr<ClassUpdate> createClassErrorUpdate(Lane lane);
+ClassUpdate* createClassErrorUpdate(FiberRoot& root, Lane lane);
 void initializeClassErrorUpdate(
     ClassUpdate& update,
     FiberRoot& root,
     FiberNode& fiber,
     const CapturedValue& errorInfo);
-void enqueueCapturedClassUpdate(FiberNode& fiber, std::unique_ptr<ClassUpdate> update);
-void pushClassUpdate(FiberNode& fiber, std::unique_ptr<ClassUpdate> update);
+void enqueueCapturedClassUpdate(FiberRoot& root, FiberNode& fiber, ClassUpdate* update);
+void pushClassUpdate(FiberRoot& root, FiberNode& fiber, ClassUpdate* update);
 
 } // namespace react
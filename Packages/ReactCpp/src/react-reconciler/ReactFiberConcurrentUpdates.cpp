@@ -3,7 +3,9 @@
 #include "ReactFiberLane.h"
 #include "ReactFiber.h"
 
-#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 namespace react {
@@ -22,7 +24,220 @@ struct ConcurrentQueueEntry {
 	Lane lane{NoLane};
 };
 
-std::vector<ConcurrentQueueEntry> gConcurrentQueueEntries;
+constexpr std::size_t kInitialConcurrentQueueCapacity = 64;
+
+// Entries queued during render are kept in a power-of-two ring that survives
+// across batches. When a batch outgrows the ring the excess spills into an
+// overflow vector, and the ring is resized to the observed high-water mark
+// once that batch has been flushed, so steady-state batches never allocate.
+class ConcurrentQueueRing {
+public:
+	ConcurrentQueueRing() : slots_(kInitialConcurrentQueueCapacity) {}
+
+	void push(const ConcurrentQueueEntry& entry) {
+		if (count_ < slots_.size()) {
+			slots_[(head_ + count_) & (slots_.size() - 1)] = entry;
+			++count_;
+			return;
+		}
+		spill_.push_back(entry);
+	}
+
+	[[nodiscard]] std::size_t size() const {
+		return count_ + spill_.size();
+	}
+
+	[[nodiscard]] std::size_t capacity() const {
+		return slots_.size();
+	}
+
+	[[nodiscard]] std::size_t highWaterMark() const {
+		return highWaterMark_;
+	}
+
+	[[nodiscard]] const ConcurrentQueueEntry& operator[](std::size_t index) const {
+		if (index < count_) {
+			return slots_[(head_ + index) & (slots_.size() - 1)];
+		}
+		return spill_[index - count_];
+	}
+
+	// Drops the first `processed` entries. Anything queued while they were
+	// being processed stays queued for the next flush.
+	void consume(std::size_t processed) {
+		highWaterMark_ = std::max(highWaterMark_, size());
+
+		const auto fromRing = std::min(processed, count_);
+		head_ = (head_ + fromRing) & (slots_.size() - 1);
+		count_ -= fromRing;
+		const auto fromSpill = processed - fromRing;
+		if (fromSpill > 0) {
+			spill_.erase(spill_.begin(), spill_.begin() + static_cast<std::ptrdiff_t>(fromSpill));
+		}
+
+		if (highWaterMark_ > slots_.size()) {
+			grow();
+		}
+	}
+
+private:
+	void grow() {
+		std::size_t nextCapacity = slots_.size();
+		while (nextCapacity < highWaterMark_) {
+			nextCapacity <<= 1;
+		}
+
+		std::vector<ConcurrentQueueEntry> nextSlots(nextCapacity);
+		std::size_t nextCount = 0;
+		for (std::size_t i = 0; i < count_; ++i) {
+			nextSlots[nextCount++] = slots_[(head_ + i) & (slots_.size() - 1)];
+		}
+		for (const auto& entry : spill_) {
+			nextSlots[nextCount++] = entry;
+		}
+
+		slots_ = std::move(nextSlots);
+		head_ = 0;
+		count_ = nextCount;
+		spill_.clear();
+		spill_.shrink_to_fit();
+	}
+
+	std::vector<ConcurrentQueueEntry> slots_;
+	std::size_t head_{0};
+	std::size_t count_{0};
+	std::vector<ConcurrentQueueEntry> spill_{};
+	std::size_t highWaterMark_{0};
+};
+
+// One entry per distinct updated fiber in a flush. `lanes` is the union of
+// every lane queued against the fiber in the batch.
+struct FiberLaneGroup {
+	FiberNode* fiber{nullptr};
+	Lanes lanes{NoLanes};
+	FiberRoot* root{nullptr};
+	bool isHidden{false};
+};
+
+// One entry per ancestor already reached during a flush. Everything above
+// `fiber` carries `lanes` in its childLanes, so later walks that arrive here
+// with a subset of those lanes can stop and reuse `root` and `isHidden`.
+struct PropagatedAncestor {
+	FiberNode* fiber{nullptr};
+	Lanes lanes{NoLanes};
+	FiberRoot* root{nullptr};
+	bool isHidden{false};
+};
+
+// Open-addressed fiber -> entry index table, reused across flushes. Slots hold
+// `entryIndex + 1` so that zero marks an empty slot. The table grows when it
+// gets half full, so `reset` only needs a sizing hint.
+template <typename Entry>
+class FiberKeyedTable {
+public:
+	void reset(std::size_t expectedEntries) {
+		std::size_t capacity = 16;
+		while (capacity < expectedEntries * 2) {
+			capacity <<= 1;
+		}
+		if (slots_.size() < capacity) {
+			slots_.assign(capacity, 0);
+		} else {
+			for (const auto slot : usedSlots_) {
+				slots_[slot] = 0;
+			}
+		}
+		usedSlots_.clear();
+		entries_.clear();
+	}
+
+	Entry* find(const FiberNode* fiber) {
+		const std::size_t mask = slots_.size() - 1;
+		std::size_t slot = hash(fiber) & mask;
+		while (slots_[slot] != 0) {
+			auto& entry = entries_[slots_[slot] - 1];
+			if (entry.fiber == fiber) {
+				return &entry;
+			}
+			slot = (slot + 1) & mask;
+		}
+		return nullptr;
+	}
+
+	Entry& groupFor(FiberNode* fiber) {
+		if (Entry* existing = find(fiber)) {
+			return *existing;
+		}
+		if ((entries_.size() + 1) * 2 > slots_.size()) {
+			rehash(slots_.size() * 2);
+		}
+		entries_.push_back(Entry{fiber});
+		insertSlot(fiber, static_cast<std::uint32_t>(entries_.size()));
+		return entries_.back();
+	}
+
+	// Entry indices ordered by fiber address, so neighbouring fibers are
+	// visited together. The table itself keeps insertion order.
+	const std::vector<std::uint32_t>& addressOrder() {
+		order_.resize(entries_.size());
+		for (std::size_t i = 0; i < order_.size(); ++i) {
+			order_[i] = static_cast<std::uint32_t>(i);
+		}
+		std::sort(order_.begin(), order_.end(), [this](std::uint32_t a, std::uint32_t b) {
+			return std::less<FiberNode*>{}(entries_[a].fiber, entries_[b].fiber);
+		});
+		return order_;
+	}
+
+	Entry& operator[](std::uint32_t index) {
+		return entries_[index];
+	}
+
+	[[nodiscard]] std::size_t size() const {
+		return entries_.size();
+	}
+
+private:
+	static std::size_t hash(const FiberNode* fiber) {
+		auto bits = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(fiber));
+		bits ^= bits >> 33;
+		bits *= 0xff51afd7ed558ccdULL;
+		bits ^= bits >> 33;
+		return static_cast<std::size_t>(bits);
+	}
+
+	void insertSlot(const FiberNode* fiber, std::uint32_t value) {
+		const std::size_t mask = slots_.size() - 1;
+		std::size_t slot = hash(fiber) & mask;
+		while (slots_[slot] != 0) {
+			slot = (slot + 1) & mask;
+		}
+		slots_[slot] = value;
+		usedSlots_.push_back(static_cast<std::uint32_t>(slot));
+	}
+
+	void rehash(std::size_t capacity) {
+		slots_.assign(capacity, 0);
+		usedSlots_.clear();
+		for (std::size_t i = 0; i < entries_.size(); ++i) {
+			insertSlot(entries_[i].fiber, static_cast<std::uint32_t>(i + 1));
+		}
+	}
+
+	std::vector<std::uint32_t> slots_{};
+	std::vector<std::uint32_t> usedSlots_{};
+	std::vector<Entry> entries_{};
+	std::vector<std::uint32_t> order_{};
+};
+
+using FiberLaneGroupTable = FiberKeyedTable<FiberLaneGroup>;
+using PropagatedAncestorTable = FiberKeyedTable<PropagatedAncestor>;
+
+ConcurrentQueueRing gConcurrentQueueEntries;
+FiberLaneGroupTable gConcurrentLaneGroups;
+PropagatedAncestorTable gPropagatedAncestors;
+std::vector<FiberNode*> gPropagationPath;
+std::size_t gLastFlushAncestorVisits = 0;
 Lanes gConcurrentlyUpdatedLanesLocal = NoLanes;
 
 void enqueueUpdate(
@@ -30,7 +245,7 @@ void enqueueUpdate(
 	ConcurrentUpdateQueue* queue,
 	ConcurrentUpdate* update,
 	Lane lane) {
-	gConcurrentQueueEntries.push_back(ConcurrentQueueEntry{fiber, queue, update, lane});
+	gConcurrentQueueEntries.push(ConcurrentQueueEntry{fiber, queue, update, lane});
 	gConcurrentlyUpdatedLanesLocal = mergeLanes(gConcurrentlyUpdatedLanesLocal, lane);
 
 	if (fiber != nullptr) {
@@ -41,13 +256,125 @@ void enqueueUpdate(
 	}
 }
 
+bool isHiddenOffscreen(const FiberNode* fiber) {
+	if (fiber->tag != WorkTag::OffscreenComponent) {
+		return false;
+	}
+	auto* offscreenInstance = static_cast<OffscreenInstance*>(fiber->stateNode);
+	return offscreenInstance != nullptr && (offscreenInstance->_visibility & OffscreenVisible) == 0;
+}
+
+// Merges `lanes` into the source fiber and the childLanes of every ancestor,
+// returning the HostRoot fiber (or the topmost fiber when detached).
+FiberNode* propagateLanesToRoot(FiberNode* sourceFiber, Lanes lanes, bool& isHidden) {
+	sourceFiber->lanes = mergeLanes(sourceFiber->lanes, lanes);
+	if (sourceFiber->alternate) {
+		sourceFiber->alternate->lanes = mergeLanes(sourceFiber->alternate->lanes, lanes);
+	}
+
+	isHidden = false;
+	FiberNode* node = sourceFiber;
+	FiberNode* parent = node->returnFiber;
+	while (parent != nullptr) {
+		parent->childLanes = mergeLanes(parent->childLanes, lanes);
+		if (parent->alternate) {
+			parent->alternate->childLanes = mergeLanes(parent->alternate->childLanes, lanes);
+		}
+
+		if (isHiddenOffscreen(parent)) {
+			isHidden = true;
+		}
+
+		node = parent;
+		parent = parent->returnFiber;
+	}
+	return node;
+}
+
+FiberRoot* getHostRoot(FiberNode* node) {
+	if (node->tag == WorkTag::HostRoot) {
+		return static_cast<FiberRoot*>(node->stateNode);
+	}
+	return nullptr;
+}
+
+// Batched form of propagateLanesToRoot used by finishQueueingConcurrentUpdates.
+// The walk stops at the first ancestor that an earlier group in the same flush
+// already carried these lanes through, and takes the root and hidden state
+// from it, so sibling updates under a shared spine only pay for the part of
+// the path that is new to the batch.
+FiberRoot* propagateGroupLanesToRoot(
+	PropagatedAncestorTable& ancestors,
+	std::vector<FiberNode*>& path,
+	FiberNode* sourceFiber,
+	Lanes lanes,
+	bool& isHidden) {
+	sourceFiber->lanes = mergeLanes(sourceFiber->lanes, lanes);
+	if (sourceFiber->alternate) {
+		sourceFiber->alternate->lanes = mergeLanes(sourceFiber->alternate->lanes, lanes);
+	}
+
+	path.clear();
+	FiberRoot* root = nullptr;
+	bool hiddenAbove = false;
+	FiberNode* node = sourceFiber;
+	FiberNode* parent = node->returnFiber;
+	while (parent != nullptr) {
+		++gLastFlushAncestorVisits;
+		// Only an ancestor whose childLanes already hold the lanes can have
+		// been covered earlier in this flush; skip the lookup otherwise.
+		if ((parent->childLanes & lanes) == lanes) {
+			if (PropagatedAncestor* known = ancestors.find(parent)) {
+				if ((known->lanes & lanes) == lanes) {
+					root = known->root;
+					hiddenAbove = known->isHidden;
+					break;
+				}
+			}
+		}
+
+		parent->childLanes = mergeLanes(parent->childLanes, lanes);
+		if (parent->alternate) {
+			parent->alternate->childLanes = mergeLanes(parent->alternate->childLanes, lanes);
+		}
+		path.push_back(parent);
+
+		node = parent;
+		parent = parent->returnFiber;
+	}
+
+	if (parent == nullptr) {
+		root = getHostRoot(node);
+	}
+
+	// Record the new part of the path top-down so each entry knows whether a
+	// hidden Offscreen boundary sits at or above it.
+	for (auto it = path.rbegin(); it != path.rend(); ++it) {
+		hiddenAbove = hiddenAbove || isHiddenOffscreen(*it);
+		auto& ancestor = ancestors.groupFor(*it);
+		ancestor.lanes = mergeLanes(ancestor.lanes, lanes);
+		ancestor.root = root;
+		ancestor.isHidden = hiddenAbove;
+	}
+
+	isHidden = hiddenAbove;
+	return root;
+}
+
 } // namespace
 
 void finishQueueingConcurrentUpdates() {
-	const auto entryCount = gConcurrentQueueEntries.size();
-
+	auto& entries = gConcurrentQueueEntries;
+	const auto entryCount = entries.size();
+	auto& laneGroups = gConcurrentLaneGroups;
+	laneGroups.reset(entryCount);
+	gPropagatedAncestors.reset(0);
+	gLastFlushAncestorVisits = 0;
+
+	// Splice pending updates in enqueue order so each queue's circular list
+	// keeps the order the updates were dispatched in.
 	for (std::size_t i = 0; i < entryCount; ++i) {
-		const auto& entry = gConcurrentQueueEntries[i];
+		const auto& entry = entries[i];
 
 		if (entry.queue != nullptr && entry.update != nullptr) {
 			ConcurrentUpdate* pending = entry.queue->pending;
@@ -61,11 +388,41 @@ void finishQueueingConcurrentUpdates() {
 		}
 
 		if (entry.lane != NoLane && entry.fiber != nullptr) {
-			markUpdateLaneFromFiberToRoot(entry.fiber, entry.update, entry.lane);
+			auto& group = laneGroups.groupFor(entry.fiber);
+			group.lanes = mergeLanes(group.lanes, entry.lane);
+		}
+	}
+
+	// Lane marking is idempotent per fiber, so walk each updated fiber's
+	// return path once with the union of its lanes instead of once per update,
+	// and stop where an earlier group already propagated the same lanes.
+	bool hasHiddenGroup = false;
+	for (const auto groupIndex : laneGroups.addressOrder()) {
+		auto& group = laneGroups[groupIndex];
+		group.root = propagateGroupLanesToRoot(
+			gPropagatedAncestors, gPropagationPath, group.fiber, group.lanes, group.isHidden);
+		if (group.root != nullptr) {
+			markRootUpdated(*group.root, group.lanes);
+			hasHiddenGroup = hasHiddenGroup || group.isHidden;
+		}
+	}
+
+	// Updates below a hidden Offscreen boundary are tracked one by one so they
+	// can be revealed when the boundary becomes visible.
+	if (hasHiddenGroup) {
+		for (std::size_t i = 0; i < entryCount; ++i) {
+			const auto& entry = entries[i];
+			if (entry.lane == NoLane || entry.fiber == nullptr || entry.update == nullptr) {
+				continue;
+			}
+			const auto& group = laneGroups.groupFor(entry.fiber);
+			if (group.isHidden && group.root != nullptr) {
+				markHiddenUpdate(*group.root, entry.update, entry.lane);
+			}
 		}
 	}
 
-	gConcurrentQueueEntries.clear();
+	entries.consume(entryCount);
 	gConcurrentlyUpdatedLanesLocal = NoLanes;
 }
 
@@ -117,43 +474,15 @@ FiberRoot* markUpdateLaneFromFiberToRoot(
 		return nullptr;
 	}
 
-	sourceFiber->lanes = mergeLanes(sourceFiber->lanes, lane);
-	if (sourceFiber->alternate) {
-		sourceFiber->alternate->lanes = mergeLanes(sourceFiber->alternate->lanes, lane);
-	}
-
 	bool isHidden = false;
-	FiberNode* node = sourceFiber;
-	FiberNode* parent = node->returnFiber;
-	while (parent != nullptr) {
-		parent->childLanes = mergeLanes(parent->childLanes, lane);
-		if (parent->alternate) {
-			parent->alternate->childLanes = mergeLanes(parent->alternate->childLanes, lane);
+	FiberRoot* root = getHostRoot(propagateLanesToRoot(sourceFiber, lane, isHidden));
+	if (root != nullptr) {
+		markRootUpdated(*root, lane);
+		if (isHidden && update != nullptr) {
+			markHiddenUpdate(*root, update, lane);
 		}
-
-		if (parent->tag == WorkTag::OffscreenComponent) {
-			auto* offscreenInstance = static_cast<OffscreenInstance*>(parent->stateNode);
-			if (offscreenInstance != nullptr && (offscreenInstance->_visibility & OffscreenVisible) == 0) {
-				isHidden = true;
-			}
-		}
-
-		node = parent;
-	parent = parent->returnFiber;
 	}
-
-	if (node->tag == WorkTag::HostRoot) {
-		auto* root = static_cast<FiberRoot*>(node->stateNode);
-		if (root != nullptr) {
-			markRootUpdated(*root, lane);
-			if (isHidden && update != nullptr) {
-				markHiddenUpdate(*root, update, lane);
-			}
-		}
-		return root;
-	}
-
-	return nullptr;
+	return root;
 }
 
 FiberRoot* getRootForUpdatedFiber(FiberNode* sourceFiber) {
@@ -174,4 +503,24 @@ FiberRoot* getRootForUpdatedFiber(FiberNode* sourceFiber) {
 	return nullptr;
 }
 
+namespace ConcurrentUpdatesTestHelper {
+
+std::size_t getQueuedEntryCount() {
+	return gConcurrentQueueEntries.size();
+}
+
+std::size_t getQueueCapacity() {
+	return gConcurrentQueueEntries.capacity();
+}
+
+std::size_t getQueueHighWaterMark() {
+	return gConcurrentQueueEntries.highWaterMark();
+}
+
+std::size_t getLastFlushAncestorVisits() {
+	return gLastFlushAncestorVisits;
+}
+
+} // namespace ConcurrentUpdatesTestHelper
+
 } // namespace react
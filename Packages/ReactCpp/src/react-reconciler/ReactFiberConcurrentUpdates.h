@@ -4,6 +4,8 @@
 #include "ReactFiberLane.h"
 #include "ReactFiberOffscreenComponent.h"
 
+#include <cstddef>
+
 namespace react {
 
 class FiberNode;
@@ -22,4 +24,11 @@ FiberRoot* enqueueConcurrentRenderForLane(FiberNode* fiber, Lane lane);
 
 FiberRoot* unsafe_markUpdateLaneFromFiberToRoot(FiberNode* fiber, Lane lane);
 
+namespace ConcurrentUpdatesTestHelper {
+std::size_t getQueuedEntryCount();
+std::size_t getQueueCapacity();
+std::size_t getQueueHighWaterMark();
+std::size_t getLastFlushAncestorVisits();
+}
+
 } // namespace react
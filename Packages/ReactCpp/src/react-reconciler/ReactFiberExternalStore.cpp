@@ -0,0 +1,132 @@
+#include "react-reconciler/ReactFiberExternalStore.h"
+
+#include "react-reconciler/ReactFiberConcurrentUpdates.h"
+#include "react-reconciler/ReactFiberLane.h"
+#include "react-reconciler/ReactFiberWorkLoop.h"
+
+#include <algorithm>
+
+namespace react {
+
+ExternalStoreSubscriptionBase::~ExternalStoreSubscriptionBase() {
+  unsubscribe();
+}
+
+void ExternalStoreSubscriptionBase::unsubscribe() {
+  if (store_ != nullptr) {
+    store_->detach(*this);
+  }
+}
+
+ExternalStoreCore::~ExternalStoreCore() {
+  for (ExternalStoreSubscriptionBase* subscription : subscribers_) {
+    if (subscription != nullptr) {
+      subscription->store_ = nullptr;
+    }
+  }
+}
+
+void ExternalStoreCore::attach(ExternalStoreSubscriptionBase& subscription) {
+  subscription.store_ = this;
+  subscription.index_ = subscribers_.size();
+  subscribers_.push_back(&subscription);
+}
+
+void ExternalStoreCore::detach(ExternalStoreSubscriptionBase& subscription) {
+  subscription.store_ = nullptr;
+  if (notifying_) {
+    // A selector unsubscribed mid-notify; leave a hole so the indices the
+    // notify loop is walking stay valid, and compact once it finishes.
+    subscribers_[subscription.index_] = nullptr;
+    ++detachedDuringNotify_;
+    return;
+  }
+  // Swap-remove; notification order across subscribers is not observable
+  // because every changed fiber renders in the same pass.
+  const std::size_t index = subscription.index_;
+  ExternalStoreSubscriptionBase* last = subscribers_.back();
+  subscribers_[index] = last;
+  last->index_ = index;
+  subscribers_.pop_back();
+}
+
+void ExternalStoreCore::compactSubscribers() {
+  std::size_t kept = 0;
+  for (ExternalStoreSubscriptionBase* subscription : subscribers_) {
+    if (subscription != nullptr) {
+      subscription->index_ = kept;
+      subscribers_[kept++] = subscription;
+    }
+  }
+  subscribers_.resize(kept);
+  detachedDuringNotify_ = 0;
+}
+
+void ExternalStoreCore::notify(const void* snapshot) {
+  if (batchDepth_ > 0 || notifying_) {
+    // Writes made by a selector are picked up by the loop below once the
+    // current pass is done.
+    hasDeferredNotify_ = true;
+    return;
+  }
+
+  ExternalStoreNotifyStats stats{};
+  scheduledRoots_.clear();
+  notifying_ = true;
+  try {
+    // Subscriptions attached by a selector see the next write, not this one.
+    const std::size_t count = subscribers_.size();
+    for (std::size_t i = 0; i < count; ++i) {
+      ExternalStoreSubscriptionBase* subscription = subscribers_[i];
+      if (subscription == nullptr) {
+        continue;
+      }
+      ++stats.selectorRuns;
+      if (!subscription->updateSelection(snapshot)) {
+        ++stats.bailouts;
+        continue;
+      }
+      FiberNode& fiber = *subscription->fiber_;
+      FiberRoot* root = enqueueConcurrentRenderForLane(&fiber, SyncLane);
+      ++stats.scheduledFibers;
+      if (root != nullptr &&
+          std::find_if(scheduledRoots_.begin(), scheduledRoots_.end(), [&](const auto& scheduled) {
+            return scheduled.first == root;
+          }) == scheduledRoots_.end()) {
+        scheduledRoots_.emplace_back(root, &fiber);
+      }
+    }
+  } catch (...) {
+    notifying_ = false;
+    hasDeferredNotify_ = false;
+    compactSubscribers();
+    throw;
+  }
+  notifying_ = false;
+  if (detachedDuringNotify_ > 0) {
+    compactSubscribers();
+  }
+
+  // The queued updates are flushed into the fibers by the render each root
+  // schedules.
+  for (const auto& [root, fiber] : scheduledRoots_) {
+    scheduleUpdateOnFiber(runtime_, *root, *fiber, SyncLane);
+  }
+  stats.scheduledRoots = scheduledRoots_.size();
+  lastNotifyStats_ = stats;
+
+  if (hasDeferredNotify_ && batchDepth_ == 0) {
+    hasDeferredNotify_ = false;
+    notify(snapshot);
+  }
+}
+
+void ExternalStoreCore::endBatch(const void* snapshot) {
+  if (--batchDepth_ > 0 || !hasDeferredNotify_) {
+    return;
+  }
+  hasDeferredNotify_ = false;
+  notify(snapshot);
+}
+
+} // namespace react
@@ -0,0 +1,183 @@
+#pragma once
+
+// External C++ stores for useSyncExternalStore-style subscriptions.
+//
+// Every write notifies all subscriptions of a store as one batch: each
+// subscription re-runs its selector against the new snapshot and compares the
+// result with operator==. Unchanged selections bail out before any fiber is
+// touched; changed ones are queued on SyncLane and each affected root is
+// scheduled once, so the batch renders in a single sync pass per root.
+//
+// Subscriptions are owned by the caller and unsubscribe when destroyed. They
+// stand in for the subscribe/unsubscribe effect useSyncExternalStore installs,
+// which this tree has no passive effect phase for yet.
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace react {
+
+class FiberNode;
+class ReactRuntime;
+struct FiberRoot;
+class ExternalStoreCore;
+
+struct ExternalStoreNotifyStats {
+  std::size_t selectorRuns{0};
+  std::size_t bailouts{0};
+  std::size_t scheduledFibers{0};
+  std::size_t scheduledRoots{0};
+};
+
+class ExternalStoreSubscriptionBase {
+public:
+  ExternalStoreSubscriptionBase(const ExternalStoreSubscriptionBase&) = delete;
+  ExternalStoreSubscriptionBase& operator=(const ExternalStoreSubscriptionBase&) = delete;
+  virtual ~ExternalStoreSubscriptionBase();
+
+  [[nodiscard]] FiberNode* getFiber() const {
+    return fiber_;
+  }
+  [[nodiscard]] bool isSubscribed() const {
+    return store_ != nullptr;
+  }
+  void unsubscribe();
+
+protected:
+  explicit ExternalStoreSubscriptionBase(FiberNode& fiber) : fiber_(&fiber) {}
+
+  // Re-runs the selector over `snapshot`; returns true when the selection
+  // differs from the one last delivered and stores the new one.
+  virtual bool updateSelection(const void* snapshot) = 0;
+
+private:
+  friend class ExternalStoreCore;
+
+  ExternalStoreCore* store_{nullptr};
+  FiberNode* fiber_{nullptr};
+  std::size_t index_{0};
+};
+
+class ExternalStoreCore {
+public:
+  explicit ExternalStoreCore(ReactRuntime& runtime) : runtime_(runtime) {}
+  ExternalStoreCore(const ExternalStoreCore&) = delete;
+  ExternalStoreCore& operator=(const ExternalStoreCore&) = delete;
+  ~ExternalStoreCore();
+
+  [[nodiscard]] std::size_t getSubscriberCount() const {
+    return subscribers_.size() - detachedDuringNotify_;
+  }
+  [[nodiscard]] const ExternalStoreNotifyStats& getLastNotifyStats() const {
+    return lastNotifyStats_;
+  }
+
+protected:
+  void attach(ExternalStoreSubscriptionBase& subscription);
+  // Notifies every subscription about `snapshot`, or defers to the end of
+  // the enclosing batch.
+  void notify(const void* snapshot);
+  void beginBatch() {
+    ++batchDepth_;
+  }
+  void endBatch(const void* snapshot);
+
+private:
+  friend class ExternalStoreSubscriptionBase;
+
+  void detach(ExternalStoreSubscriptionBase& subscription);
+  void compactSubscribers();
+
+  ReactRuntime& runtime_;
+  // Null entries are subscriptions detached while notify walks the list.
+  std::vector<ExternalStoreSubscriptionBase*> subscribers_{};
+  // Each root with a changed selection, and the first fiber scheduled on it.
+  std::vector<std::pair<FiberRoot*, FiberNode*>> scheduledRoots_{};
+  ExternalStoreNotifyStats lastNotifyStats_{};
+  std::size_t batchDepth_{0};
+  std::size_t detachedDuringNotify_{0};
+  bool hasDeferredNotify_{false};
+  bool notifying_{false};
+};
+
+template <typename State, typename Selector>
+class ExternalStoreSubscription final : public ExternalStoreSubscriptionBase {
+public:
+  using Selection = std::decay_t<std::invoke_result_t<const Selector&, const State&>>;
+
+  ExternalStoreSubscription(FiberNode& fiber, Selector selector, const State& snapshot)
+      : ExternalStoreSubscriptionBase(fiber),
+        selector_(std::move(selector)),
+        selection_(selector_(snapshot)) {}
+
+  [[nodiscard]] const Selection& getSelection() const {
+    return selection_;
+  }
+
+protected:
+  bool updateSelection(const void* snapshot) override {
+    Selection next = selector_(*static_cast<const State*>(snapshot));
+    if (next == selection_) {
+      return false;
+    }
+    selection_ = std::move(next);
+    return true;
+  }
+
+private:
+  Selector selector_;
+  Selection selection_;
+};
+
+template <typename State>
+class ExternalStore : public ExternalStoreCore {
+public:
+  ExternalStore(ReactRuntime& runtime, State initialState)
+      : ExternalStoreCore(runtime), state_(std::move(initialState)) {}
+
+  [[nodiscard]] const State& getSnapshot() const {
+    return state_;
+  }
+
+  void setState(State nextState) {
+    state_ = std::move(nextState);
+    notify(&state_);
+  }
+
+  template <typename Mutation>
+  void update(Mutation&& mutation) {
+    std::forward<Mutation>(mutation)(state_);
+    notify(&state_);
+  }
+
+  // Coalesces the notifications of every write made by `writes` into one.
+  template <typename Writes>
+  void batch(Writes&& writes) {
+    beginBatch();
+    try {
+      std::forward<Writes>(writes)();
+    } catch (...) {
+      endBatch(&state_);
+      throw;
+    }
+    endBatch(&state_);
+  }
+
+  template <typename Selector>
+  [[nodiscard]] std::unique_ptr<ExternalStoreSubscription<State, std::decay_t<Selector>>> subscribe(
+      FiberNode& fiber,
+      Selector&& selector) {
+    auto subscription = std::make_unique<ExternalStoreSubscription<State, std::decay_t<Selector>>>(
+        fiber, std::forward<Selector>(selector), state_);
+    attach(*subscription);
+    return subscription;
+  }
+
+private:
+  State state_;
+};
+
+} // namespace react
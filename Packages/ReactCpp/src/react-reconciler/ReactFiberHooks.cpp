@@ -0,0 +1,188 @@
+#include "react-reconciler/ReactFiberHooks.h"
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberWorkLoop.h"
+#include "runtime/ReactRuntime.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace react {
+namespace {
+
+HookSlots* findOwnedSlots(FiberNode& workInProgress, HookSlots* currentSlots) {
+  if (HookSlots* slots = getHookSlots(workInProgress); slots != nullptr && slots->owner == &workInProgress) {
+    return slots;
+  }
+  if (currentSlots != nullptr && currentSlots->alternate != nullptr &&
+      currentSlots->alternate->owner == &workInProgress) {
+    return currentSlots->alternate;
+  }
+  return nullptr;
+}
+
+} // namespace
+
+MemoCache& prepareMemoCache(HooksState& state) {
+  HookSlots& slots = *state.workInProgressSlots;
+  const HookSlots* const currentSlots = state.currentSlots;
+  if (currentSlots == nullptr || currentSlots->memoCache == nullptr) {
+    slots.memoCache = std::make_shared<MemoCache>();
+  } else {
+    // Every render attempt shares the committed cache. The compiler writes
+    // inputs and outputs together, so an interrupted attempt leaves entries
+    // a later one can reuse.
+    slots.memoCache = currentSlots->memoCache;
+  }
+  state.memoCache = slots.memoCache.get();
+  return *state.memoCache;
+}
+
+HookSlots* getHookSlots(const FiberNode& fiber) {
+  return static_cast<HookSlots*>(fiber.memoizedState);
+}
+
+void prepareToUseHooks(
+    ReactRuntime& runtime,
+    FiberNode* current,
+    FiberNode& workInProgress,
+    Lanes renderLanes) {
+  HooksState& state = runtime.hooksState();
+  state.currentlyRenderingFiber = &workInProgress;
+  state.renderLanes = renderLanes;
+  state.hookIndex = 0;
+  state.currentSlots = current != nullptr ? getHookSlots(*current) : nullptr;
+  state.isMounting = state.currentSlots == nullptr;
+
+  if (state.currentSlots != nullptr && state.currentSlots->owner == &workInProgress) {
+    // A bailout cloned this fiber without rendering it, so the committed
+    // hooks are still in the buffer this fiber owns. Hand that buffer to the
+    // current fiber and render into the spare one.
+    state.currentSlots->owner = current;
+    if (HookSlots* spare = state.currentSlots->alternate) {
+      spare->owner = &workInProgress;
+    }
+  }
+
+  HookSlots* slots = findOwnedSlots(workInProgress, state.currentSlots);
+  if (slots == nullptr) {
+    auto* storage = current != nullptr ? static_cast<HookSlotStorage*>(current->hookStorage.get()) : nullptr;
+    if (storage != nullptr && state.currentSlots != nullptr) {
+      // Render into the buffer of the pair the current fiber is not using.
+      workInProgress.hookStorage = current->hookStorage;
+      slots = state.currentSlots == &storage->buffers[0] ? &storage->buffers[1] : &storage->buffers[0];
+    } else {
+      auto fresh = std::make_shared<HookSlotStorage>();
+      slots = &fresh->buffers[0];
+      workInProgress.hookStorage = std::move(fresh);
+    }
+    slots->owner = &workInProgress;
+    if (state.currentSlots != nullptr) {
+      slots->alternate = state.currentSlots;
+      state.currentSlots->alternate = slots;
+    }
+  }
+
+  if (state.isMounting) {
+    slots->hooks.clear();
+    slots->ownedValues.clear();
+  } else {
+    // Hooks are plain pointers, so cloning the committed state for this
+    // render is a single contiguous copy into the reused buffer.
+    slots->hooks = state.currentSlots->hooks;
+    slots->ownedValues = state.currentSlots->ownedValues;
+  }
+
+  workInProgress.memoizedState = slots;
+  state.workInProgressSlots = slots;
+}
+
+void throwTooManyHooksError() {
+  throw std::logic_error("Rendered more hooks than during the previous render.");
+}
+
+const Hook* getCurrentHook(ReactRuntime& runtime) {
+  const HooksState& state = runtime.hooksState();
+  if (state.isMounting || state.hookIndex == 0) {
+    return nullptr;
+  }
+  return &state.currentSlots->hooks[state.hookIndex - 1];
+}
+
+std::vector<const void*>& useMemoCache(ReactRuntime& runtime, std::size_t size) {
+  HooksState& state = runtime.hooksState();
+  MemoCache& memoCache = state.memoCache != nullptr ? *state.memoCache : prepareMemoCache(state);
+
+  const std::size_t index = state.memoCacheIndex++;
+  if (index == memoCache.data.size()) {
+    return memoCache.data.emplace_back(size, kMemoCacheSentinel);
+  }
+  std::vector<const void*>& data = memoCache.data[index];
+  if (data.size() != size) {
+    throw std::logic_error(
+        "Expected a constant size argument for each invocation of useMemoCache. The previous cache was "
+        "allocated with size " +
+        std::to_string(data.size()) + " but size " + std::to_string(size) + " was requested.");
+  }
+  return data;
+}
+
+bool deferValueChange(ReactRuntime& runtime) {
+  HooksState& state = runtime.hooksState();
+  if (includesOnlyNonUrgentLanes(state.renderLanes)) {
+    return false;
+  }
+  // Keep showing the previous value and finish this render quickly; the
+  // deferred lane re-renders this fiber with the new value afterwards.
+  const Lane deferredLane = requestDeferredLane(runtime);
+  state.currentlyRenderingFiber->lanes = mergeLanes(state.currentlyRenderingFiber->lanes, deferredLane);
+  markSkippedUpdateLanes(runtime, deferredLane);
+  return true;
+}
+
+std::shared_ptr<const void>& ownedHookValue(ReactRuntime& runtime) {
+  HooksState& state = runtime.hooksState();
+  auto& ownedValues = state.workInProgressSlots->ownedValues;
+  const std::size_t index = state.hookIndex - 1;
+  if (index >= ownedValues.size()) {
+    ownedValues.resize(index + 1);
+  }
+  return ownedValues[index];
+}
+
+void finishRenderingHooks(ReactRuntime& runtime) {
+  HooksState& state = runtime.hooksState();
+  if (state.memoCache == nullptr && state.workInProgressSlots != nullptr) {
+    state.workInProgressSlots->memoCache.reset();
+  }
+  const bool didRenderTooFewHooks =
+      !state.isMounting && state.hookIndex < state.currentSlots->hooks.size();
+  state = HooksState{};
+  if (didRenderTooFewHooks) {
+    throw std::logic_error(
+        "Rendered fewer hooks than expected. This may be caused by an accidental early return statement.");
+  }
+}
+
+void resetHooksOnUnwind(ReactRuntime& runtime) {
+  runtime.hooksState() = HooksState{};
+}
+
+void releaseHookSlots(FiberNode& fiber) {
+  HookSlots* slots = getHookSlots(fiber);
+  if (slots == nullptr) {
+    return;
+  }
+
+  if (FiberNode* const other = fiber.alternate) {
+    if (other->memoizedState == slots || other->memoizedState == slots->alternate) {
+      other->memoizedState = nullptr;
+      other->hookStorage.reset();
+    }
+  }
+  fiber.memoizedState = nullptr;
+  fiber.hookStorage.reset();
+}
+
+} // namespace react
@@ -0,0 +1,158 @@
+#pragma once
+
+// Port of the hook bookkeeping in react-main/packages/react-reconciler/src/ReactFiberHooks.js.
+// A function component's memoizedState points at a HookSlots array instead of
+// the head of a linked list of Hook objects: mount appends slots, update walks
+// them by index, and preparing a work-in-progress render copies the current
+// array into the fiber's alternate buffer in one step.
+
+#include "react-reconciler/ReactFiberHooksState.h"
+#include "react-reconciler/ReactFiberLane.h"
+#include "runtime/ReactRuntime.h"
+#include "shared/ReactSymbols.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace react {
+
+class FiberNode;
+
+struct Hook {
+  void* memoizedState{nullptr};
+  void* baseState{nullptr};
+  void* baseQueue{nullptr};
+  void* queue{nullptr};
+};
+
+// Cache blocks handed out by useMemoCache, one per call in render order.
+// Every slot starts out as kMemoCacheSentinel.
+struct MemoCache {
+  std::vector<std::vector<const void*>> data{};
+};
+
+// Hook state for one fiber. The current and work-in-progress fibers of a
+// component each own one array; `alternate` links the pair so a new render
+// reuses the other buffer instead of allocating.
+struct HookSlots {
+  FiberNode* owner{nullptr};
+  HookSlots* alternate{nullptr};
+  std::vector<Hook> hooks{};
+  // Values a hook owns rather than points at, indexed like `hooks`. Empty
+  // until a hook such as useDeferredValue stores one.
+  std::vector<std::shared_ptr<const void>> ownedValues{};
+  // Both buffers point at the same cache once the component has rendered;
+  // it is never copied between them.
+  std::shared_ptr<MemoCache> memoCache{};
+};
+
+// The two slot buffers of a component. The current and work-in-progress
+// fibers share it through FiberNode::hookStorage, so it is freed with the
+// last of them.
+struct HookSlotStorage {
+  HookSlots buffers[2];
+};
+
+inline const void* const kMemoCacheSentinel = &REACT_MEMO_CACHE_SENTINEL;
+
+[[nodiscard]] HookSlots* getHookSlots(const FiberNode& fiber);
+
+// Gives the rendering buffer its memo cache: the committed cache itself, or a
+// new one on mount. The cache is shared rather than cloned regardless of
+// enableNoCloningMemoCache, which only mirrors the upstream flag.
+MemoCache& prepareMemoCache(HooksState& state);
+
+void prepareToUseHooks(
+    ReactRuntime& runtime,
+    FiberNode* current,
+    FiberNode& workInProgress,
+    Lanes renderLanes);
+
+[[noreturn]] void throwTooManyHooksError();
+
+// Returns the next slot of the rendering fiber. The reference stays valid
+// until the next call on the mount path, which may grow the array.
+inline Hook& mountWorkInProgressHook(ReactRuntime& runtime) {
+  HooksState& state = runtime.hooksState();
+  ++state.hookIndex;
+  return state.workInProgressSlots->hooks.emplace_back();
+}
+
+inline Hook& updateWorkInProgressHook(ReactRuntime& runtime) {
+  HooksState& state = runtime.hooksState();
+  auto& hooks = state.workInProgressSlots->hooks;
+  if (state.hookIndex >= hooks.size()) {
+    throwTooManyHooksError();
+  }
+  return hooks[state.hookIndex++];
+}
+
+inline Hook& nextWorkInProgressHook(ReactRuntime& runtime) {
+  return runtime.hooksState().isMounting ? mountWorkInProgressHook(runtime)
+                                         : updateWorkInProgressHook(runtime);
+}
+
+// The committed slot matching the hook returned by the last
+// updateWorkInProgressHook call, or nullptr while mounting.
+[[nodiscard]] const Hook* getCurrentHook(ReactRuntime& runtime);
+
+// Returns the next fixed-size cache block of the rendering fiber. Compiled
+// components store their inputs and derived values in it and skip the
+// computation while the inputs are unchanged.
+std::vector<const void*>& useMemoCache(ReactRuntime& runtime, std::size_t size);
+
+// Called by useDeferredValue when the value changed. In an urgent render it
+// spawns the deferred lane the fiber re-renders on and returns true; on
+// non-urgent lanes it returns false and the new value is used.
+bool deferValueChange(ReactRuntime& runtime);
+
+// Storage for a value owned by the hook returned last.
+std::shared_ptr<const void>& ownedHookValue(ReactRuntime& runtime);
+
+// Returns `value` in renders on non-urgent lanes. An urgent render whose
+// value differs from the previous one (compared with ==) keeps returning the
+// previous value and spawns a deferred lane on which the fiber re-renders
+// with the new one. The hook keeps its own copy, so an unchanged value keeps
+// its address; the reference is valid until the component renders again.
+template <typename T>
+const T& useDeferredValue(ReactRuntime& runtime, const T& value) {
+  Hook& hook = nextWorkInProgressHook(runtime);
+  const auto* previous = static_cast<const T*>(hook.memoizedState);
+  if (previous != nullptr && (*previous == value || deferValueChange(runtime))) {
+    return *previous;
+  }
+  std::shared_ptr<const void>& owned = ownedHookValue(runtime);
+  owned = std::make_shared<const T>(value);
+  hook.memoizedState = const_cast<void*>(owned.get());
+  return *static_cast<const T*>(owned.get());
+}
+
+void finishRenderingHooks(ReactRuntime& runtime);
+void resetHooksOnUnwind(ReactRuntime& runtime);
+
+// Detaches both slot buffers from a component's fibers, freeing them ahead of
+// the fibers themselves.
+void releaseHookSlots(FiberNode& fiber);
+
+template <typename Component, typename Props>
+auto renderWithHooks(
+    ReactRuntime& runtime,
+    FiberNode* current,
+    FiberNode& workInProgress,
+    Component&& component,
+    Props&& props,
+    Lanes renderLanes) {
+  prepareToUseHooks(runtime, current, workInProgress, renderLanes);
+  try {
+    auto children = std::forward<Component>(component)(std::forward<Props>(props));
+    finishRenderingHooks(runtime);
+    return children;
+  } catch (...) {
+    resetHooksOnUnwind(runtime);
+    throw;
+  }
+}
+
+} // namespace react
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "react-reconciler/ReactFiberLane.h"
+
+#include <cstddef>
+
+namespace react {
+
+class FiberNode;
+struct HookSlots;
+struct MemoCache;
+
+// Per-runtime cursor for the component currently rendering with hooks.
+// Mirrors the module-level currentlyRenderingFiber / currentHook /
+// workInProgressHook variables of ReactFiberHooks.js, with the linked hook
+// pointers replaced by an index into the fiber's contiguous slot arrays.
+struct HooksState {
+  FiberNode* currentlyRenderingFiber{nullptr};
+  HookSlots* currentSlots{nullptr};
+  HookSlots* workInProgressSlots{nullptr};
+  std::size_t hookIndex{0};
+  // Memo cache of the rendering fiber, prepared by its first useMemoCache
+  // call, and the index of the next cache block.
+  MemoCache* memoCache{nullptr};
+  std::size_t memoCacheIndex{0};
+  Lanes renderLanes{NoLanes};
+  bool isMounting{false};
+};
+
+} // namespace react
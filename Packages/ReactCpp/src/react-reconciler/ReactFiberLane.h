@@ -4,6 +4,7 @@
 // Source: react-main/packages/react-reconciler/src/ReactFiberLane.js
 
 #include "shared/ReactFeatureFlags.h"
+#include "react-reconciler/ReactFiberRootArena.h"
 #include "react-reconciler/ReactRootTags.h"
 #include "scheduler/Scheduler.h"
 #include "scheduler/Scheduler.h"
@@ -569,6 +570,12 @@ struct FiberRoot {
 	std::unordered_map<const Wakeable*, std::unordered_set<Lanes>> pingCache{};
 	std::function<std::function<void()>()> onDefaultTransitionIndicator{};
 	std::function<void()> pendingIndicator{};
+	// Class update queues and their updates; a queue no fiber points at is
+	// freed at the next commit.
+	FiberRootArena updateQueueArena{};
+	// Suspense retry and Offscreen queues; freed once the root is idle, or
+	// one by one at commits once no fiber points at them.
+	FiberRootArena retryQueueArena{};
 };
 
 [[nodiscard]] inline int computeExpirationTime(Lane lane, int currentTime) {
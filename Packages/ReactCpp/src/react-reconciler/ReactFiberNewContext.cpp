@@ -0,0 +1,259 @@
+#include "react-reconciler/ReactFiberNewContext.h"
+
+#include "react-reconciler/ReactFiberFlags.h"
+#include "react-reconciler/ReactFiberStack.h"
+#include "react-reconciler/ReactWorkTags.h"
+#include "runtime/ReactRuntime.h"
+
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace react {
+namespace {
+
+// Backing store for one fiber's dependency list. A deque keeps node addresses
+// stable while readContext appends.
+struct ContextDependencyStorage {
+  std::deque<ContextDependency> items{};
+};
+
+void propagateContextChanges(
+    FiberNode& workInProgress,
+    const std::vector<const ReactContext*>& contexts,
+    Lanes renderLanes,
+    bool forcePropagateEntireTree) {
+  FiberNode* fiber = workInProgress.child;
+  if (fiber != nullptr) {
+    fiber->returnFiber = &workInProgress;
+  }
+  while (fiber != nullptr) {
+    FiberNode* nextFiber = nullptr;
+    if (const FiberNode::Dependencies* list = fiber->dependencies.get()) {
+      nextFiber = fiber->child;
+      for (auto* dependency = static_cast<const ContextDependency*>(list->firstContext); dependency != nullptr;
+           dependency = dependency->next) {
+        bool matched = false;
+        for (const ReactContext* context : contexts) {
+          if (dependency->context == context) {
+            matched = true;
+            break;
+          }
+        }
+        if (!matched) {
+          continue;
+        }
+
+        FiberNode& consumer = *fiber;
+        consumer.lanes = mergeLanes(consumer.lanes, renderLanes);
+        if (FiberNode* alternate = consumer.alternate) {
+          alternate->lanes = mergeLanes(alternate->lanes, renderLanes);
+        }
+        scheduleContextWorkOnParentPath(consumer.returnFiber, renderLanes, workInProgress);
+        if (!forcePropagateEntireTree) {
+          // The consumer will render and propagate to its own children
+          // lazily; keep searching its siblings only.
+          nextFiber = nullptr;
+        }
+        break;
+      }
+    } else if (fiber->tag == WorkTag::DehydratedFragment) {
+      FiberNode* parentSuspense = fiber->returnFiber;
+      if (parentSuspense == nullptr) {
+        throw std::logic_error(
+            "We just came from a parent so we must have had a parent. This is a bug in React.");
+      }
+      parentSuspense->lanes = mergeLanes(parentSuspense->lanes, renderLanes);
+      if (FiberNode* alternate = parentSuspense->alternate) {
+        alternate->lanes = mergeLanes(alternate->lanes, renderLanes);
+      }
+      scheduleContextWorkOnParentPath(parentSuspense, renderLanes, workInProgress);
+      nextFiber = nullptr;
+    } else {
+      nextFiber = fiber->child;
+    }
+
+    if (nextFiber != nullptr) {
+      nextFiber->returnFiber = fiber;
+    } else {
+      nextFiber = fiber;
+      while (nextFiber != nullptr) {
+        if (nextFiber == &workInProgress) {
+          nextFiber = nullptr;
+          break;
+        }
+        FiberNode* sibling = nextFiber->sibling;
+        if (sibling != nullptr) {
+          sibling->returnFiber = nextFiber->returnFiber;
+          nextFiber = sibling;
+          break;
+        }
+        nextFiber = nextFiber->returnFiber;
+      }
+    }
+    fiber = nextFiber;
+  }
+}
+
+void propagateParentContextChanges(
+    FiberNode& /*current*/,
+    FiberNode& workInProgress,
+    Lanes renderLanes,
+    bool forcePropagateEntireTree) {
+  std::vector<const ReactContext*> contexts;
+  bool isInsidePropagationBailout = false;
+  for (FiberNode* parent = &workInProgress; parent != nullptr; parent = parent->returnFiber) {
+    if (!isInsidePropagationBailout) {
+      if ((parent->flags & NeedsPropagation) != NoFlags) {
+        isInsidePropagationBailout = true;
+      } else if ((parent->flags & DidPropagateContext) != NoFlags) {
+        break;
+      }
+    }
+
+    if (parent->tag == WorkTag::ContextProvider) {
+      const FiberNode* currentParent = parent->alternate;
+      if (currentParent == nullptr) {
+        throw std::logic_error("Should have a current fiber. This is a bug in React.");
+      }
+      const auto* oldProps = static_cast<const ReactContextProviderProps*>(currentParent->memoizedProps);
+      if (oldProps != nullptr) {
+        const auto* newProps = static_cast<const ReactContextProviderProps*>(parent->pendingProps);
+        const void* newValue = newProps != nullptr ? newProps->value : nullptr;
+        if (newValue != oldProps->value) {
+          contexts.push_back(static_cast<const ReactContext*>(parent->type));
+        }
+      }
+    }
+  }
+
+  if (!contexts.empty()) {
+    propagateContextChanges(workInProgress, contexts, renderLanes, forcePropagateEntireTree);
+  }
+
+  // Only propagate once per subtree: siblings that bail out after this one
+  // stop their upward search here. NeedsPropagation on a consumer overrides
+  // the marker for the deferred tree below it.
+  workInProgress.flags |= DidPropagateContext;
+}
+
+const void* readContextForConsumer(ReactRuntime& runtime, FiberNode* consumer, const ReactContext& context) {
+  NewContextState& state = runtime.newContextState();
+  const void* value = context.currentValue;
+
+  if (state.lastContextDependency == nullptr) {
+    if (consumer == nullptr) {
+      throw std::logic_error(
+          "Context can only be read while React is rendering. In classes, you can read it in the render "
+          "method or getDerivedStateFromProps. In function components, you can read it directly in the "
+          "function body, but not inside Hooks like useReducer() or useMemo().");
+    }
+    // First dependency for this render: start a new list rather than
+    // mutating the one the current fiber may still share.
+    auto storage = std::make_shared<ContextDependencyStorage>();
+    ContextDependency& item = storage->items.emplace_back(ContextDependency{&context, value, nullptr});
+    consumer->dependencies = std::make_unique<FiberNode::Dependencies>();
+    consumer->dependencies->firstContext = &item;
+    consumer->dependencies->contextStorage = std::move(storage);
+    consumer->flags |= NeedsPropagation;
+    state.lastContextDependency = &item;
+  } else {
+    auto* storage = static_cast<ContextDependencyStorage*>(consumer->dependencies->contextStorage.get());
+    ContextDependency& item = storage->items.emplace_back(ContextDependency{&context, value, nullptr});
+    state.lastContextDependency->next = &item;
+    state.lastContextDependency = &item;
+  }
+  return value;
+}
+
+} // namespace
+
+void resetContextDependencies(ReactRuntime& runtime) {
+  NewContextState& state = runtime.newContextState();
+  state.currentlyRenderingFiber = nullptr;
+  state.lastContextDependency = nullptr;
+}
+
+void pushProvider(ReactRuntime& runtime, FiberNode& providerFiber, ReactContext& context, const void* nextValue) {
+  push(runtime.newContextState().valueCursor, context.currentValue, &providerFiber);
+  context.currentValue = nextValue;
+}
+
+void popProvider(ReactRuntime& runtime, ReactContext& context, FiberNode& providerFiber) {
+  StackCursor<const void*>& valueCursor = runtime.newContextState().valueCursor;
+  context.currentValue = valueCursor.current;
+  pop(valueCursor, &providerFiber);
+}
+
+void scheduleContextWorkOnParentPath(FiberNode* parent, Lanes renderLanes, FiberNode& propagationRoot) {
+  for (FiberNode* node = parent; node != nullptr; node = node->returnFiber) {
+    FiberNode* alternate = node->alternate;
+    if (!isSubsetOfLanes(node->childLanes, renderLanes)) {
+      node->childLanes = mergeLanes(node->childLanes, renderLanes);
+      if (alternate != nullptr) {
+        alternate->childLanes = mergeLanes(alternate->childLanes, renderLanes);
+      }
+    } else if (alternate != nullptr && !isSubsetOfLanes(alternate->childLanes, renderLanes)) {
+      alternate->childLanes = mergeLanes(alternate->childLanes, renderLanes);
+    }
+    if (node == &propagationRoot) {
+      break;
+    }
+  }
+}
+
+void propagateContextChange(FiberNode& workInProgress, const ReactContext& context, Lanes renderLanes) {
+  propagateContextChanges(workInProgress, {&context}, renderLanes, true);
+}
+
+void lazilyPropagateParentContextChanges(FiberNode& current, FiberNode& workInProgress, Lanes renderLanes) {
+  propagateParentContextChanges(current, workInProgress, renderLanes, false);
+}
+
+void propagateParentContextChangesToDeferredTree(
+    FiberNode& current,
+    FiberNode& workInProgress,
+    Lanes renderLanes) {
+  propagateParentContextChanges(current, workInProgress, renderLanes, true);
+}
+
+bool checkIfContextChanged(const FiberNode::Dependencies& currentDependencies) {
+  for (auto* dependency = static_cast<const ContextDependency*>(currentDependencies.firstContext);
+       dependency != nullptr;
+       dependency = dependency->next) {
+    if (dependency->context->currentValue != dependency->memoizedValue) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void prepareToReadContext(ReactRuntime& runtime, FiberNode& workInProgress, Lanes /*renderLanes*/) {
+  NewContextState& state = runtime.newContextState();
+  state.currentlyRenderingFiber = &workInProgress;
+  state.lastContextDependency = nullptr;
+  if (FiberNode::Dependencies* dependencies = workInProgress.dependencies.get()) {
+    // Reset the work-in-progress list; the current fiber keeps its own
+    // reference to the old storage.
+    dependencies->firstContext = nullptr;
+    dependencies->contextStorage.reset();
+  }
+}
+
+const void* readContext(ReactRuntime& runtime, const ReactContext& context) {
+  return readContextForConsumer(runtime, runtime.newContextState().currentlyRenderingFiber, context);
+}
+
+const void* readContextDuringReconciliation(
+    ReactRuntime& runtime,
+    FiberNode& consumer,
+    const ReactContext& context,
+    Lanes renderLanes) {
+  if (runtime.newContextState().currentlyRenderingFiber == nullptr) {
+    prepareToReadContext(runtime, consumer, renderLanes);
+  }
+  return readContextForConsumer(runtime, &consumer, context);
+}
+
+} // namespace react
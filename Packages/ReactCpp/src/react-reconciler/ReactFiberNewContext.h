@@ -0,0 +1,61 @@
+#pragma once
+
+// Port of react-main/packages/react-reconciler/src/ReactFiberNewContext.js.
+// Context changes are propagated lazily: a provider whose value changed does
+// not walk its subtree. Instead, a fiber that is about to bail out calls
+// lazilyPropagateParentContextChanges, which looks up the return path for
+// changed providers and only then searches that fiber's subtree, stopping at
+// the first consumer on each path since consumers re-render and continue the
+// propagation themselves. propagateContextChange keeps the eager full-subtree
+// walk for callers that need it.
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberLane.h"
+
+namespace react {
+
+class ReactRuntime;
+
+// Context values are compared by identity, the analogue of Object.is on
+// JavaScript values.
+struct ReactContext {
+  const void* currentValue{nullptr};
+};
+
+// pendingProps / memoizedProps of a ContextProvider fiber, whose `type` is the
+// ReactContext it provides.
+struct ReactContextProviderProps {
+  const void* value{nullptr};
+};
+
+struct ContextDependency {
+  const ReactContext* context{nullptr};
+  const void* memoizedValue{nullptr};
+  ContextDependency* next{nullptr};
+};
+
+void resetContextDependencies(ReactRuntime& runtime);
+
+void pushProvider(ReactRuntime& runtime, FiberNode& providerFiber, ReactContext& context, const void* nextValue);
+void popProvider(ReactRuntime& runtime, ReactContext& context, FiberNode& providerFiber);
+
+void scheduleContextWorkOnParentPath(FiberNode* parent, Lanes renderLanes, FiberNode& propagationRoot);
+
+void propagateContextChange(FiberNode& workInProgress, const ReactContext& context, Lanes renderLanes);
+void lazilyPropagateParentContextChanges(FiberNode& current, FiberNode& workInProgress, Lanes renderLanes);
+void propagateParentContextChangesToDeferredTree(
+    FiberNode& current,
+    FiberNode& workInProgress,
+    Lanes renderLanes);
+
+[[nodiscard]] bool checkIfContextChanged(const FiberNode::Dependencies& currentDependencies);
+
+void prepareToReadContext(ReactRuntime& runtime, FiberNode& workInProgress, Lanes renderLanes);
+const void* readContext(ReactRuntime& runtime, const ReactContext& context);
+const void* readContextDuringReconciliation(
+    ReactRuntime& runtime,
+    FiberNode& consumer,
+    const ReactContext& context,
+    Lanes renderLanes);
+
+} // namespace react
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "react-reconciler/ReactFiberStack.h"
+
+namespace react {
+
+class FiberNode;
+struct ContextDependency;
+
+// Per-runtime cursors for the fiber whose context reads are being recorded
+// and for the provider values being rendered. Mirrors the module-level
+// currentlyRenderingFiber / lastContextDependency / valueCursor variables of
+// ReactFiberNewContext.js.
+struct NewContextState {
+  FiberNode* currentlyRenderingFiber{nullptr};
+  ContextDependency* lastContextDependency{nullptr};
+  StackCursor<const void*> valueCursor = createCursor<const void*>(nullptr);
+};
+
+} // namespace react
@@ -7,7 +7,6 @@
 #include "react-reconciler/ReactFiberSuspenseComponent.h"
 
 #include <cstdint>
-#include <memory>
 #include <vector>
 
 namespace react {
@@ -21,10 +20,11 @@ struct OffscreenInstance {
 	OffscreenVisibility _visibility{OffscreenVisible};
 };
 
+// Allocated from FiberRoot::retryQueueArena together with its retry queue.
 struct OffscreenQueue {
 	std::vector<const Transition*> transitions{};
 	std::vector<void*> markerInstances{};
-	std::unique_ptr<RetryQueue> retryQueue{};
+	RetryQueue* retryQueue{nullptr};
 };
 
 } // namespace react
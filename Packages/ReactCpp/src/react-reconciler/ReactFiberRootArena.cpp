@@ -0,0 +1,248 @@
+#include "react-reconciler/ReactFiberRootArena.h"
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberLane.h"
+
+#include <algorithm>
+
+namespace react {
+namespace {
+
+constexpr std::size_t kInitialChunkSize = 4 * 1024;
+constexpr std::size_t kMaxChunkSize = 64 * 1024;
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+FiberRootArena::FiberRootArena(FiberRootArena&& other) noexcept
+	: chunks_(std::move(other.chunks_)),
+		chunkIndex_(other.chunkIndex_),
+		chunkOffset_(other.chunkOffset_),
+		records_(std::move(other.records_)),
+		owners_(std::move(other.owners_)),
+		freeLists_(std::move(other.freeLists_)) {
+	for (const auto& [fiber, object] : owners_) {
+		const_cast<FiberNode*>(fiber)->queueOwnerArena = this;
+	}
+	other.chunks_.clear();
+	other.records_.clear();
+	other.rewind();
+}
+
+FiberRootArena& FiberRootArena::operator=(FiberRootArena&& other) noexcept {
+	if (this != &other) {
+		reset();
+		chunks_ = std::move(other.chunks_);
+		chunkIndex_ = other.chunkIndex_;
+		chunkOffset_ = other.chunkOffset_;
+		records_ = std::move(other.records_);
+		owners_ = std::move(other.owners_);
+		freeLists_ = std::move(other.freeLists_);
+		for (const auto& [fiber, object] : owners_) {
+			const_cast<FiberNode*>(fiber)->queueOwnerArena = this;
+		}
+		other.chunks_.clear();
+		other.records_.clear();
+		other.rewind();
+	}
+	return *this;
+}
+
+void FiberRootArena::registerOwner(FiberNode& fiber, void* object) {
+	fiber.updateQueue = object;
+	if (fiber.queueOwnerArena != nullptr && fiber.queueOwnerArena != this) {
+		// A fiber is tracked by one arena at a time; the other one's objects
+		// are now only reachable through the alternate, if at all.
+		fiber.queueOwnerArena->forgetOwner(fiber);
+	}
+	fiber.queueOwnerArena = this;
+	records_.at(object).owner = &fiber;
+	owners_.emplace(&fiber, object);
+}
+
+void FiberRootArena::adopt(const void* parent, const void* child) {
+	const auto parentIt = records_.find(const_cast<void*>(parent));
+	const auto childIt = records_.find(const_cast<void*>(child));
+	if (parentIt == records_.end() || childIt == records_.end()) {
+		return;
+	}
+	childIt->second.nextSibling = parentIt->second.firstChild;
+	parentIt->second.firstChild = const_cast<void*>(child);
+}
+
+void FiberRootArena::forgetOwner(const FiberNode& fiber) {
+	const auto range = owners_.equal_range(&fiber);
+	if (range.first == range.second) {
+		return;
+	}
+	std::vector<void*> objects;
+	for (auto it = range.first; it != range.second; ++it) {
+		objects.push_back(it->second);
+	}
+	owners_.erase(range.first, range.second);
+
+	FiberNode* const alternate = fiber.alternate;
+	for (void* object : objects) {
+		Record& record = records_.at(object);
+		if (alternate != nullptr && alternate->alternate == &fiber && alternate->updateQueue == object) {
+			record.owner = alternate;
+			alternate->queueOwnerArena = this;
+			owners_.emplace(alternate, object);
+		} else {
+			record.owner = nullptr;
+			release(object);
+		}
+	}
+}
+
+std::size_t FiberRootArena::collectUnreachable() {
+	std::vector<void*> unreachable;
+	for (const auto& [fiber, object] : owners_) {
+		const FiberNode* const alternate = fiber->alternate;
+		if (fiber->updateQueue != object && (alternate == nullptr || alternate->updateQueue != object)) {
+			unreachable.push_back(object);
+		}
+	}
+
+	const std::size_t liveBefore = records_.size();
+	for (void* object : unreachable) {
+		FiberNode* const owner = records_.at(object).owner;
+		const auto range = owners_.equal_range(owner);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second == object) {
+				owners_.erase(it);
+				break;
+			}
+		}
+		if (owner->queueOwnerArena == this && owners_.count(owner) == 0) {
+			owner->queueOwnerArena = nullptr;
+		}
+		release(object);
+	}
+	return liveBefore - records_.size();
+}
+
+void FiberRootArena::release(void* object) {
+	const auto it = records_.find(object);
+	const Record record = it->second;
+	records_.erase(it);
+
+	for (void* child = record.firstChild; child != nullptr;) {
+		void* const next = records_.at(child).nextSibling;
+		release(child);
+		child = next;
+	}
+	if (record.destroy != nullptr) {
+		record.destroy(object);
+	}
+
+	for (FreeList& list : freeLists_) {
+		if (list.size == record.size && list.alignment == record.alignment) {
+			*static_cast<void**>(object) = list.head;
+			list.head = object;
+			return;
+		}
+	}
+	*static_cast<void**>(object) = nullptr;
+	freeLists_.push_back(FreeList{record.size, record.alignment, object});
+}
+
+void* FiberRootArena::allocate(std::size_t size, std::size_t alignment) {
+	for (FreeList& list : freeLists_) {
+		if (list.size == size && list.alignment == alignment && list.head != nullptr) {
+			void* const block = list.head;
+			list.head = *static_cast<void**>(block);
+			return block;
+		}
+	}
+
+	// Released blocks hold the free-list link.
+	size = std::max(size, sizeof(void*));
+	alignment = std::max(alignment, alignof(void*));
+	while (chunkIndex_ < chunks_.size()) {
+		Chunk& chunk = chunks_[chunkIndex_];
+		const std::size_t offset = alignUp(chunkOffset_, alignment);
+		if (offset + size <= chunk.size) {
+			chunkOffset_ = offset + size;
+			return chunk.data.get() + offset;
+		}
+		++chunkIndex_;
+		chunkOffset_ = 0;
+	}
+
+	const std::size_t previousSize = chunks_.empty() ? 0 : chunks_.back().size;
+	std::size_t chunkSize = std::min(std::max(kInitialChunkSize, previousSize * 2), kMaxChunkSize);
+	chunkSize = std::max(chunkSize, alignUp(size, alignof(std::max_align_t)));
+
+	chunks_.push_back(Chunk{std::make_unique<std::byte[]>(chunkSize), chunkSize});
+	chunkIndex_ = chunks_.size() - 1;
+	chunkOffset_ = size;
+	return chunks_.back().data.get();
+}
+
+void FiberRootArena::rewind() {
+	owners_.clear();
+	freeLists_.clear();
+	chunkIndex_ = 0;
+	chunkOffset_ = 0;
+}
+
+void FiberRootArena::reset() {
+	// Owners are live: a fiber unregisters itself when it is destroyed, and
+	// one whose alternate is destroyed drops the pointer to it.
+	for (const auto& [ownerFiber, object] : owners_) {
+		FiberNode& fiber = *const_cast<FiberNode*>(ownerFiber);
+		if (fiber.updateQueue == object) {
+			fiber.updateQueue = nullptr;
+		}
+		if (fiber.alternate != nullptr && fiber.alternate->updateQueue == object) {
+			fiber.alternate->updateQueue = nullptr;
+		}
+		if (fiber.queueOwnerArena == this) {
+			fiber.queueOwnerArena = nullptr;
+		}
+	}
+	for (const auto& [object, record] : records_) {
+		if (record.destroy != nullptr) {
+			record.destroy(object);
+		}
+	}
+	records_.clear();
+	rewind();
+}
+
+std::size_t FiberRootArena::bytesInUse() const {
+	std::size_t total = 0;
+	for (std::size_t index = 0; index < chunkIndex_ && index < chunks_.size(); ++index) {
+		total += chunks_[index].size;
+	}
+	return chunks_.empty() ? 0 : total + chunkOffset_;
+}
+
+std::size_t FiberRootArena::bytesReserved() const {
+	std::size_t total = 0;
+	for (const Chunk& chunk : chunks_) {
+		total += chunk.size;
+	}
+	return total;
+}
+
+bool releaseRootRetryQueueArenaIfIdle(FiberRoot& root) {
+	if (root.pendingLanes != NoLanes || root.retryQueueArena.liveObjectCount() == 0) {
+		return false;
+	}
+	root.retryQueueArena.reset();
+	return true;
+}
+
+void compactRootQueueArenas(FiberRoot& root) {
+	if (!releaseRootRetryQueueArenaIfIdle(root)) {
+		root.retryQueueArena.collectUnreachable();
+	}
+	root.updateQueueArena.collectUnreachable();
+}
+
+} // namespace react
@@ -0,0 +1,139 @@
+#pragma once
+
+// Root-owned allocator for update queues. FiberRoot keeps two: class update
+// queues and their updates, which carry committed state from render to
+// render; and Suspense retry and Offscreen queues, which are render
+// bookkeeping and are released in bulk once the root commits with no
+// remaining work.
+//
+// Objects come from bump-allocated chunks. Queues installed on a fiber are
+// recorded with their owner, and the objects they link to are adopted by
+// them; at commit boundaries collectUnreachable() destroys the queues that
+// neither the owner nor its alternate points at any more, together with
+// what they adopted, and their blocks go on per-size free lists that later
+// allocations reuse. A root that keeps rendering stays bounded by its live
+// queues rather than by the number of renders.
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace react {
+
+struct FiberNode;
+struct FiberRoot;
+
+class FiberRootArena {
+public:
+	FiberRootArena() = default;
+	FiberRootArena(const FiberRootArena&) = delete;
+	FiberRootArena& operator=(const FiberRootArena&) = delete;
+	// Moving keeps object addresses stable: chunks are transferred, not copied.
+	FiberRootArena(FiberRootArena&& other) noexcept;
+	FiberRootArena& operator=(FiberRootArena&& other) noexcept;
+	~FiberRootArena() {
+		reset();
+	}
+
+	template <typename T, typename... Args>
+	T* create(Args&&... args) {
+		static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned arena type");
+		void* const storage = allocate(sizeof(T), alignof(T));
+		T* const object = new (storage) T(std::forward<Args>(args)...);
+		void (*destroy)(void*) = nullptr;
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			destroy = [](void* pointer) { static_cast<T*>(pointer)->~T(); };
+		}
+		records_.emplace(object, Record{destroy, sizeof(T), alignof(T)});
+		return object;
+	}
+
+	// Like create(), but also installs the object as `owner.updateQueue`.
+	// The object stays reachable while the owner or its alternate, which
+	// createWorkInProgress copies the pointer into, still points at it.
+	// reset() clears both slots. A fiber that is destroyed first hands the
+	// object to its alternate, or releases it if the alternate does not
+	// point at it.
+	template <typename T, typename... Args>
+	T* createForFiber(FiberNode& owner, Args&&... args) {
+		T* const object = create<T>(std::forward<Args>(args)...);
+		registerOwner(owner, object);
+		return object;
+	}
+
+	// Makes `child` part of `parent`: it is destroyed when `parent` is
+	// released. An object has one parent. Does nothing unless both are live
+	// objects of this arena.
+	void adopt(const void* parent, const void* child);
+
+	// Destroys the fiber-owned objects that neither their owner nor its
+	// alternate points at, and what they adopted. Returns how many objects
+	// were destroyed.
+	std::size_t collectUnreachable();
+
+	// Destroys every object and detaches the owner fibers. Chunks are kept so
+	// the next suspense-heavy render reuses them without allocating.
+	void reset();
+
+	// Called by ~FiberNode for a fiber that owns objects of this arena.
+	void forgetOwner(const FiberNode& fiber);
+
+	std::size_t liveObjectCount() const {
+		return records_.size();
+	}
+
+	std::size_t bytesInUse() const;
+	std::size_t bytesReserved() const;
+
+private:
+	struct Chunk {
+		std::unique_ptr<std::byte[]> data;
+		std::size_t size{0};
+	};
+
+	struct Record {
+		// Null for trivially destructible objects.
+		void (*destroy)(void*){nullptr};
+		std::size_t size{0};
+		std::size_t alignment{0};
+		FiberNode* owner{nullptr};
+		// Adopted objects, linked through their records' nextSibling.
+		void* firstChild{nullptr};
+		void* nextSibling{nullptr};
+	};
+
+	// Released blocks of one size and alignment, linked through their first
+	// bytes.
+	struct FreeList {
+		std::size_t size;
+		std::size_t alignment;
+		void* head;
+	};
+
+	void registerOwner(FiberNode& fiber, void* object);
+	void release(void* object);
+	void* allocate(std::size_t size, std::size_t alignment);
+	void rewind();
+
+	std::vector<Chunk> chunks_{};
+	std::size_t chunkIndex_{0};
+	std::size_t chunkOffset_{0};
+	std::unordered_map<void*, Record> records_{};
+	std::unordered_multimap<const FiberNode*, void*> owners_{};
+	std::vector<FreeList> freeLists_{};
+};
+
+// Frees the root's retry and Offscreen queues once a commit leaves no
+// pending lanes behind. Returns true if the arena was released.
+bool releaseRootRetryQueueArenaIfIdle(FiberRoot& root);
+
+// The commit-boundary cleanup of both root arenas: the retry arena is
+// released if the root is idle, and otherwise, like the class queue arena,
+// loses the queues no fiber points at any more.
+void compactRootQueueArenas(FiberRoot& root);
+
+} // namespace react
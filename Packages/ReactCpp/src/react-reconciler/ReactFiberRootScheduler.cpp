@@ -3,6 +3,7 @@
 #include "react-reconciler/ReactFiber.h"
 #include "react-reconciler/ReactFiberAsyncAction.h"
 #include "react-reconciler/ReactFiberLane.h"
+#include "react-reconciler/ReactFiberRootArena.h"
 #include "react-reconciler/ReactFiberWorkLoop.h"
 #include "runtime/ReactRuntime.h"
 #include "shared/ReactFeatureFlags.h"
@@ -300,7 +301,9 @@ bool performWorkOnRoot(ReactRuntime& runtime, FiberRoot& root, Lanes lanes) {
     case RootExitStatus::Completed: {
       FiberNode* const finishedWork = root.current != nullptr ? root.current->alternate : nullptr;
       const Lanes remainingLanes = subtractLanes(previousPendingLanes, lanes);
-      markRootFinished(root, lanes, remainingLanes, NoLane, NoLanes, NoLanes);
+      // A useDeferredValue in this render spawns the lane for its background
+      // re-render.
+      markRootFinished(root, lanes, remainingLanes, getWorkInProgressDeferredLane(runtime), NoLanes, NoLanes);
 
       if (finishedWork != nullptr) {
         commitRoot(root, *finishedWork);
@@ -311,6 +314,7 @@ bool performWorkOnRoot(ReactRuntime& runtime, FiberRoot& root, Lanes lanes) {
       }
 
       cleanupDefaultTransitionIndicatorIfNeeded(runtime, root);
+      compactRootQueueArenas(root);
       break;
     }
     case RootExitStatus::Suspended:
@@ -324,6 +328,7 @@ bool performWorkOnRoot(ReactRuntime& runtime, FiberRoot& root, Lanes lanes) {
     case RootExitStatus::FatalErrored: {
       const Lanes remainingLanes = subtractLanes(previousPendingLanes, lanes);
       markRootFinished(root, lanes, remainingLanes, NoLane, NoLanes, NoLanes);
+      compactRootQueueArenas(root);
       break;
     }
     case RootExitStatus::InProgress:
@@ -45,27 +45,26 @@ void resetSuspendedComponent(FiberNode& sourceFiber, Lanes /*rootRenderLanes*/)
   }
 }
 
-RetryQueue& ensureRetryQueue(FiberNode& boundary) {
+RetryQueue& ensureRetryQueue(FiberRoot& root, FiberNode& boundary) {
   auto* queue = static_cast<RetryQueue*>(boundary.updateQueue);
   if (queue == nullptr) {
-    queue = new RetryQueue();
-    boundary.updateQueue = queue;
+    queue = root.retryQueueArena.createForFiber<RetryQueue>(boundary);
   }
   return *queue;
 }
 
-OffscreenQueue& ensureOffscreenQueue(FiberNode& boundary) {
+OffscreenQueue& ensureOffscreenQueue(FiberRoot& root, FiberNode& boundary) {
   auto* queue = static_cast<OffscreenQueue*>(boundary.updateQueue);
   if (queue == nullptr) {
-    queue = new OffscreenQueue();
-    boundary.updateQueue = queue;
+    queue = root.retryQueueArena.createForFiber<OffscreenQueue>(boundary);
   }
   return *queue;
 }
 
-RetryQueue& ensureOffscreenRetryQueue(OffscreenQueue& queue) {
+RetryQueue& ensureOffscreenRetryQueue(FiberRoot& root, OffscreenQueue& queue) {
   if (queue.retryQueue == nullptr) {
-    queue.retryQueue = std::make_unique<RetryQueue>();
+    queue.retryQueue = root.retryQueueArena.create<RetryQueue>();
+    root.retryQueueArena.adopt(&queue, queue.retryQueue);
   }
   return *queue.retryQueue;
 }
@@ -146,7 +145,7 @@ bool throwException(
           if (isSuspenseyResource) {
             boundary->flags = static_cast<FiberFlags>(boundary->flags | ScheduleRetry);
           } else {
-            RetryQueue& retryQueue = ensureRetryQueue(*boundary);
+            RetryQueue& retryQueue = ensureRetryQueue(root, *boundary);
             retryQueue.insert(wakeable);
             if ((disableLegacyMode || (boundary->mode & ConcurrentMode) != NoMode) &&
                 !isSuspenseyResource) {
@@ -166,8 +165,8 @@ bool throwException(
             if (isSuspenseyResource) {
               boundary->flags = static_cast<FiberFlags>(boundary->flags | ScheduleRetry);
             } else {
-              OffscreenQueue& offscreenQueue = ensureOffscreenQueue(*boundary);
-              RetryQueue& retryQueue = ensureOffscreenRetryQueue(offscreenQueue);
+              OffscreenQueue& offscreenQueue = ensureOffscreenQueue(root, *boundary);
+              RetryQueue& retryQueue = ensureOffscreenRetryQueue(root, offscreenQueue);
               retryQueue.insert(wakeable);
               attachPingListener(runtime, root, *wakeable, renderLanes);
             }
@@ -213,8 +212,8 @@ bool throwException(
 
         auto* const rootStateNode = static_cast<FiberRoot*>(boundary->stateNode);
         if (rootStateNode != nullptr) {
-          auto update = createRootErrorClassUpdate(*rootStateNode, errorInfo, lane);
-          pushClassUpdate(*boundary, std::move(update));
+          ClassUpdate* const update = createRootErrorClassUpdate(*rootStateNode, errorInfo, lane);
+          pushClassUpdate(*rootStateNode, *boundary, update);
         }
         return false;
       }
@@ -226,9 +225,9 @@ bool throwException(
             const Lane lane = pickArbitraryLane(renderLanes);
             boundary->lanes = mergeLanes(boundary->lanes, lane);
 
-            auto update = createClassErrorUpdate(lane);
+            ClassUpdate* const update = createClassErrorUpdate(root, lane);
             initializeClassErrorUpdate(*update, root, *boundary, errorInfo);
-            pushClassUpdate(*boundary, std::move(update));
+            pushClassUpdate(root, *boundary, update);
             return false;
           }
         }
@@ -0,0 +1,25 @@
+#include "react-reconciler/ReactFiberTransition.h"
+
+#include "react-reconciler/ReactFiberLane.h"
+#include "runtime/ReactRuntime.h"
+
+namespace react {
+
+const std::shared_ptr<const Transition>& requestCurrentTransition(ReactRuntime& runtime) {
+  return runtime.asyncActionState().currentTransition;
+}
+
+void startTransition(ReactRuntime& runtime, const std::function<void()>& scope) {
+  AsyncActionState& state = runtime.asyncActionState();
+  std::shared_ptr<const Transition> previousTransition = std::move(state.currentTransition);
+  state.currentTransition = std::make_shared<const Transition>();
+  try {
+    scope();
+  } catch (...) {
+    state.currentTransition = std::move(previousTransition);
+    throw;
+  }
+  state.currentTransition = std::move(previousTransition);
+}
+
+} // namespace react
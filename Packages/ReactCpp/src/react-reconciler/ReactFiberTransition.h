@@ -0,0 +1,24 @@
+#pragma once
+
+// startTransition from react-main/packages/react/src/ReactStartTransition.js
+// and requestCurrentTransition from ReactFiberTransition.js. The transition
+// scope lives on the runtime instead of ReactSharedInternals.T.
+
+#include <functional>
+#include <memory>
+
+namespace react {
+
+class ReactRuntime;
+struct Transition;
+
+// The transition of the enclosing startTransition scope, or null. Copy the
+// pointer to keep the transition past the scope.
+[[nodiscard]] const std::shared_ptr<const Transition>& requestCurrentTransition(ReactRuntime& runtime);
+
+// Runs `scope` with a transition active: updates it schedules render on a
+// transition lane, concurrently and interruptibly, instead of the lane of the
+// current event.
+void startTransition(ReactRuntime& runtime, const std::function<void()>& scope);
+
+} // namespace react
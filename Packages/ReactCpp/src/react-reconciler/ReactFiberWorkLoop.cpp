@@ -1,5 +1,6 @@
 #include "react-reconciler/ReactFiberWorkLoop.h"
 
+#include "react-reconciler/ReactFiberBeginWork.h"
 #include "react-reconciler/ReactFiberConcurrentUpdates.h"
 #include "react-reconciler/ReactCapturedValue.h"
 #include "react-reconciler/ReactFiberErrorLogger.h"
@@ -8,6 +9,7 @@
 #include "react-reconciler/ReactFiberThrow.h"
 #include "react-reconciler/ReactFiberSuspenseContext.h"
 #include "react-reconciler/ReactFiberRootScheduler.h"
+#include "react-reconciler/ReactFiberTransition.h"
 #include "runtime/ReactRuntime.h"
 #include "shared/ReactFeatureFlags.h"
 
@@ -85,11 +87,25 @@ void unwindInterruptedWork(FiberNode* current, FiberNode* workInProgress, Lanes
   // TODO: implement unwind semantics once effect and context stacks are available.
 }
 
+void bubbleProperties(FiberNode& completedWork) {
+  Lanes newChildLanes = NoLanes;
+  FiberFlags subtreeFlags = NoFlags;
+  for (FiberNode* child = completedWork.child; child != nullptr; child = child->sibling) {
+    newChildLanes = mergeLanes(newChildLanes, mergeLanes(child->lanes, child->childLanes));
+    subtreeFlags |= child->subtreeFlags;
+    subtreeFlags |= child->flags;
+  }
+  completedWork.subtreeFlags |= subtreeFlags;
+  completedWork.childLanes = newChildLanes;
+}
+
 FiberNode* completeWork(FiberNode* current, FiberNode* workInProgress, Lanes entangledRenderLanes) {
   (void)current;
-  (void)workInProgress;
   (void)entangledRenderLanes;
-  // TODO: port completeWork from ReactFiberCompleteWork.
+  // TODO: port the host component paths of ReactFiberCompleteWork.
+  if (workInProgress != nullptr) {
+    bubbleProperties(*workInProgress);
+  }
   return nullptr;
 }
 
@@ -109,22 +125,10 @@ void stopProfilerTimerIfRunningAndRecordIncompleteDuration(FiberNode&) {
   // TODO: integrate ReactProfilerTimer when available.
 }
 
-FiberNode* beginWork(FiberNode* /*current*/, FiberNode* workInProgress, Lanes /*entangledRenderLanes*/) {
-  if (workInProgress == nullptr) {
-    return nullptr;
-  }
-  return workInProgress->child;
-}
-
 void stopProfilerTimerIfRunningAndRecordDuration(FiberNode&) {
   // TODO: integrate ReactProfilerTimer when available.
 }
 
-bool shouldYield() {
-  // TODO: integrate scheduler-based yielding.
-  return false;
-}
-
 bool getIsHydrating() {
   // TODO: integrate hydration state once hydration support lands.
   return false;
@@ -486,6 +490,86 @@ double getCurrentTime(ReactRuntime& runtime) {
   return runtime.now();
 }
 
+Lane requestUpdateLane(ReactRuntime& runtime, const FiberNode& fiber) {
+  (void)fiber;
+  const auto& state = getState(runtime);
+  if ((state.executionContext & RenderContext) != NoContext && state.workInProgressRootRenderLanes != NoLanes) {
+    return pickArbitraryLane(state.workInProgressRootRenderLanes);
+  }
+
+  if (const std::shared_ptr<const Transition>& transition = requestCurrentTransition(runtime)) {
+    return requestTransitionLane(runtime, transition.get());
+  }
+
+  switch (runtime.getCurrentPriorityLevel()) {
+    case SchedulerPriority::ImmediatePriority:
+      return SyncLane;
+    case SchedulerPriority::UserBlockingPriority:
+      return InputContinuousLane;
+    case SchedulerPriority::IdlePriority:
+      return IdleLane;
+    default:
+      return DefaultLane;
+  }
+}
+
+Lane requestDeferredLane(ReactRuntime& runtime) {
+  auto& state = getState(runtime);
+  if (state.deferredLane == NoLane) {
+    const bool isPrerendering =
+        includesSomeLane(state.workInProgressRootRenderLanes, OffscreenLane) && !getIsHydrating();
+    state.deferredLane = isPrerendering ? OffscreenLane : claimNextTransitionLane();
+  }
+
+  if (FiberNode* const suspenseHandler = getSuspenseHandler()) {
+    suspenseHandler->flags |= DidDefer;
+  }
+  return state.deferredLane;
+}
+
+void scheduleUpdateOnFiber(ReactRuntime& runtime, FiberRoot& root, FiberNode& fiber, Lane lane) {
+  (void)fiber;
+  auto& state = getState(runtime);
+  if ((&root == state.workInProgressRoot &&
+       (state.suspendedReason == SuspendedReason::SuspendedOnData ||
+        state.suspendedReason == SuspendedReason::SuspendedOnAction)) ||
+      root.cancelPendingCommit != nullptr) {
+    // The in-progress render is waiting on data that this update may make
+    // irrelevant; restart from the root.
+    prepareFreshStack(runtime, root, NoLanes);
+    constexpr bool didAttemptEntireTree = false;
+    markRootSuspended(root, state.workInProgressRootRenderLanes, state.deferredLane, didAttemptEntireTree);
+  }
+
+  markRootUpdated(root, lane);
+
+  if ((state.executionContext & RenderContext) != NoContext && &root == state.workInProgressRoot) {
+    state.renderPhaseUpdatedLanes = mergeLanes(state.renderPhaseUpdatedLanes, lane);
+    return;
+  }
+
+  if (&root == state.workInProgressRoot) {
+    // Interleaved with a yielded render; it is applied when that render
+    // finishes or restarts.
+    state.interleavedUpdatedLanes = mergeLanes(state.interleavedUpdatedLanes, lane);
+    if (state.exitStatus == RootExitStatus::SuspendedWithDelay) {
+      constexpr bool didAttemptEntireTree = false;
+      markRootSuspended(root, state.workInProgressRootRenderLanes, state.deferredLane, didAttemptEntireTree);
+    }
+  }
+  ensureRootIsScheduled(runtime, root);
+}
+
+Lane scheduleFiberUpdate(ReactRuntime& runtime, FiberNode& fiber) {
+  const Lane lane = requestUpdateLane(runtime, fiber);
+  FiberRoot* const root = enqueueConcurrentRenderForLane(&fiber, lane);
+  if (root == nullptr) {
+    return NoLane;
+  }
+  scheduleUpdateOnFiber(runtime, *root, fiber, lane);
+  return lane;
+}
+
 void markSkippedUpdateLanes(ReactRuntime& runtime, Lanes lanes) {
   auto& state = getState(runtime);
   state.skippedLanes = mergeLanes(state.skippedLanes, lanes);
@@ -551,7 +635,7 @@ void performUnitOfWork(ReactRuntime& runtime, FiberNode& unitOfWork) {
     startProfilerTimer(unitOfWork);
   }
 
-  next = beginWork(current, &unitOfWork, state.entangledRenderLanes);
+  next = beginWork(runtime, current, unitOfWork, state.entangledRenderLanes);
 
   if (isProfiling) {
     stopProfilerTimerIfRunningAndRecordDuration(unitOfWork);
@@ -587,7 +671,7 @@ void workLoopConcurrent(ReactRuntime& runtime, bool nonIdle) {
 
 void workLoopConcurrentByScheduler(ReactRuntime& runtime) {
   while (FiberNode* workInProgress = getWorkInProgressFiber(runtime)) {
-    if (shouldYield()) {
+    if (runtime.shouldYield()) {
       break;
     }
     performUnitOfWork(runtime, *workInProgress);
@@ -687,7 +771,11 @@ RootExitStatus renderRootConcurrent(
       continue;
     }
 
-    workLoopConcurrent(runtime, includesNonIdleWork(lanes));
+    if constexpr (enableThrottledScheduling) {
+      workLoopConcurrent(runtime, includesNonIdleWork(lanes));
+    } else {
+      workLoopConcurrentByScheduler(runtime);
+    }
     shouldContinue = false;
   }
 
@@ -98,6 +98,18 @@ Lanes getPendingPassiveEffectsLanes(ReactRuntime& runtime);
 bool isWorkLoopSuspendedOnData(ReactRuntime& runtime);
 double getCurrentTime(ReactRuntime& runtime);
 
+// Lane for an update scheduled now: the render lane during render, a
+// transition lane inside startTransition, otherwise the lane matching the
+// current scheduler priority.
+Lane requestUpdateLane(ReactRuntime& runtime, const FiberNode& fiber);
+// Lane that useDeferredValue spawns for the background re-render; shared by
+// every deferred value in the current render.
+Lane requestDeferredLane(ReactRuntime& runtime);
+void scheduleUpdateOnFiber(ReactRuntime& runtime, FiberRoot& root, FiberNode& fiber, Lane lane);
+// Queues a re-render of `fiber` on requestUpdateLane's lane and schedules its
+// root. Returns the lane, or NoLane when the fiber is not mounted in a root.
+Lane scheduleFiberUpdate(ReactRuntime& runtime, FiberNode& fiber);
+
 void markSkippedUpdateLanes(ReactRuntime& runtime, Lanes lanes);
 void renderDidSuspend(ReactRuntime& runtime);
 void renderDidSuspendDelayIfPossible(ReactRuntime& runtime);
@@ -0,0 +1,79 @@
+#include "runtime/ReactHostInstancePool.h"
+
+#include "react-dom/client/ReactDOMComponent.h"
+
+namespace react {
+namespace {
+
+std::shared_ptr<ReactDOMInstance> takeLast(std::vector<std::shared_ptr<ReactDOMInstance>>& instances) {
+  if (instances.empty()) {
+    return nullptr;
+  }
+  std::shared_ptr<ReactDOMInstance> instance = std::move(instances.back());
+  instances.pop_back();
+  return instance;
+}
+
+} // namespace
+
+void HostInstancePool::setCapacity(std::size_t capacityPerType) {
+  capacity_ = capacityPerType;
+  for (auto& [_, instances] : freeInstances_) {
+    if (instances.size() > capacity_) {
+      instances.resize(capacity_);
+    }
+  }
+  if (freeTextInstances_.size() > capacity_) {
+    freeTextInstances_.resize(capacity_);
+  }
+}
+
+void HostInstancePool::release(std::shared_ptr<ReactDOMInstance> instance) {
+  // A count of one means `instance` is the last reference: no parent, JS
+  // object or test still holds it.
+  if (!instance || instance.use_count() != 1) {
+    return;
+  }
+  if (instance->nodeKind() == HostNodeKind::Opaque) {
+    return;
+  }
+  auto* component = static_cast<ReactDOMComponent*>(instance.get());
+
+  for (auto& child : component->takeChildren()) {
+    release(std::move(child));
+  }
+
+  auto& instances = component->isTextInstance() ? freeTextInstances_ : freeListFor(component->getType());
+  if (instances.size() >= capacity_) {
+    ++stats_.dropped;
+    return;
+  }
+  instances.push_back(std::move(instance));
+  ++stats_.released;
+}
+
+std::shared_ptr<ReactDOMInstance> HostInstancePool::acquire(std::string_view type) {
+  auto it = freeInstances_.find(type);
+  return it != freeInstances_.end() ? takeLast(it->second) : nullptr;
+}
+
+std::vector<std::shared_ptr<ReactDOMInstance>>& HostInstancePool::freeListFor(std::string_view type) {
+  auto it = freeInstances_.find(type);
+  if (it == freeInstances_.end()) {
+    // A deque never moves its strings, so the key stays valid.
+    it = freeInstances_.emplace(typeNames_.emplace_back(type), std::vector<std::shared_ptr<ReactDOMInstance>>{}).first;
+  }
+  return it->second;
+}
+
+std::shared_ptr<ReactDOMInstance> HostInstancePool::acquireText() {
+  return takeLast(freeTextInstances_);
+}
+
+void HostInstancePool::clear() {
+  freeInstances_.clear();
+  typeNames_.clear();
+  freeTextInstances_.clear();
+}
+
+} // namespace react
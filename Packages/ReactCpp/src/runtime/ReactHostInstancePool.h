@@ -0,0 +1,73 @@
+#pragma once
+
+// Opt-in free lists of unmounted host instances, keyed by element type, so
+// list churn reuses instances instead of allocating new ones. An instance is
+// only taken while nothing but the reconciler still references it; the
+// host's recycleHostInstance hook resets it before it is handed out again.
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace react {
+
+class ReactDOMInstance;
+
+struct HostInstancePoolStats {
+  // Instances created from the pool, and those created fresh while the
+  // pool was enabled.
+  std::size_t hits{0};
+  std::size_t misses{0};
+  // Unmounted instances the pool took, and those it dropped at the cap.
+  std::size_t released{0};
+  std::size_t dropped{0};
+};
+
+class HostInstancePool {
+public:
+  // Keeps at most `capacityPerType` instances of each type; 0 disables the
+  // pool and frees what it holds.
+  void setCapacity(std::size_t capacityPerType);
+  std::size_t capacity() const {
+    return capacity_;
+  }
+  bool enabled() const {
+    return capacity_ > 0;
+  }
+
+  // Takes `instance` and its descendants once they have been detached from
+  // the host tree. Instances that are still referenced elsewhere are left
+  // untouched, together with their subtrees.
+  void release(std::shared_ptr<ReactDOMInstance> instance);
+
+  // Return a pooled element instance of `type`, or a pooled text instance,
+  // or null when there is none.
+  std::shared_ptr<ReactDOMInstance> acquire(std::string_view type);
+  std::shared_ptr<ReactDOMInstance> acquireText();
+
+  void clear();
+
+  HostInstancePoolStats& stats() {
+    return stats_;
+  }
+  const HostInstancePoolStats& stats() const {
+    return stats_;
+  }
+
+private:
+  std::vector<std::shared_ptr<ReactDOMInstance>>& freeListFor(std::string_view type);
+
+  std::size_t capacity_{0};
+  // Keyed by views into typeNames_, so acquire looks types up without
+  // building a std::string; C++17 has no heterogeneous unordered lookup.
+  std::unordered_map<std::string_view, std::vector<std::shared_ptr<ReactDOMInstance>>> freeInstances_{};
+  std::deque<std::string> typeNames_{};
+  std::vector<std::shared_ptr<ReactDOMInstance>> freeTextInstances_{};
+  HostInstancePoolStats stats_{};
+};
+
+} // namespace react
@@ -21,6 +21,30 @@ std::shared_ptr<ReactDOMInstance> HostInterface::createHostTextInstance(
   return instance;
 }
 
+bool HostInterface::recycleHostInstance(
+    std::shared_ptr<ReactDOMInstance> instance,
+    facebook::jsi::Runtime& runtime,
+    const facebook::jsi::Object& props) {
+  auto component = std::dynamic_pointer_cast<ReactDOMComponent>(instance);
+  if (!component || component->isTextInstance()) {
+    return false;
+  }
+  component->resetForReuse(runtime, props);
+  return true;
+}
+
+bool HostInterface::recycleHostTextInstance(
+    std::shared_ptr<ReactDOMInstance> instance,
+    facebook::jsi::Runtime& runtime,
+    const std::string& text) {
+  auto component = std::dynamic_pointer_cast<ReactDOMComponent>(instance);
+  if (!component || !component->isTextInstance()) {
+    return false;
+  }
+  component->resetForReuse(runtime, text);
+  return true;
+}
+
 void HostInterface::appendHostChild(
     std::shared_ptr<ReactDOMInstance> parent,
     std::shared_ptr<ReactDOMInstance> child) {
@@ -46,6 +70,40 @@ void HostInterface::insertHostChildBefore(
   }
 }
 
+void HostInterface::removeAllHostChildren(std::shared_ptr<ReactDOMInstance> parent) {
+  if (parent) {
+    parent->removeAllChildren();
+  }
+}
+
+void HostInterface::replaceHostChildren(
+    std::shared_ptr<ReactDOMInstance> parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last) {
+  if (parent) {
+    parent->replaceChildren(first, last);
+  }
+}
+
+void HostInterface::appendHostChildren(
+    std::shared_ptr<ReactDOMInstance> parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last) {
+  if (parent) {
+    parent->appendChildren(first, last);
+  }
+}
+
+void HostInterface::moveHostChildrenBefore(
+    std::shared_ptr<ReactDOMInstance> parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last,
+    std::shared_ptr<ReactDOMInstance> beforeChild) {
+  if (parent) {
+    parent->moveChildrenBefore(first, last, std::move(beforeChild));
+  }
+}
+
 void HostInterface::commitHostUpdate(
     std::shared_ptr<ReactDOMInstance> instance,
     const facebook::jsi::Object& oldProps,
@@ -59,6 +117,16 @@ void HostInterface::commitHostUpdate(
   component->applyUpdate(newProps, payload);
 }
 
+void HostInterface::commitHostUpdate(
+    std::shared_ptr<ReactDOMInstance> instance,
+    const UpdatePayload& payload) {
+  auto component = std::dynamic_pointer_cast<ReactDOMComponent>(instance);
+  if (!component) {
+    return;
+  }
+  component->applyUpdate(payload);
+}
+
 void HostInterface::commitHostTextUpdate(
     std::shared_ptr<ReactDOMInstance> instance,
     const std::string& oldText,
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace facebook {
 namespace jsi {
@@ -13,6 +14,8 @@ class Object;
 namespace react {
 
 class ReactDOMInstance;
+using ReactDOMInstanceIterator = const std::shared_ptr<ReactDOMInstance>*;
+struct UpdatePayload;
 
 class HostInterface {
 public:
@@ -27,6 +30,20 @@ public:
       facebook::jsi::Runtime& runtime,
       const std::string& text);
 
+  // Prepare an instance from the runtime's host instance pool for reuse with
+  // new props or text. Returning false makes the runtime create a fresh
+  // instance instead. The defaults reset a ReactDOMComponent; hosts that
+  // attach native state in createHostInstance must override them.
+  virtual bool recycleHostInstance(
+      std::shared_ptr<ReactDOMInstance> instance,
+      facebook::jsi::Runtime& runtime,
+      const facebook::jsi::Object& props);
+
+  virtual bool recycleHostTextInstance(
+      std::shared_ptr<ReactDOMInstance> instance,
+      facebook::jsi::Runtime& runtime,
+      const std::string& text);
+
   virtual void appendHostChild(
       std::shared_ptr<ReactDOMInstance> parent,
       std::shared_ptr<ReactDOMInstance> child);
@@ -40,12 +57,37 @@ public:
       std::shared_ptr<ReactDOMInstance> child,
       std::shared_ptr<ReactDOMInstance> beforeChild);
 
+  // Bulk child operations, each a single host call.
+  virtual void removeAllHostChildren(std::shared_ptr<ReactDOMInstance> parent);
+
+  virtual void replaceHostChildren(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last);
+
+  virtual void appendHostChildren(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last);
+
+  virtual void moveHostChildrenBefore(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last,
+      std::shared_ptr<ReactDOMInstance> beforeChild);
+
   virtual void commitHostUpdate(
       std::shared_ptr<ReactDOMInstance> instance,
       const facebook::jsi::Object& oldProps,
       const facebook::jsi::Object& newProps,
       const facebook::jsi::Object& payload);
 
+  // Applies a native update payload; the default writes it straight into a
+  // ReactDOMComponent without building JSI objects.
+  virtual void commitHostUpdate(
+      std::shared_ptr<ReactDOMInstance> instance,
+      const UpdatePayload& payload);
+
   virtual void commitHostTextUpdate(
       std::shared_ptr<ReactDOMInstance> instance,
       const std::string& oldText,
@@ -0,0 +1,213 @@
+#include "runtime/ReactHostInterfaceV2.h"
+
+#include "react-dom/client/ReactDOMComponent.h"
+#include "runtime/ReactHostInterface.h"
+
+#include <string>
+#include <utility>
+
+namespace react {
+namespace {
+
+ReactDOMComponent* asComponent(HostInstanceHandle handle, HostNodeKind kind) {
+  return handle.kind == kind ? static_cast<ReactDOMComponent*>(handle.instance) : nullptr;
+}
+
+} // namespace
+
+std::shared_ptr<ReactDOMInstance> HostInterfaceV2::createInstance(
+    facebook::jsi::Runtime& runtime,
+    std::string_view type,
+    const facebook::jsi::Object& props) {
+  auto instance = std::make_shared<ReactDOMComponent>(runtime, std::string(type), props);
+  instance->tagName = type;
+  return instance;
+}
+
+std::shared_ptr<ReactDOMInstance> HostInterfaceV2::createTextInstance(
+    facebook::jsi::Runtime& runtime,
+    std::string_view text) {
+  auto instance = std::make_shared<ReactDOMComponent>(runtime, "#text", std::string(text));
+  instance->tagName = "#text";
+  return instance;
+}
+
+bool HostInterfaceV2::recycleInstance(
+    HostInstanceHandle instance,
+    facebook::jsi::Runtime& runtime,
+    const facebook::jsi::Object& props) {
+  auto* component = asComponent(instance, HostNodeKind::Element);
+  if (component == nullptr) {
+    return false;
+  }
+  component->resetForReuse(runtime, props);
+  return true;
+}
+
+bool HostInterfaceV2::recycleTextInstance(
+    HostInstanceHandle instance,
+    facebook::jsi::Runtime& runtime,
+    std::string_view text) {
+  auto* component = asComponent(instance, HostNodeKind::Text);
+  if (component == nullptr) {
+    return false;
+  }
+  component->resetForReuse(runtime, std::string(text));
+  return true;
+}
+
+void HostInterfaceV2::appendChild(HostInstanceHandle parent, HostInstanceHandle child) {
+  if (parent) {
+    parent->appendChild(child.retain());
+  }
+}
+
+void HostInterfaceV2::removeChild(HostInstanceHandle parent, HostInstanceHandle child) {
+  if (parent) {
+    parent->removeChild(child.retain());
+  }
+}
+
+void HostInterfaceV2::insertChildBefore(
+    HostInstanceHandle parent,
+    HostInstanceHandle child,
+    HostInstanceHandle beforeChild) {
+  if (parent) {
+    parent->insertChildBefore(child.retain(), beforeChild.retain());
+  }
+}
+
+void HostInterfaceV2::removeAllChildren(HostInstanceHandle parent) {
+  if (parent) {
+    parent->removeAllChildren();
+  }
+}
+
+void HostInterfaceV2::replaceChildren(HostInstanceHandle parent, HostInstanceSpan children) {
+  if (parent) {
+    parent->replaceChildren(children.first, children.last);
+  }
+}
+
+void HostInterfaceV2::appendChildren(HostInstanceHandle parent, HostInstanceSpan children) {
+  if (parent) {
+    parent->appendChildren(children.first, children.last);
+  }
+}
+
+void HostInterfaceV2::moveChildrenBefore(
+    HostInstanceHandle parent,
+    HostInstanceSpan children,
+    HostInstanceHandle beforeChild) {
+  if (parent) {
+    parent->moveChildrenBefore(children.first, children.last, beforeChild.retain());
+  }
+}
+
+void HostInterfaceV2::commitUpdate(
+    HostInstanceHandle instance,
+    const facebook::jsi::Object& oldProps,
+    const facebook::jsi::Object& newProps,
+    const facebook::jsi::Object& payload) {
+  (void)oldProps;
+  if (auto* component = asComponent(instance, HostNodeKind::Element)) {
+    component->applyUpdate(newProps, payload);
+  }
+}
+
+void HostInterfaceV2::commitUpdate(HostInstanceHandle instance, const UpdatePayload& payload) {
+  if (auto* component = asComponent(instance, HostNodeKind::Element)) {
+    component->applyUpdate(payload);
+  }
+}
+
+void HostInterfaceV2::commitTextUpdate(HostInstanceHandle instance, std::string_view oldText, std::string_view newText) {
+  (void)oldText;
+  if (instance) {
+    instance->setTextContent(std::string(newText));
+  }
+}
+
+HostInterfaceAdapter::HostInterfaceAdapter(std::shared_ptr<HostInterface> host) : host_(std::move(host)) {}
+
+std::shared_ptr<ReactDOMInstance> HostInterfaceAdapter::createInstance(
+    facebook::jsi::Runtime& runtime,
+    std::string_view type,
+    const facebook::jsi::Object& props) {
+  return host_->createHostInstance(runtime, std::string(type), props);
+}
+
+std::shared_ptr<ReactDOMInstance> HostInterfaceAdapter::createTextInstance(
+    facebook::jsi::Runtime& runtime,
+    std::string_view text) {
+  return host_->createHostTextInstance(runtime, std::string(text));
+}
+
+bool HostInterfaceAdapter::recycleInstance(
+    HostInstanceHandle instance,
+    facebook::jsi::Runtime& runtime,
+    const facebook::jsi::Object& props) {
+  return host_->recycleHostInstance(instance.retain(), runtime, props);
+}
+
+bool HostInterfaceAdapter::recycleTextInstance(
+    HostInstanceHandle instance,
+    facebook::jsi::Runtime& runtime,
+    std::string_view text) {
+  return host_->recycleHostTextInstance(instance.retain(), runtime, std::string(text));
+}
+
+void HostInterfaceAdapter::appendChild(HostInstanceHandle parent, HostInstanceHandle child) {
+  host_->appendHostChild(parent.retain(), child.retain());
+}
+
+void HostInterfaceAdapter::removeChild(HostInstanceHandle parent, HostInstanceHandle child) {
+  host_->removeHostChild(parent.retain(), child.retain());
+}
+
+void HostInterfaceAdapter::insertChildBefore(
+    HostInstanceHandle parent,
+    HostInstanceHandle child,
+    HostInstanceHandle beforeChild) {
+  host_->insertHostChildBefore(parent.retain(), child.retain(), beforeChild.retain());
+}
+
+void HostInterfaceAdapter::removeAllChildren(HostInstanceHandle parent) {
+  host_->removeAllHostChildren(parent.retain());
+}
+
+void HostInterfaceAdapter::replaceChildren(HostInstanceHandle parent, HostInstanceSpan children) {
+  host_->replaceHostChildren(parent.retain(), children.first, children.last);
+}
+
+void HostInterfaceAdapter::appendChildren(HostInstanceHandle parent, HostInstanceSpan children) {
+  host_->appendHostChildren(parent.retain(), children.first, children.last);
+}
+
+void HostInterfaceAdapter::moveChildrenBefore(
+    HostInstanceHandle parent,
+    HostInstanceSpan children,
+    HostInstanceHandle beforeChild) {
+  host_->moveHostChildrenBefore(parent.retain(), children.first, children.last, beforeChild.retain());
+}
+
+void HostInterfaceAdapter::commitUpdate(
+    HostInstanceHandle instance,
+    const facebook::jsi::Object& oldProps,
+    const facebook::jsi::Object& newProps,
+    const facebook::jsi::Object& payload) {
+  host_->commitHostUpdate(instance.retain(), oldProps, newProps, payload);
+}
+
+void HostInterfaceAdapter::commitUpdate(HostInstanceHandle instance, const UpdatePayload& payload) {
+  host_->commitHostUpdate(instance.retain(), payload);
+}
+
+void HostInterfaceAdapter::commitTextUpdate(
+    HostInstanceHandle instance,
+    std::string_view oldText,
+    std::string_view newText) {
+  host_->commitHostTextUpdate(instance.retain(), std::string(oldText), std::string(newText));
+}
+
+} // namespace react
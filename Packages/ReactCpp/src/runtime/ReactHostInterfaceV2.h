@@ -0,0 +1,151 @@
+#pragma once
+
+// Host API the runtime drives. Unlike HostInterface, which takes every
+// instance as a std::shared_ptr by value and every type and text as a
+// std::string, it passes instances as non-owning handles tagged with their
+// node kind and strings as views, so a host call costs no refcount traffic
+// or string copies. Hosts written against HostInterface keep working:
+// ReactRuntime::setHostInterface wraps them in a HostInterfaceAdapter.
+
+#include "react-dom/client/ReactDOMInstance.h"
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace facebook {
+namespace jsi {
+class Runtime;
+class Object;
+} // namespace jsi
+} // namespace facebook
+
+namespace react {
+
+class HostInterface;
+struct UpdatePayload;
+
+// Borrowed reference to a host instance, valid for the duration of the call
+// it is passed to. Hosts that keep the instance take a reference with
+// retain().
+struct HostInstanceHandle {
+  ReactDOMInstance* instance{nullptr};
+  HostNodeKind kind{HostNodeKind::Opaque};
+
+  HostInstanceHandle() = default;
+  HostInstanceHandle(ReactDOMInstance* target)
+    : instance(target), kind(target != nullptr ? target->nodeKind() : HostNodeKind::Opaque) {}
+  HostInstanceHandle(const std::shared_ptr<ReactDOMInstance>& target) : HostInstanceHandle(target.get()) {}
+
+  explicit operator bool() const {
+    return instance != nullptr;
+  }
+  ReactDOMInstance* operator->() const {
+    return instance;
+  }
+  std::shared_ptr<ReactDOMInstance> retain() const {
+    return instance != nullptr ? instance->shared_from_this() : nullptr;
+  }
+};
+
+// Contiguous run of children for the bulk child operations.
+struct HostInstanceSpan {
+  ReactDOMInstanceIterator first{nullptr};
+  ReactDOMInstanceIterator last{nullptr};
+
+  ReactDOMInstanceIterator begin() const {
+    return first;
+  }
+  ReactDOMInstanceIterator end() const {
+    return last;
+  }
+  std::size_t size() const {
+    return static_cast<std::size_t>(last - first);
+  }
+  bool empty() const {
+    return first == last;
+  }
+};
+
+// The defaults build and mutate ReactDOMComponent trees directly.
+class HostInterfaceV2 {
+public:
+  virtual ~HostInterfaceV2() = default;
+
+  virtual std::shared_ptr<ReactDOMInstance> createInstance(
+      facebook::jsi::Runtime& runtime,
+      std::string_view type,
+      const facebook::jsi::Object& props);
+
+  virtual std::shared_ptr<ReactDOMInstance> createTextInstance(facebook::jsi::Runtime& runtime, std::string_view text);
+
+  // Prepare an instance from the runtime's host instance pool for reuse;
+  // returning false makes the runtime create a fresh one.
+  virtual bool recycleInstance(
+      HostInstanceHandle instance,
+      facebook::jsi::Runtime& runtime,
+      const facebook::jsi::Object& props);
+
+  virtual bool recycleTextInstance(HostInstanceHandle instance, facebook::jsi::Runtime& runtime, std::string_view text);
+
+  virtual void appendChild(HostInstanceHandle parent, HostInstanceHandle child);
+  virtual void removeChild(HostInstanceHandle parent, HostInstanceHandle child);
+  virtual void insertChildBefore(HostInstanceHandle parent, HostInstanceHandle child, HostInstanceHandle beforeChild);
+
+  virtual void removeAllChildren(HostInstanceHandle parent);
+  virtual void replaceChildren(HostInstanceHandle parent, HostInstanceSpan children);
+  virtual void appendChildren(HostInstanceHandle parent, HostInstanceSpan children);
+  virtual void moveChildrenBefore(HostInstanceHandle parent, HostInstanceSpan children, HostInstanceHandle beforeChild);
+
+  virtual void commitUpdate(
+      HostInstanceHandle instance,
+      const facebook::jsi::Object& oldProps,
+      const facebook::jsi::Object& newProps,
+      const facebook::jsi::Object& payload);
+  virtual void commitUpdate(HostInstanceHandle instance, const UpdatePayload& payload);
+  virtual void commitTextUpdate(HostInstanceHandle instance, std::string_view oldText, std::string_view newText);
+};
+
+// Drives a HostInterface through the v2 API, retaining instances and
+// copying strings where it expects them.
+class HostInterfaceAdapter final : public HostInterfaceV2 {
+public:
+  explicit HostInterfaceAdapter(std::shared_ptr<HostInterface> host);
+
+  const std::shared_ptr<HostInterface>& host() const {
+    return host_;
+  }
+
+  std::shared_ptr<ReactDOMInstance> createInstance(
+      facebook::jsi::Runtime& runtime,
+      std::string_view type,
+      const facebook::jsi::Object& props) override;
+  std::shared_ptr<ReactDOMInstance> createTextInstance(facebook::jsi::Runtime& runtime, std::string_view text) override;
+  bool recycleInstance(HostInstanceHandle instance, facebook::jsi::Runtime& runtime, const facebook::jsi::Object& props)
+      override;
+  bool recycleTextInstance(HostInstanceHandle instance, facebook::jsi::Runtime& runtime, std::string_view text)
+      override;
+
+  void appendChild(HostInstanceHandle parent, HostInstanceHandle child) override;
+  void removeChild(HostInstanceHandle parent, HostInstanceHandle child) override;
+  void insertChildBefore(HostInstanceHandle parent, HostInstanceHandle child, HostInstanceHandle beforeChild) override;
+
+  void removeAllChildren(HostInstanceHandle parent) override;
+  void replaceChildren(HostInstanceHandle parent, HostInstanceSpan children) override;
+  void appendChildren(HostInstanceHandle parent, HostInstanceSpan children) override;
+  void moveChildrenBefore(HostInstanceHandle parent, HostInstanceSpan children, HostInstanceHandle beforeChild)
+      override;
+
+  void commitUpdate(
+      HostInstanceHandle instance,
+      const facebook::jsi::Object& oldProps,
+      const facebook::jsi::Object& newProps,
+      const facebook::jsi::Object& payload) override;
+  void commitUpdate(HostInstanceHandle instance, const UpdatePayload& payload) override;
+  void commitTextUpdate(HostInstanceHandle instance, std::string_view oldText, std::string_view newText) override;
+
+private:
+  std::shared_ptr<HostInterface> host_;
+};
+
+} // namespace react
@@ -1,11 +1,12 @@
 #include "runtime/ReactJSXRuntime.h"
+#include "runtime/ReactTextChildren.h"
+#include "runtime/ReactWasmBridge.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstring>
 #include <optional>
-#include <sstream>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -46,25 +47,17 @@ ReactElementPtr hostValueToElement(jsi::Runtime& runtime, const jsi::Value& valu
   if (!object.isHostObject(runtime)) {
     return nullptr;
   }
-  auto host = runtime.getHostObject(object);
-  if (!host) {
+  if (!object.isHostObject<ReactElementHostObject>(runtime)) {
     return nullptr;
   }
-  auto typed = std::dynamic_pointer_cast<ReactElementHostObject>(host);
-  if (!typed) {
-    return nullptr;
-  }
-  return typed->element();
+  return object.getHostObject<ReactElementHostObject>(runtime)->element();
 }
 
 std::string numberToString(double number) {
   if (!std::isfinite(number)) {
     throw std::invalid_argument("Cannot convert non-finite number to string");
   }
-  std::ostringstream out;
-  out.setf(std::ios::fmtflags(0), std::ios::floatfield);
-  out << number;
-  return out.str();
+  return numberToText(number);
 }
 
 std::string coerceToString(jsi::Runtime& runtime, const jsi::Value& value) {
@@ -80,7 +73,7 @@ std::string coerceToString(jsi::Runtime& runtime, const jsi::Value& value) {
 std::optional<jsi::Value> takeProp(PropList& props, const std::string& name) {
   for (auto it = props.begin(); it != props.end(); ++it) {
     if (it->first == name) {
-      auto value = it->second;
+      auto value = std::move(it->second);
       props.erase(it);
       return value;
     }
@@ -154,23 +147,55 @@ void collectChildrenRecursive(jsi::Runtime& runtime, const jsi::Value& value, st
   throw std::invalid_argument("Unsupported child node in JSX runtime");
 }
 
+bool appendChildText(std::string& out, const Value& child) {
+  switch (child.kind) {
+    case ValueKind::String:
+      out.append(std::get<std::string>(child.payload));
+      return true;
+    case ValueKind::Number:
+      appendNumberText(out, std::get<double>(child.payload));
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Flattens the children props and merges adjacent string and number
+// children into one string child. A lone number child stays a number.
 std::vector<Value> extractChildren(jsi::Runtime& runtime, PropList& props) {
-  std::vector<Value> children;
+  std::vector<Value> flattened;
   for (auto it = props.begin(); it != props.end();) {
     if (it->first == "children") {
-      collectChildrenRecursive(runtime, it->second, children);
+      collectChildrenRecursive(runtime, it->second, flattened);
       it = props.erase(it);
     } else {
       ++it;
     }
   }
+
+  std::vector<Value> children;
+  children.reserve(flattened.size());
+  std::string text;
+  coalesceTextChildren(
+      flattened.begin(),
+      flattened.end(),
+      text,
+      appendChildText,
+      [&](const std::string& runText, auto runFirst, auto runLast) {
+        if (runLast - runFirst == 1) {
+          children.push_back(std::move(*runFirst));
+        } else {
+          children.push_back(Value::string(runText));
+        }
+      },
+      [&](Value& child) { children.push_back(std::move(child)); });
   return children;
 }
 
 ReactElementPtr createElement(
   jsi::Runtime& runtime,
   const jsi::Value& type,
-  const jsi::Value& props,
+  PropList props,
   std::optional<jsi::Value> key,
   std::optional<jsi::Value> ref,
   std::optional<SourceLocation> source) {
@@ -179,15 +204,15 @@ ReactElementPtr createElement(
   element->type = jsi::Value(runtime, type);
 
   if (type.isString()) {
-    element->debugType = type.getString(runtime).utf8(runtime);
+    element->hostType = type.getString(runtime).utf8(runtime);
   }
   
   if (key) {
     coerceToString(runtime, *key);
-    element->key = *key;
+    element->key = std::move(*key);
   }
   if (ref) {
-    element->ref = *ref;
+    element->ref = std::move(*ref);
   }
   element->children = extractChildren(runtime, props);
   removeReservedProps(props);
@@ -260,10 +285,53 @@ struct WasmMemoryBuilder {
 WasmReactValue encodeValue(jsi::Runtime& runtime, const Value& value, WasmMemoryBuilder& builder);
 uint32_t encodeElement(jsi::Runtime& runtime, const ReactElement& element, WasmMemoryBuilder& builder);
 
+// Encodes a style object as an Object value whose entries are the
+// primitive declarations, dropping null and undefined ones like props.
+WasmReactValue encodeStyleObject(jsi::Runtime& runtime, const jsi::Object& style, WasmMemoryBuilder& builder) {
+  jsi::Array names = style.getPropertyNames(runtime);
+  const size_t length = names.size(runtime);
+  std::vector<WasmReactProp> entries;
+  entries.reserve(length);
+  for (size_t i = 0; i < length; ++i) {
+    jsi::Value nameValue = names.getValueAtIndex(runtime, i);
+    if (!nameValue.isString()) {
+      continue;
+    }
+    jsi::String name = nameValue.getString(runtime);
+    auto converted = convertPropValue(runtime, style.getProperty(runtime, name));
+    if (converted.kind == ValueKind::Null || converted.kind == ValueKind::Undefined) {
+      continue;
+    }
+
+    WasmReactProp entry{};
+    entry.key_ptr = builder.internString(name.utf8(runtime));
+    entry.value = encodeValue(runtime, converted, builder);
+    entries.push_back(entry);
+  }
+
+  WasmReactObject object{};
+  object.props_count = static_cast<uint32_t>(entries.size());
+  object.props_ptr = builder.appendProps(entries);
+  WasmReactValue encoded{};
+  encoded.type = WasmValueType::Object;
+  encoded.data.ptrValue = builder.appendStruct(object);
+  return encoded;
+}
+
 std::vector<WasmReactProp> encodeProps(jsi::Runtime& runtime, const PropList& props, WasmMemoryBuilder& builder) {
   std::vector<WasmReactProp> encoded;
   encoded.reserve(props.size());
   for (const auto& [name, jsValue] : props) {
+    if (name == "style" && jsValue.isObject()) {
+      jsi::Object style = jsValue.getObject(runtime);
+      if (!style.isArray(runtime) && !style.isFunction(runtime)) {
+        WasmReactProp prop{};
+        prop.key_ptr = builder.internString(name);
+        prop.value = encodeStyleObject(runtime, style, builder);
+        encoded.push_back(prop);
+        continue;
+      }
+    }
     auto converted = convertPropValue(runtime, jsValue);
     if (converted.kind == ValueKind::Null || converted.kind == ValueKind::Undefined) {
       continue;
@@ -355,6 +423,7 @@ uint32_t encodeElement(jsi::Runtime& runtime, const ReactElement& element, WasmM
   encoded.props_ptr = propsOffset;
   encoded.children_count = static_cast<uint32_t>(childValues.size());
   encoded.children_ptr = childrenOffset;
+  encoded.subtree_hash = computeWasmSubtreeHash(builder.buffer.data(), encoded);
 
   return builder.appendStruct(encoded);
 }
@@ -17,6 +17,8 @@ namespace jsi = facebook::jsi;
 struct ReactElement;
 
 using ReactElementPtr = std::shared_ptr<ReactElement>;
+using PropEntry = std::pair<std::string, jsi::Value>;
+using PropList = std::vector<PropEntry>;
 
 struct SourceLocation {
   std::string fileName;
@@ -58,34 +60,32 @@ struct Value {
 
 struct ReactElement {
   jsi::Value type;
-  jsi::Value props;
-  jsi::Value children;
+  std::optional<std::string> hostType;
+  PropList props;
+  std::vector<Value> children;
   std::optional<jsi::Value> key;
   std::optional<jsi::Value> ref;
-  std::optional<jsi::Value> source;
   std::optional<SourceLocation> source;
-  std::optional<std::string> debugType;
-  std::optional<std::string> debugKey;
 };
 
 ReactElementPtr jsx(
     jsi::Runtime& runtime,
     const jsi::Value& type,
-    const jsi::Value& props,
+    PropList props,
     std::optional<jsi::Value> key = std::nullopt,
     std::optional<jsi::Value> ref = std::nullopt);
 
 ReactElementPtr jsxs(
     jsi::Runtime& runtime,
     const jsi::Value& type,
-    const jsi::Value& props,
+    PropList props,
     std::optional<jsi::Value> key = std::nullopt,
     std::optional<jsi::Value> ref = std::nullopt);
 
 ReactElementPtr jsxDEV(
     jsi::Runtime& runtime,
     const jsi::Value& type,
-    const jsi::Value& config,
+    PropList config,
     std::optional<jsi::Value> maybeKey = std::nullopt,
     SourceLocation source = {},
     std::optional<jsi::Value> ref = std::nullopt);
@@ -0,0 +1,63 @@
+#include "runtime/ReactRenderScratchArena.h"
+
+#include <algorithm>
+
+namespace react {
+namespace {
+
+constexpr std::size_t kInitialChunkSize = 16 * 1024;
+constexpr std::size_t kMaxChunkSize = 1024 * 1024;
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+void* RenderScratchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  while (chunkIndex_ < chunks_.size()) {
+    Chunk& chunk = chunks_[chunkIndex_];
+    const std::size_t offset = alignUp(chunkOffset_, alignment);
+    if (offset + bytes <= chunk.size) {
+      chunkOffset_ = offset + bytes;
+      return chunk.data.get() + offset;
+    }
+    ++chunkIndex_;
+    chunkOffset_ = 0;
+  }
+
+  // Child lists of wide parents can be far larger than the usual
+  // allocation, so chunks keep doubling up to a cap and oversized requests
+  // get a chunk of their own.
+  const std::size_t previousSize = chunks_.empty() ? 0 : chunks_.back().size;
+  std::size_t chunkSize = std::min(std::max(kInitialChunkSize, previousSize * 2), kMaxChunkSize);
+  chunkSize = std::max(chunkSize, alignUp(bytes, alignof(std::max_align_t)));
+
+  chunks_.push_back(Chunk{std::make_unique<std::byte[]>(chunkSize), chunkSize});
+  chunkIndex_ = chunks_.size() - 1;
+  chunkOffset_ = bytes;
+  return chunks_.back().data.get();
+}
+
+void RenderScratchArena::reset() {
+  chunkIndex_ = 0;
+  chunkOffset_ = 0;
+}
+
+std::size_t RenderScratchArena::bytesInUse() const {
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < chunkIndex_ && i < chunks_.size(); ++i) {
+    total += chunks_[i].size;
+  }
+  return total + chunkOffset_;
+}
+
+std::size_t RenderScratchArena::bytesReserved() const {
+  std::size_t total = 0;
+  for (const Chunk& chunk : chunks_) {
+    total += chunk.size;
+  }
+  return total;
+}
+
+} // namespace react
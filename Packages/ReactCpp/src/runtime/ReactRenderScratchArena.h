@@ -0,0 +1,45 @@
+#pragma once
+
+// Per-render scratch memory for reconciler temporaries: flattened child
+// lists, key maps, placement bookkeeping and update payloads. Deallocation is
+// a no-op; ReactRuntime calls reset() once a render has committed, which
+// rewinds to the first chunk and keeps every chunk, so renders of a similar
+// size stop reaching the heap after the first one.
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace react {
+
+class RenderScratchArena final : public std::pmr::memory_resource {
+public:
+  RenderScratchArena() = default;
+  RenderScratchArena(const RenderScratchArena&) = delete;
+  RenderScratchArena& operator=(const RenderScratchArena&) = delete;
+
+  // Invalidates everything allocated since the previous reset.
+  void reset();
+
+  std::size_t bytesInUse() const;
+  std::size_t bytesReserved() const;
+
+private:
+  struct Chunk {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t size{0};
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::vector<Chunk> chunks_{};
+  std::size_t chunkIndex_{0};
+  std::size_t chunkOffset_{0};
+};
+
+} // namespace react
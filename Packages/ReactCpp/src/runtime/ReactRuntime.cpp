@@ -3,254 +3,470 @@
 #include "jsi/jsi.h"
 #include "react-dom/client/ReactDOMComponent.h"
 #include "runtime/ReactHostInterface.h"
+#include "runtime/ReactTextChildren.h"
+#include "runtime/ReactUpdatePayload.h"
 #include "runtime/ReactWasmBridge.h"
 #include "runtime/ReactWasmLayout.h"
 
 #include <algorithm>
 #include <chrono>
-#include <cmath>
-#include <sstream>
+#include <iterator>
+#include <memory_resource>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace {
 
-using facebook::jsi::Array;
 using facebook::jsi::Object;
 using facebook::jsi::Runtime;
 using facebook::jsi::Value;
 
-std::string numberToString(double value) {
-  if (std::isnan(value) || !std::isfinite(value)) {
-    return std::string{};
-  }
-
-  if (std::floor(value) == value) {
-    std::ostringstream oss;
-    oss << static_cast<long long>(value);
-    return oss.str();
-  }
+using ScratchInstanceList = std::pmr::vector<std::shared_ptr<react::ReactDOMInstance>>;
 
-  std::ostringstream oss;
-  oss << value;
-  return oss.str();
+// The reconciler only manages the ReactDOMComponent instances, which it
+// tells apart by node kind rather than by casting.
+react::ReactDOMComponent* asComponent(const std::shared_ptr<react::ReactDOMInstance>& instance) {
+  return instance && instance->nodeKind() != react::HostNodeKind::Opaque
+      ? static_cast<react::ReactDOMComponent*>(instance.get())
+      : nullptr;
 }
 
-std::string valueToString(Runtime& rt, const Value& value) {
-  if (value.isString()) {
-    return value.getString(rt).utf8(rt);
-  }
+using react::WasmReactElement;
+using react::WasmReactProp;
+using react::WasmReactValue;
+using react::WasmValueType;
 
-  if (value.isNumber()) {
-    return numberToString(value.getNumber());
+// Strings in the layout are null-terminated in place, so views into the
+// buffer are also valid C strings for JSI calls.
+std::string_view layoutString(uint32_t baseOffset, uint32_t offset) {
+  if (offset == 0) {
+    return std::string_view{};
   }
-
-  return std::string{};
+  return std::string_view(react::getPointer<const char>(baseOffset, offset));
 }
 
-void collectChildValues(Runtime& rt, const Value& value, std::vector<Value>& out) {
-  if (value.isUndefined() || value.isNull() || value.isBool()) {
-    return;
-  }
-
-  if (value.isString() || value.isNumber()) {
-    out.emplace_back(rt, value);
-    return;
+// Appends the text of a string or number child to `out`; returns false for
+// any other child.
+bool appendLayoutText(std::string& out, uint32_t baseOffset, const WasmReactValue& value) {
+  switch (value.type) {
+    case WasmValueType::String:
+      out.append(layoutString(baseOffset, value.data.ptrValue));
+      return true;
+    case WasmValueType::Number:
+      react::appendNumberText(out, value.data.numberValue);
+      return true;
+    default:
+      return false;
   }
+}
 
-  if (!value.isObject()) {
+// Calls `fn(name, value)` for each named prop of `element` except children,
+// which the layout stores separately.
+template <typename Fn>
+void forEachLayoutProp(uint32_t baseOffset, const WasmReactElement& element, Fn&& fn) {
+  if (element.props_count == 0 || element.props_ptr == 0) {
     return;
   }
-
-  Object obj = value.getObject(rt);
-  if (obj.isArray(rt)) {
-    Array array = obj.asArray(rt);
-    const size_t length = array.size(rt);
-    for (size_t i = 0; i < length; ++i) {
-      Value entry = array.getValueAtIndex(rt, i);
-      collectChildValues(rt, entry, out);
+  const auto* props = react::getPointer<const WasmReactProp>(baseOffset, element.props_ptr);
+  for (uint32_t i = 0; i < element.props_count; ++i) {
+    if (props[i].key_ptr == 0) {
+      continue;
     }
-    return;
-  }
-
-  if (obj.hasProperty(rt, "type")) {
-    out.emplace_back(rt, value);
+    const std::string_view name = layoutString(baseOffset, props[i].key_ptr);
+    if (name == "children") {
+      continue;
+    }
+    fn(name, props[i].value);
   }
 }
 
-struct ElementExtraction {
-  std::string type;
-  std::string key;
-  Object propsObject;
-  std::unordered_map<std::string, Value> propsMap;
-  Value children;
-};
-
-ElementExtraction extractElement(Runtime& rt, const Object& element) {
-  ElementExtraction extraction{std::string{}, std::string{}, Object(rt), std::unordered_map<std::string, Value>{}, Value::undefined()};
-
-  Value typeValue = element.getProperty(rt, "type");
-  if (!typeValue.isString()) {
-    return extraction;
-  }
-  extraction.type = typeValue.getString(rt).utf8(rt);
-
-  Value keyValue = element.getProperty(rt, "key");
-  if (keyValue.isString()) {
-    extraction.key = keyValue.getString(rt).utf8(rt);
-  }
-
-  Value propsValue = element.getProperty(rt, "props");
-  if (propsValue.isObject()) {
-    Object propsObject = propsValue.getObject(rt);
-    Array names = propsObject.getPropertyNames(rt);
-    const size_t length = names.size(rt);
-    for (size_t i = 0; i < length; ++i) {
-      Value nameValue = names.getValueAtIndex(rt, i);
-      if (!nameValue.isString()) {
-        continue;
-      }
-
-      const std::string propName = nameValue.getString(rt).utf8(rt);
-      Value propEntry = propsObject.getProperty(rt, propName.c_str());
-      if (propName == "children") {
-        extraction.children = Value(rt, propEntry);
-        continue;
-      }
-
-      extraction.propsObject.setProperty(rt, propName.c_str(), propEntry);
-      extraction.propsMap.emplace(propName, Value(rt, propEntry));
+// Flattens child values the way React flattens nested child arrays, dropping
+// null, undefined and booleans.
+void collectLayoutChildren(
+    uint32_t baseOffset,
+    const WasmReactValue* items,
+    uint32_t count,
+    std::pmr::vector<const WasmReactValue*>& out) {
+  for (uint32_t i = 0; i < count; ++i) {
+    const WasmReactValue& item = items[i];
+    switch (item.type) {
+      case WasmValueType::String:
+      case WasmValueType::Number:
+      case WasmValueType::Element:
+        out.push_back(&item);
+        break;
+      case WasmValueType::Array:
+        if (item.data.ptrValue != 0) {
+          const auto* array = react::getPointer<const react::WasmReactArray>(baseOffset, item.data.ptrValue);
+          if (array->length > 0 && array->items_ptr != 0) {
+            collectLayoutChildren(
+                baseOffset, react::getPointer<const WasmReactValue>(baseOffset, array->items_ptr), array->length, out);
+          }
+        }
+        break;
+      default:
+        break;
     }
   }
-
-  return extraction;
 }
 
-Object createPropsObject(Runtime& rt, const std::unordered_map<std::string, Value>& propsMap) {
+Object layoutPropsToJsi(Runtime& rt, uint32_t baseOffset, const WasmReactElement& element) {
   Object props(rt);
-  for (const auto& entry : propsMap) {
-    props.setProperty(rt, entry.first.c_str(), Value(rt, entry.second));
-  }
+  forEachLayoutProp(baseOffset, element, [&](std::string_view name, const WasmReactValue& value) {
+    props.setProperty(rt, name.data(), react::convertWasmLayoutToJsi(rt, baseOffset, value));
+  });
   return props;
 }
 
-bool valuesEqual(Runtime& rt, const Value& a, const Value& b) {
-  if (a.isUndefined() && b.isUndefined()) {
-    return true;
-  }
-  if (a.isNull() && b.isNull()) {
-    return true;
-  }
-  if (a.isBool() && b.isBool()) {
-    return a.getBool() == b.getBool();
-  }
-  if (a.isNumber() && b.isNumber()) {
-    return a.getNumber() == b.getNumber();
-  }
-  if (a.isString() && b.isString()) {
-    return a.getString(rt).utf8(rt) == b.getString(rt).utf8(rt);
+// Strings compare against the component's native copy of the previous
+// value instead of reading it back out of the runtime.
+bool layoutValueEquals(
+    uint32_t baseOffset,
+    const WasmReactValue& next,
+    const react::ReactDOMComponent& component,
+    react::PropAtom atom,
+    const Value& previous) {
+  switch (next.type) {
+    case WasmValueType::Null:
+      return previous.isNull();
+    case WasmValueType::Undefined:
+      return previous.isUndefined();
+    case WasmValueType::Boolean:
+      return previous.isBool() && previous.getBool() == next.data.boolValue;
+    case WasmValueType::Number:
+      return previous.isNumber() && previous.getNumber() == next.data.numberValue;
+    case WasmValueType::String: {
+      const std::string* previousText = component.getStringProp(atom);
+      return previousText != nullptr && *previousText == layoutString(baseOffset, next.data.ptrValue);
+    }
+    default:
+      return false;
   }
-  return false;
 }
 
-bool computeUpdatePayload(
-    Runtime& rt,
-    const std::unordered_map<std::string, Value>& prevProps,
-    const std::unordered_map<std::string, Value>& nextProps,
-    Object& payload) {
-  bool hasChanges = false;
+react::UpdatePayloadValue layoutPayloadValue(uint32_t baseOffset, const WasmReactValue& value) {
+  switch (value.type) {
+    case WasmValueType::Null:
+      return react::UpdatePayloadValue::null();
+    case WasmValueType::Boolean:
+      return react::UpdatePayloadValue::boolean(value.data.boolValue);
+    case WasmValueType::Number:
+      return react::UpdatePayloadValue::number(value.data.numberValue);
+    case WasmValueType::String:
+      return react::UpdatePayloadValue::string(layoutString(baseOffset, value.data.ptrValue));
+    default:
+      return react::UpdatePayloadValue{};
+  }
+}
 
-  Object attributes(rt);
-  bool hasAttributeChanges = false;
+// Appends style ops taking the committed styles to the `style` object
+// `next`. Both sides are sorted by atom and merged, as the props diff merges
+// two style objects, and a property only changes when its DOM text does.
+void diffLayoutStyle(
+    uint32_t baseOffset,
+    const WasmReactValue& next,
+    const react::ReactDOMComponent& previous,
+    const Value* previousStyle,
+    react::UpdatePayload& payload) {
+  using NextDeclaration = std::pair<react::PropAtom, const WasmReactProp*>;
+  using PreviousDeclaration = std::pair<react::PropAtom, const std::string*>;
+  std::pmr::memory_resource* const scratch = payload.ops.get_allocator().resource();
+
+  // A string style has no committed declarations to patch, so it is removed
+  // and the object applied in full.
+  if (previousStyle != nullptr && !previousStyle->isObject()) {
+    payload.remove(react::kStyleAtom, react::propAtomName(react::kStyleAtom));
+  }
 
-  for (const auto& [key, nextValue] : nextProps) {
-    auto it = prevProps.find(key);
-    if (it == prevProps.end() || !valuesEqual(rt, it->second, nextValue)) {
-      attributes.setProperty(rt, key.c_str(), Value(rt, nextValue));
-      hasAttributeChanges = true;
-      hasChanges = true;
+  const auto* object = react::getPointer<const react::WasmReactObject>(baseOffset, next.data.ptrValue);
+  std::pmr::vector<NextDeclaration> nextDeclarations(scratch);
+  if (object->props_count > 0 && object->props_ptr != 0) {
+    const auto* entries = react::getPointer<const WasmReactProp>(baseOffset, object->props_ptr);
+    nextDeclarations.reserve(object->props_count);
+    for (uint32_t i = 0; i < object->props_count; ++i) {
+      if (entries[i].key_ptr != 0) {
+        nextDeclarations.emplace_back(react::internPropName(layoutString(baseOffset, entries[i].key_ptr)), &entries[i]);
+      }
     }
   }
 
-  if (hasAttributeChanges) {
-    payload.setProperty(rt, "attributes", attributes);
+  const react::ReactDOMStyleMap& styles = previous.getStyles();
+  std::pmr::vector<PreviousDeclaration> previousDeclarations(scratch);
+  previousDeclarations.reserve(styles.size());
+  for (const auto& [atom, text] : styles) {
+    previousDeclarations.emplace_back(atom, &text);
   }
 
-  std::vector<std::string> removedKeys;
-  removedKeys.reserve(prevProps.size());
-  for (const auto& [key, prevValue] : prevProps) {
-    (void)prevValue;
-    if (nextProps.find(key) == nextProps.end()) {
-      removedKeys.push_back(key);
-    }
-  }
+  const auto byAtom = [](const auto& left, const auto& right) { return left.first < right.first; };
+  std::sort(nextDeclarations.begin(), nextDeclarations.end(), byAtom);
+  std::sort(previousDeclarations.begin(), previousDeclarations.end(), byAtom);
+  react::mergeSortedKeys(
+      previousDeclarations.begin(),
+      previousDeclarations.end(),
+      nextDeclarations.begin(),
+      nextDeclarations.end(),
+      [](const PreviousDeclaration& previous, const NextDeclaration& next) {
+        return previous.first < next.first ? -1 : next.first < previous.first ? 1 : 0;
+      },
+      [&](const PreviousDeclaration& removed) {
+        payload.removeStyle(removed.first, react::propAtomName(removed.first));
+      },
+      [&](const PreviousDeclaration* previous, const NextDeclaration& next) {
+        const std::string_view name = layoutString(baseOffset, next.second->key_ptr);
+        const react::UpdatePayloadValue value = layoutPayloadValue(baseOffset, next.second->value);
+        const std::string text = react::updatePayloadStyleText(name, value);
+        if (previous != nullptr && *previous->second == text) {
+          return;
+        }
+        if (text.empty()) {
+          if (previous != nullptr) {
+            payload.removeStyle(next.first, name);
+          }
+          return;
+        }
+        payload.setStyle(next.first, name, value);
+      });
+}
 
-  if (!removedKeys.empty()) {
-    Array removedArray(rt, removedKeys.size());
-    for (size_t i = 0; i < removedKeys.size(); ++i) {
-      removedArray.setValueAtIndex(rt, i, facebook::jsi::String::createFromUtf8(rt, removedKeys[i]));
+// Appends the prop changes from `prevProps` to `element` to `payload`. Set
+// ops view the layout buffer and remove ops view the atom names. A `style`
+// object is diffed per CSS property by diffLayoutStyle.
+bool computeUpdatePayload(
+    uint32_t baseOffset,
+    const WasmReactElement& element,
+    const react::ReactDOMComponent& previous,
+    react::UpdatePayload& payload) {
+  const react::ReactDOMPropMap& prevProps = previous.getProps();
+  std::pmr::vector<react::PropAtom> nextAtoms(payload.ops.get_allocator().resource());
+  nextAtoms.reserve(element.props_count);
+  size_t retainedProps = 0;
+
+  forEachLayoutProp(baseOffset, element, [&](std::string_view nextName, const WasmReactValue& nextValue) {
+    const react::PropAtom atom = react::internPropName(nextName);
+    nextAtoms.push_back(atom);
+    auto it = prevProps.find(atom);
+    if (atom == react::kStyleAtom && nextValue.type == WasmValueType::Object) {
+      const bool retained = it != prevProps.end();
+      retainedProps += retained ? 1 : 0;
+      diffLayoutStyle(baseOffset, nextValue, previous, retained ? &it->second : nullptr, payload);
+      return;
     }
-    payload.setProperty(rt, "removedAttributes", removedArray);
-    hasChanges = true;
+    if (it != prevProps.end()) {
+      ++retainedProps;
+      if (layoutValueEquals(baseOffset, nextValue, previous, atom, it->second)) {
+        return;
+      }
+    }
+    payload.set(atom, nextName, layoutPayloadValue(baseOffset, nextValue));
+  });
+
+  if (retainedProps < prevProps.size()) {
+    // Find the dropped props by merging both sides sorted by atom, as the
+    // props diff does, rather than searching the next props for each one.
+    std::pmr::vector<react::PropAtom> previousAtoms(payload.ops.get_allocator().resource());
+    previousAtoms.reserve(prevProps.size());
+    for (const auto& entry : prevProps) {
+      previousAtoms.push_back(entry.first);
+    }
+    std::sort(previousAtoms.begin(), previousAtoms.end());
+    std::sort(nextAtoms.begin(), nextAtoms.end());
+    react::mergeSortedKeys(
+        previousAtoms.begin(),
+        previousAtoms.end(),
+        nextAtoms.begin(),
+        nextAtoms.end(),
+        [](react::PropAtom previous, react::PropAtom next) { return previous < next ? -1 : next < previous ? 1 : 0; },
+        [&](react::PropAtom removed) { payload.remove(removed, react::propAtomName(removed)); },
+        [](const react::PropAtom*, react::PropAtom) {});
   }
 
-  return hasChanges;
+  return !payload.empty();
 }
 
 void reconcileChildren(
     react::ReactRuntime& runtime,
     Runtime& rt,
     const std::shared_ptr<react::ReactDOMInstance>& parent,
-    const Value& childrenValue);
+    uint32_t baseOffset,
+    const WasmReactValue* items,
+    uint32_t count);
+
+void reconcileElementChildren(
+    react::ReactRuntime& runtime,
+    Runtime& rt,
+    const std::shared_ptr<react::ReactDOMInstance>& instance,
+    uint32_t baseOffset,
+    const WasmReactElement& element) {
+  const WasmReactValue* children = element.children_count > 0 && element.children_ptr != 0
+      ? react::getPointer<const WasmReactValue>(baseOffset, element.children_ptr)
+      : nullptr;
+  reconcileChildren(runtime, rt, instance, baseOffset, children, children != nullptr ? element.children_count : 0);
+}
 
+// Creates or updates the host instance for `element`. A JSI props object is
+// only built for createInstance, updates commit a native payload, and a subtree whose hash matches the last committed one is skipped entirely.
 std::shared_ptr<react::ReactDOMInstance> mountElement(
     react::ReactRuntime& runtime,
     Runtime& rt,
-    const ElementExtraction& extraction,
+    uint32_t baseOffset,
+    const WasmReactElement& element,
+    std::string_view type,
+    std::string_view key,
     const std::shared_ptr<react::ReactDOMInstance>& existing) {
-  if (extraction.type.empty()) {
-    return nullptr;
-  }
-
   std::shared_ptr<react::ReactDOMInstance> instance = existing;
-  auto existingComponent = std::dynamic_pointer_cast<react::ReactDOMComponent>(existing);
+  react::ReactDOMComponent* const existingComponent = asComponent(existing);
+  const uint64_t subtreeHash = element.subtree_hash;
+  auto& fingerprintStats = runtime.propsFingerprintStats();
+
+  if (!instance || !existingComponent || existingComponent->getType() != type) {
+    instance = runtime.createInstance(rt, type, layoutPropsToJsi(rt, baseOffset, element));
+    instance->setKey(std::string(key));
+    instance->propsFingerprint = react::computeWasmPropsFingerprint(baseOffset, element);
+    reconcileElementChildren(runtime, rt, instance, baseOffset, element);
+    instance->subtreeHash = subtreeHash;
+    return instance;
+  }
 
-  if (!instance || !existingComponent || existingComponent->getType() != extraction.type) {
-    instance = runtime.createInstance(rt, extraction.type, extraction.propsObject);
-    instance->setKey(extraction.key);
-    reconcileChildren(runtime, rt, instance, extraction.children);
+  if (subtreeHash != 0 && instance->subtreeHash == subtreeHash) {
+    ++fingerprintStats.skippedSubtrees;
     return instance;
   }
 
-  instance->setKey(extraction.key);
+  const uint64_t propsFingerprint = react::computeWasmPropsFingerprint(baseOffset, element);
+  if (instance->getKey() != key) {
+    instance->setKey(std::string(key));
+  }
 
   const auto& previousProps = existingComponent->getProps();
-  Object payload(rt);
-  if (computeUpdatePayload(rt, previousProps, extraction.propsMap, payload)) {
-    Object oldProps = createPropsObject(rt, previousProps);
-    runtime.commitUpdate(instance, oldProps, extraction.propsObject, payload);
+  if (propsFingerprint != 0 && instance->propsFingerprint == propsFingerprint) {
+    size_t propCount = 0;
+    forEachLayoutProp(baseOffset, element, [&](std::string_view, const WasmReactValue&) { ++propCount; });
+    ++fingerprintStats.matchedElements;
+    fingerprintStats.skippedPropComparisons += propCount + previousProps.size();
+  } else {
+    ++fingerprintStats.diffedElements;
+    react::UpdatePayload payload(&runtime.renderScratchArena());
+    if (computeUpdatePayload(baseOffset, element, *existingComponent, payload)) {
+      runtime.commitUpdate(instance, payload);
+    }
+    instance->propsFingerprint = propsFingerprint;
   }
 
-  reconcileChildren(runtime, rt, instance, extraction.children);
+  reconcileElementChildren(runtime, rt, instance, baseOffset, element);
+  instance->subtreeHash = subtreeHash;
   return instance;
 }
 
-void removeAllChildren(
+constexpr size_t kNewChild = static_cast<size_t>(-1);
+
+// Marks one longest increasing run of previous positions in `sources`
+// (kNewChild for children created by this render). Those children already
+// sit in the right relative order; every other child needs one host move.
+std::pmr::vector<bool> markStableChildren(const std::pmr::vector<size_t>& sources) {
+  std::pmr::memory_resource* const scratch = sources.get_allocator().resource();
+  std::pmr::vector<size_t> tails(scratch);
+  std::pmr::vector<size_t> predecessors(sources.size(), kNewChild, scratch);
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (sources[i] == kNewChild) {
+      continue;
+    }
+    auto it = std::lower_bound(tails.begin(), tails.end(), sources[i], [&](size_t tail, size_t source) {
+      return sources[tail] < source;
+    });
+    if (it != tails.begin()) {
+      predecessors[i] = *(it - 1);
+    }
+    if (it == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *it = i;
+    }
+  }
+
+  std::pmr::vector<bool> stable(sources.size(), false, scratch);
+  for (size_t i = tails.empty() ? kNewChild : tails.back(); i != kNewChild; i = predecessors[i]) {
+    stable[i] = true;
+  }
+  return stable;
+}
+
+// Moves and inserts `desired` into place under `parent`, whose children are
+// the reused subset of `desired` in their previous order. Skips the common
+// head and tail, then leaves the longest already-ordered run of the middle
+// in place and inserts the rest right to left before their next sibling.
+void placeChildren(
     react::ReactRuntime& runtime,
-    const std::shared_ptr<react::ReactDOMInstance>& parent) {
-  if (!parent) {
+    const std::shared_ptr<react::ReactDOMInstance>& parent,
+    const ScratchInstanceList& previous,
+    const ScratchInstanceList& desired) {
+  size_t head = 0;
+  while (head < desired.size() && head < previous.size() && desired[head] == previous[head]) {
+    ++head;
+  }
+  size_t desiredEnd = desired.size();
+  size_t previousEnd = previous.size();
+  while (desiredEnd > head && previousEnd > head && desired[desiredEnd - 1] == previous[previousEnd - 1]) {
+    --desiredEnd;
+    --previousEnd;
+  }
+  if (head == desiredEnd) {
     return;
   }
 
-  auto component = std::dynamic_pointer_cast<react::ReactDOMComponent>(parent);
-  if (!component) {
-    return;
+  std::pmr::memory_resource* const scratch = &runtime.renderScratchArena();
+  std::pmr::unordered_map<const react::ReactDOMInstance*, size_t> previousIndex(scratch);
+  previousIndex.reserve(previousEnd - head);
+  for (size_t i = head; i < previousEnd; ++i) {
+    previousIndex.emplace(previous[i].get(), i);
   }
 
-  auto existingChildren = component->children;
-  for (const auto& child : existingChildren) {
-    runtime.removeChild(parent, child);
+  std::pmr::vector<size_t> sources(desiredEnd - head, kNewChild, scratch);
+  for (size_t i = head; i < desiredEnd; ++i) {
+    auto it = previousIndex.find(desired[i].get());
+    if (it != previousIndex.end()) {
+      sources[i - head] = it->second;
+    }
+  }
+
+  const std::pmr::vector<bool> stable = markStableChildren(sources);
+  for (size_t end = desiredEnd; end > head;) {
+    if (stable[end - 1 - head]) {
+      --end;
+      continue;
+    }
+    // Place each run of unstable children with one host call.
+    size_t begin = end - 1;
+    while (begin > head && !stable[begin - 1 - head]) {
+      --begin;
+    }
+    const bool allNew = std::all_of(
+        sources.begin() + static_cast<std::ptrdiff_t>(begin - head),
+        sources.begin() + static_cast<std::ptrdiff_t>(end - head),
+        [](size_t source) { return source == kNewChild; });
+    const react::ReactDOMInstanceIterator first = desired.data() + begin;
+    const react::ReactDOMInstanceIterator last = desired.data() + end;
+
+    if (end < desired.size()) {
+      if (end - begin == 1) {
+        runtime.insertBefore(parent, *first, desired[end]);
+      } else {
+        runtime.moveChildrenBefore(parent, first, last, desired[end]);
+      }
+    } else if (allNew) {
+      if (end - begin == 1) {
+        runtime.appendChild(parent, *first);
+      } else {
+        runtime.appendChildren(parent, first, last);
+      }
+    } else if (end - begin == 1) {
+      // appendChild ignores children that are already attached.
+      runtime.insertBefore(parent, *first, nullptr);
+    } else {
+      runtime.moveChildrenBefore(parent, first, last, nullptr);
+    }
+    end = begin;
   }
 }
 
@@ -258,150 +474,164 @@ void reconcileChildren(
     react::ReactRuntime& runtime,
     Runtime& rt,
     const std::shared_ptr<react::ReactDOMInstance>& parent,
-    const Value& childrenValue) {
-  auto parentComponent = std::dynamic_pointer_cast<react::ReactDOMComponent>(parent);
-  if (!parentComponent || parentComponent->isTextInstance()) {
+    uint32_t baseOffset,
+    const WasmReactValue* items,
+    uint32_t count) {
+  if (!parent || parent->nodeKind() != react::HostNodeKind::Element) {
     return;
   }
 
-  std::vector<Value> desiredValues;
-  collectChildValues(rt, childrenValue, desiredValues);
+  // Every temporary below lives in the render's scratch arena.
+  std::pmr::memory_resource* const scratch = &runtime.renderScratchArena();
+  std::pmr::vector<const WasmReactValue*> desiredValues(scratch);
+  collectLayoutChildren(baseOffset, items, count, desiredValues);
 
-  std::unordered_map<std::string, std::shared_ptr<react::ReactDOMInstance>> keyedExisting;
-  std::vector<std::shared_ptr<react::ReactDOMInstance>> unkeyedElements;
-  std::vector<std::shared_ptr<react::ReactDOMInstance>> unkeyedText;
+  // Unkeyed elements match the first unused previous element of their type.
+  struct UnkeyedMatches {
+    ScratchInstanceList instances;
+    size_t next{0};
+  };
 
-  for (const auto& child : parentComponent->children) {
-    auto component = std::dynamic_pointer_cast<react::ReactDOMComponent>(child);
-    if (!component) {
+  // Keys and types view strings owned by the previous children, which
+  // outlive this pass.
+  std::pmr::unordered_map<std::string_view, std::shared_ptr<react::ReactDOMInstance>> keyedExisting(scratch);
+  std::pmr::unordered_map<std::string_view, UnkeyedMatches> unkeyedElements(scratch);
+  ScratchInstanceList unkeyedText(scratch);
+  ScratchInstanceList staleChildren(scratch);
+  keyedExisting.reserve(parent->children.size());
+
+  for (const auto& child : parent->children) {
+    react::ReactDOMComponent* const component = asComponent(child);
+    if (component == nullptr) {
       continue;
     }
 
     const std::string& childKey = child->getKey();
     if (!childKey.empty()) {
-      keyedExisting.emplace(childKey, child);
+      if (!keyedExisting.emplace(childKey, child).second) {
+        staleChildren.push_back(child);
+      }
       continue;
     }
 
     if (component->isTextInstance()) {
       unkeyedText.push_back(child);
     } else {
-      unkeyedElements.push_back(child);
+      auto matchesIt = unkeyedElements.find(component->getType());
+      if (matchesIt == unkeyedElements.end()) {
+        matchesIt = unkeyedElements.emplace(component->getType(), UnkeyedMatches{ScratchInstanceList(scratch)}).first;
+      }
+      matchesIt->second.instances.push_back(child);
     }
   }
 
-  struct DesiredChild {
-    std::shared_ptr<react::ReactDOMInstance> instance;
-  };
-
-  std::vector<DesiredChild> desiredChildren;
+  ScratchInstanceList desiredChildren(scratch);
   desiredChildren.reserve(desiredValues.size());
-
-  for (const auto& childValue : desiredValues) {
-    if (childValue.isString() || childValue.isNumber()) {
-      const std::string text = valueToString(rt, childValue);
-      std::shared_ptr<react::ReactDOMInstance> existingText;
-      if (!unkeyedText.empty()) {
-        existingText = unkeyedText.front();
-        unkeyedText.erase(unkeyedText.begin());
+  size_t nextText = 0;
+
+  // Each run of adjacent string and number children becomes one text child.
+  auto placeText = [&](const std::string& text, auto, auto) {
+    if (nextText < unkeyedText.size()) {
+      const auto& existingText = unkeyedText[nextText++];
+      if (existingText->getTextContent() != text) {
+        runtime.commitTextUpdate(existingText, existingText->getTextContent(), text);
       }
-
-      if (existingText) {
-        auto textComponent = std::dynamic_pointer_cast<react::ReactDOMComponent>(existingText);
-        if (textComponent && textComponent->getTextContent() != text) {
-          runtime.commitTextUpdate(existingText, textComponent->getTextContent(), text);
-        }
-        desiredChildren.push_back({existingText});
-      } else {
-        auto textInstance = runtime.createTextInstance(rt, text);
-        desiredChildren.push_back({textInstance});
-      }
-      continue;
-    }
-
-    if (!childValue.isObject()) {
-      continue;
+      desiredChildren.push_back(existingText);
+    } else {
+      desiredChildren.push_back(runtime.createTextInstance(rt, text));
     }
+  };
 
-    Object childObject = childValue.getObject(rt);
-    if (!childObject.hasProperty(rt, "type")) {
-      continue;
+  auto placeElement = [&](const WasmReactValue* childValue) {
+    const auto& element = *react::getPointer<const WasmReactElement>(baseOffset, childValue->data.ptrValue);
+    const std::string_view type = layoutString(baseOffset, element.type_name_ptr);
+    if (type.empty()) {
+      return;
     }
-
-    ElementExtraction extraction = extractElement(rt, childObject);
+    const std::string_view key = layoutString(baseOffset, element.key_ptr);
     std::shared_ptr<react::ReactDOMInstance> existingMatch;
 
-    if (!extraction.key.empty()) {
-      auto keyedIt = keyedExisting.find(extraction.key);
+    if (!key.empty()) {
+      auto keyedIt = keyedExisting.find(key);
       if (keyedIt != keyedExisting.end()) {
-        existingMatch = keyedIt->second;
+        existingMatch = std::move(keyedIt->second);
         keyedExisting.erase(keyedIt);
       }
     }
 
     if (!existingMatch) {
-      auto matchIt = std::find_if(
-          unkeyedElements.begin(),
-          unkeyedElements.end(),
-          [&](const std::shared_ptr<react::ReactDOMInstance>& candidate) {
-            auto candidateComponent = std::dynamic_pointer_cast<react::ReactDOMComponent>(candidate);
-            return candidateComponent && !candidateComponent->isTextInstance() && candidateComponent->getType() == extraction.type;
-          });
-      if (matchIt != unkeyedElements.end()) {
-        existingMatch = *matchIt;
-        unkeyedElements.erase(matchIt);
+      auto unkeyedIt = unkeyedElements.find(type);
+      if (unkeyedIt != unkeyedElements.end() && unkeyedIt->second.next < unkeyedIt->second.instances.size()) {
+        existingMatch = unkeyedIt->second.instances[unkeyedIt->second.next++];
       }
     }
 
-    auto mounted = mountElement(runtime, rt, extraction, existingMatch);
-    if (mounted) {
-      desiredChildren.push_back({mounted});
+    auto mounted = mountElement(runtime, rt, baseOffset, element, type, key, existingMatch);
+    if (existingMatch && mounted != existingMatch) {
+      staleChildren.push_back(existingMatch);
     }
-  }
+    desiredChildren.push_back(std::move(mounted));
+  };
 
-  // Remove any remaining children that were not reused.
+  std::string text;
+  react::coalesceTextChildren(
+      desiredValues.begin(),
+      desiredValues.end(),
+      text,
+      [&](std::string& out, const WasmReactValue* childValue) { return appendLayoutText(out, baseOffset, *childValue); },
+      placeText,
+      placeElement);
+
+  // Collect the children that were not reused. They are moved out of the
+  // match tables so the host instance pool sees them as unreferenced.
   for (auto& [_, child] : keyedExisting) {
-    runtime.removeChild(parent, child);
+    staleChildren.push_back(std::move(child));
   }
-  for (auto& child : unkeyedElements) {
-    runtime.removeChild(parent, child);
-  }
-  for (auto& child : unkeyedText) {
-    runtime.removeChild(parent, child);
+  for (auto& [_, matches] : unkeyedElements) {
+    staleChildren.insert(
+        staleChildren.end(),
+        std::make_move_iterator(matches.instances.begin() + static_cast<std::ptrdiff_t>(matches.next)),
+        std::make_move_iterator(matches.instances.end()));
   }
-
-  for (size_t index = 0; index < desiredChildren.size(); ++index) {
-    auto& entry = desiredChildren[index];
-    auto child = entry.instance;
-    if (!child) {
-      continue;
-    }
-
-    auto currentChildren = parentComponent->children;
-    std::shared_ptr<react::ReactDOMInstance> beforeChild;
-    if (index < currentChildren.size()) {
-      beforeChild = currentChildren[index];
+  staleChildren.insert(
+      staleChildren.end(),
+      std::make_move_iterator(unkeyedText.begin() + static_cast<std::ptrdiff_t>(nextText)),
+      std::make_move_iterator(unkeyedText.end()));
+
+  auto releaseStaleChildren = [&] {
+    for (auto& child : staleChildren) {
+      runtime.releaseInstance(std::move(child));
     }
+  };
 
-    auto attachedParent = child->parent.lock();
-    const bool isAttachedToParent = attachedParent && attachedParent.get() == parent.get();
-
-    if (!isAttachedToParent) {
-      if (beforeChild) {
-        runtime.insertBefore(parent, child, beforeChild);
-      } else {
-        runtime.appendChild(parent, child);
-      }
-      continue;
+  // Clearing, mounting into an empty parent and replacing every child are
+  // each a single host call.
+  const auto& currentChildren = parent->children;
+  if (desiredChildren.empty()) {
+    if (!currentChildren.empty()) {
+      runtime.removeAllChildren(parent);
     }
-
-    currentChildren = parentComponent->children;
-    if (index < currentChildren.size() && currentChildren[index].get() == child.get()) {
-      continue;
+    releaseStaleChildren();
+    return;
+  }
+  if (staleChildren.size() == currentChildren.size()) {
+    if (currentChildren.empty()) {
+      runtime.appendChildren(parent, desiredChildren.data(), desiredChildren.data() + desiredChildren.size());
+    } else {
+      runtime.replaceChildren(parent, desiredChildren.data(), desiredChildren.data() + desiredChildren.size());
     }
+    releaseStaleChildren();
+    return;
+  }
 
-    runtime.insertBefore(parent, child, beforeChild);
+  for (const auto& child : staleChildren) {
+    runtime.removeChild(parent, child);
   }
+  releaseStaleChildren();
+
+  const ScratchInstanceList previousChildren(
+      parent->children.begin(), parent->children.end(), scratch);
+  placeChildren(runtime, parent, previousChildren, desiredChildren);
 }
 
 } // namespace
@@ -434,6 +664,14 @@ const AsyncActionState& ReactRuntime::asyncActionState() const {
   return asyncActionState_;
 }
 
+PropsFingerprintStats& ReactRuntime::propsFingerprintStats() {
+  return propsFingerprintStats_;
+}
+
+const PropsFingerprintStats& ReactRuntime::propsFingerprintStats() const {
+  return propsFingerprintStats_;
+}
+
 void ReactRuntime::resetWorkLoop() {
   workLoopState_ = WorkLoopState{};
 }
@@ -443,7 +681,15 @@ void ReactRuntime::resetRootScheduler() {
 }
 
 void ReactRuntime::setHostInterface(std::shared_ptr<HostInterface> hostInterface) {
+  setHostInterface(
+      hostInterface ? std::make_shared<HostInterfaceAdapter>(std::move(hostInterface))
+                    : std::shared_ptr<HostInterfaceV2>{});
+}
+
+void ReactRuntime::setHostInterface(std::shared_ptr<HostInterfaceV2> hostInterface) {
   hostInterface_ = std::move(hostInterface);
+  // Pooled instances belong to the previous host.
+  hostInstancePool_.clear();
 }
 
 void ReactRuntime::bindHostInterface(facebook::jsi::Runtime& runtime) {
@@ -455,7 +701,17 @@ void ReactRuntime::reset() {
   resetWorkLoop();
   resetRootScheduler();
   asyncActionState_ = AsyncActionState{};
+  taskQueue_.clear();
+  hooksState_ = HooksState{};
+  newContextState_ = NewContextState{};
+  propsFingerprintStats_ = PropsFingerprintStats{};
   registeredRoots_.clear();
+  typedRoots_.clear();
+  lastTypedRenderStats_ = TypedRenderStats{};
+}
+
+void ReactRuntime::setComponentUpdater(ComponentUpdater updater) {
+  componentUpdater_ = std::move(updater);
 }
 
 void ReactRuntime::setShouldAttemptEagerTransitionCallback(std::function<bool()> callback) {
@@ -478,8 +734,10 @@ void ReactRuntime::renderRootSync(
   }
 
   registerRootContainer(rootContainer);
+  typedRoots_.erase(rootContainer.get());
+  propsFingerprintStats_ = PropsFingerprintStats{};
   if (rootElementOffset == 0 || __wasm_memory_buffer == nullptr) {
-    removeAllChildren(*this, rootContainer);
+    removeAllChildren(rootContainer);
     return;
   }
 
@@ -487,8 +745,37 @@ void ReactRuntime::renderRootSync(
   rootValue.type = WasmValueType::Element;
   rootValue.data.ptrValue = rootElementOffset;
 
-  Value rootElement = convertWasmLayoutToJsi(runtime, 0, rootValue);
-  reconcileChildren(*this, runtime, rootContainer, rootElement);
+  // Rewinds the scratch arena once the render is done, including when the
+  // host throws partway through it.
+  struct ScratchArenaReset {
+    RenderScratchArena& arena;
+    ~ScratchArenaReset() {
+      arena.reset();
+    }
+  } scratchArenaReset{renderScratchArena_};
+  reconcileChildren(*this, runtime, rootContainer, 0, &rootValue, 1);
+}
+
+void ReactRuntime::renderTypedRootSync(
+  facebook::jsi::Runtime& runtime,
+  const TypedElement& rootElement,
+  std::shared_ptr<ReactDOMInstance> rootContainer) {
+  lastTypedRenderStats_ = TypedRenderStats{};
+  if (!rootContainer) {
+    return;
+  }
+
+  registerRootContainer(rootContainer);
+  auto& rootNode = typedRoots_[rootContainer.get()];
+  if (!rootNode) {
+    removeAllChildren(rootContainer);
+    rootNode = createTypedRootNode(rootContainer);
+  }
+  reconcileTypedRoot(*this, runtime, *rootNode, rootElement, lastTypedRenderStats_);
+}
+
+const TypedRenderStats& ReactRuntime::getLastTypedRenderStats() const {
+  return lastTypedRenderStats_;
 }
 
 void ReactRuntime::hydrateRoot(
@@ -498,23 +785,87 @@ void ReactRuntime::hydrateRoot(
   renderRootSync(runtime, rootElementOffset, std::move(rootContainer));
 }
 
+void ReactRuntime::setTaskDriver(std::function<void()> requestHostCallback) {
+  requestHostCallback_ = std::move(requestHostCallback);
+}
+
+bool ReactRuntime::hasTaskDriver() const {
+  return static_cast<bool>(requestHostCallback_);
+}
+
 TaskHandle ReactRuntime::scheduleTask(
   SchedulerPriority priority,
   Task task,
   const TaskOptions& options) {
   (void)options;
+  const TaskHandle handle{nextTaskId_++};
+  if (priority != SchedulerPriority::ImmediatePriority && requestHostCallback_) {
+    taskQueue_.push_back(ScheduledTask{handle, priority, std::move(task)});
+    requestHostCallback_();
+    return handle;
+  }
+
   const auto previous = currentPriority_;
   currentPriority_ = priority;
   if (task) {
     task();
   }
   currentPriority_ = previous;
-  return TaskHandle{nextTaskId_++};
+  return handle;
 }
 
 void ReactRuntime::cancelTask(TaskHandle handle) {
-  (void)handle;
-  // TODO: integrate host scheduler cancellation semantics.
+  auto it = std::find_if(taskQueue_.begin(), taskQueue_.end(), [handle](const ScheduledTask& task) {
+    return task.handle == handle;
+  });
+  if (it != taskQueue_.end()) {
+    taskQueue_.erase(it);
+  }
+}
+
+bool ReactRuntime::hasPendingTasks() const {
+  return !taskQueue_.empty();
+}
+
+bool ReactRuntime::runNextTask() {
+  if (taskQueue_.empty()) {
+    return false;
+  }
+
+  // Handles increase monotonically, so the lowest id is the oldest task.
+  auto next = std::min_element(
+    taskQueue_.begin(), taskQueue_.end(), [](const ScheduledTask& a, const ScheduledTask& b) {
+      return a.priority != b.priority ? a.priority < b.priority : a.handle.id < b.handle.id;
+    });
+  ScheduledTask scheduled = std::move(*next);
+  taskQueue_.erase(next);
+
+  const auto previousPriority = currentPriority_;
+  const bool wasRunningTask = isRunningTask_;
+  const double previousStartTime = taskStartTime_;
+  currentPriority_ = scheduled.priority;
+  isRunningTask_ = true;
+  taskStartTime_ = now();
+  auto restore = [&] {
+    currentPriority_ = previousPriority;
+    isRunningTask_ = wasRunningTask;
+    taskStartTime_ = previousStartTime;
+  };
+  try {
+    if (scheduled.task) {
+      scheduled.task();
+    }
+  } catch (...) {
+    restore();
+    throw;
+  }
+  restore();
+  return true;
+}
+
+void ReactRuntime::flushScheduledTasks() {
+  while (runNextTask()) {
+  }
 }
 
 SchedulerPriority ReactRuntime::getCurrentPriorityLevel() const {
@@ -534,7 +885,7 @@ SchedulerPriority ReactRuntime::runWithPriority(
 }
 
 bool ReactRuntime::shouldYield() const {
-  return false;
+  return isRunningTask_ && now() - taskStartTime_ >= frameYieldMs;
 }
 
 double ReactRuntime::now() const {
@@ -542,58 +893,119 @@ double ReactRuntime::now() const {
   return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(steadyNow).count();
 }
 
-std::shared_ptr<HostInterface> ReactRuntime::ensureHostInterface() {
+HostInterfaceV2& ReactRuntime::ensureHostInterface() {
   if (!hostInterface_) {
-    hostInterface_ = std::make_shared<HostInterface>();
+    hostInterface_ = std::make_shared<HostInterfaceV2>();
+  }
+  return *hostInterface_;
+}
+
+void ReactRuntime::setHostInstancePoolCapacity(std::size_t capacityPerType) {
+  hostInstancePool_.setCapacity(capacityPerType);
+  if (capacityPerType == 0) {
+    hostInstancePool_.clear();
   }
-  return hostInterface_;
+}
+
+const HostInstancePoolStats& ReactRuntime::hostInstancePoolStats() const {
+  return hostInstancePool_.stats();
 }
 
 std::shared_ptr<ReactDOMInstance> ReactRuntime::createInstance(
     facebook::jsi::Runtime& runtime,
-    const std::string& type,
+    std::string_view type,
     const facebook::jsi::Object& props) {
-  return ensureHostInterface()->createHostInstance(runtime, type, props);
+  HostInterfaceV2& host = ensureHostInterface();
+  if (hostInstancePool_.enabled()) {
+    auto& stats = hostInstancePool_.stats();
+    if (auto recycled = hostInstancePool_.acquire(type); recycled && host.recycleInstance(recycled, runtime, props)) {
+      ++stats.hits;
+      return recycled;
+    }
+    ++stats.misses;
+  }
+  return host.createInstance(runtime, type, props);
 }
 
 std::shared_ptr<ReactDOMInstance> ReactRuntime::createTextInstance(
     facebook::jsi::Runtime& runtime,
-    const std::string& text) {
-  return ensureHostInterface()->createHostTextInstance(runtime, text);
+    std::string_view text) {
+  HostInterfaceV2& host = ensureHostInterface();
+  if (hostInstancePool_.enabled()) {
+    auto& stats = hostInstancePool_.stats();
+    if (auto recycled = hostInstancePool_.acquireText(); recycled && host.recycleTextInstance(recycled, runtime, text)) {
+      ++stats.hits;
+      return recycled;
+    }
+    ++stats.misses;
+  }
+  return host.createTextInstance(runtime, text);
 }
 
-void ReactRuntime::appendChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child) {
-  ensureHostInterface()->appendHostChild(std::move(parent), std::move(child));
+void ReactRuntime::appendChild(HostInstanceHandle parent, HostInstanceHandle child) {
+  ensureHostInterface().appendChild(parent, child);
 }
 
-void ReactRuntime::removeChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child) {
-  ensureHostInterface()->removeHostChild(std::move(parent), std::move(child));
+void ReactRuntime::removeChild(HostInstanceHandle parent, HostInstanceHandle child) {
+  ensureHostInterface().removeChild(parent, child);
 }
 
 void ReactRuntime::insertBefore(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child,
-    std::shared_ptr<ReactDOMInstance> beforeChild) {
-  ensureHostInterface()->insertHostChildBefore(std::move(parent), std::move(child), std::move(beforeChild));
+    HostInstanceHandle parent,
+    HostInstanceHandle child,
+    HostInstanceHandle beforeChild) {
+  ensureHostInterface().insertChildBefore(parent, child, beforeChild);
+}
+
+void ReactRuntime::removeAllChildren(HostInstanceHandle parent) {
+  ensureHostInterface().removeAllChildren(parent);
+}
+
+void ReactRuntime::releaseInstance(std::shared_ptr<ReactDOMInstance> instance) {
+  if (hostInstancePool_.enabled()) {
+    hostInstancePool_.release(std::move(instance));
+  }
+}
+
+void ReactRuntime::replaceChildren(
+    HostInstanceHandle parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last) {
+  ensureHostInterface().replaceChildren(parent, HostInstanceSpan{first, last});
+}
+
+void ReactRuntime::appendChildren(
+    HostInstanceHandle parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last) {
+  ensureHostInterface().appendChildren(parent, HostInstanceSpan{first, last});
+}
+
+void ReactRuntime::moveChildrenBefore(
+    HostInstanceHandle parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last,
+    HostInstanceHandle beforeChild) {
+  ensureHostInterface().moveChildrenBefore(parent, HostInstanceSpan{first, last}, beforeChild);
 }
 
 void ReactRuntime::commitUpdate(
-    std::shared_ptr<ReactDOMInstance> instance,
+    HostInstanceHandle instance,
     const facebook::jsi::Object& oldProps,
     const facebook::jsi::Object& newProps,
     const facebook::jsi::Object& payload) {
-  ensureHostInterface()->commitHostUpdate(std::move(instance), oldProps, newProps, payload);
+  ensureHostInterface().commitUpdate(instance, oldProps, newProps, payload);
+}
+
+void ReactRuntime::commitUpdate(HostInstanceHandle instance, const UpdatePayload& payload) {
+  ensureHostInterface().commitUpdate(instance, payload);
 }
 
 void ReactRuntime::commitTextUpdate(
-    std::shared_ptr<ReactDOMInstance> instance,
-    const std::string& oldText,
-    const std::string& newText) {
-  ensureHostInterface()->commitHostTextUpdate(std::move(instance), oldText, newText);
+    HostInstanceHandle instance,
+    std::string_view oldText,
+    std::string_view newText) {
+  ensureHostInterface().commitTextUpdate(instance, oldText, newText);
 }
 
 void ReactRuntime::unregisterRootContainer(const ReactDOMInstance* rootContainer) {
@@ -601,6 +1013,7 @@ void ReactRuntime::unregisterRootContainer(const ReactDOMInstance* rootContainer
     return;
   }
   registeredRoots_.erase(rootContainer);
+  typedRoots_.erase(rootContainer);
 }
 
 std::size_t ReactRuntime::getRegisteredRootCount() const {
@@ -1,15 +1,23 @@
 #pragma once
 
 #include "react-reconciler/ReactFiberAsyncAction.h"
+#include "react-reconciler/ReactFiberHooksState.h"
+#include "react-reconciler/ReactFiberNewContextState.h"
 #include "react-reconciler/ReactFiberRootSchedulerState.h"
 #include "react-reconciler/ReactFiberWorkLoopState.h"
+#include "runtime/ReactHostInstancePool.h"
+#include "runtime/ReactHostInterfaceV2.h"
+#include "runtime/ReactRenderScratchArena.h"
+#include "runtime/ReactTypedComponent.h"
 #include "scheduler/Scheduler.h"
 
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string_view>
 #include <typeinfo>
 #include <unordered_map>
+#include <vector>
 
 namespace facebook {
 namespace jsi {
@@ -20,9 +28,17 @@ class Object;
 
 namespace react {
 
+class FiberNode;
 class HostInterface;
-class ReactDOMInstance;
+class ReactRuntime;
 struct FiberRoot;
+struct UpdatePayload;
+
+// Renders a fiber that did not bail out in beginWork and returns the child to
+// work on next. Stands in for the updateXxx paths of ReactFiberBeginWork.js
+// until the child reconciler is ported.
+using ComponentUpdater =
+  std::function<FiberNode*(ReactRuntime& runtime, FiberNode* current, FiberNode& workInProgress, Lanes renderLanes)>;
 
 enum class IsomorphicIndicatorRegistrationState : std::uint8_t {
   Uninitialized = 0,
@@ -38,12 +54,25 @@ struct AsyncActionState {
   std::function<std::function<void()>()> isomorphicDefaultTransitionIndicator{};
   std::function<void()> pendingIsomorphicIndicator{};
   std::size_t pendingEntangledRoots{0};
+  // Transition of the enclosing startTransition scope, or null outside one.
+  // Shared so whatever records it outlives the scope safely.
+  std::shared_ptr<const Transition> currentTransition{};
   bool needsIsomorphicIndicator{false};
   FiberRoot* indicatorRegistrationRoot{nullptr};
   const std::type_info* indicatorRegistrationType{nullptr};
   const void* indicatorRegistrationToken{nullptr};
 };
 
+// Per-render counters for props fingerprint bailouts in renderRootSync.
+struct PropsFingerprintStats {
+  std::size_t matchedElements{0};
+  std::size_t diffedElements{0};
+  // Per-key comparisons computeUpdatePayload would have made for matched elements.
+  std::size_t skippedPropComparisons{0};
+  // Elements whose whole subtree was skipped because its subtree hash matched.
+  std::size_t skippedSubtrees{0};
+};
+
 class ReactRuntime {
 public:
   ReactRuntime();
@@ -54,16 +83,50 @@ public:
   const RootSchedulerState& rootSchedulerState() const;
   AsyncActionState& asyncActionState();
   const AsyncActionState& asyncActionState() const;
+  PropsFingerprintStats& propsFingerprintStats();
+  const PropsFingerprintStats& propsFingerprintStats() const;
+  // Backs the reconciler's temporaries in renderRootSync; reset after each
+  // commit.
+  RenderScratchArena& renderScratchArena() {
+    return renderScratchArena_;
+  }
+  // Inline: read on every hook call of every function component render.
+  HooksState& hooksState() {
+    return hooksState_;
+  }
+  const HooksState& hooksState() const {
+    return hooksState_;
+  }
+  // Inline: read on every readContext call.
+  NewContextState& newContextState() {
+    return newContextState_;
+  }
+  const NewContextState& newContextState() const {
+    return newContextState_;
+  }
 
   void resetWorkLoop();
   void resetRootScheduler();
 
+  // Hosts written against HostInterface are driven through a
+  // HostInterfaceAdapter.
   void setHostInterface(std::shared_ptr<HostInterface> hostInterface);
+  void setHostInterface(std::shared_ptr<HostInterfaceV2> hostInterface);
   void bindHostInterface(facebook::jsi::Runtime& runtime);
   void reset();
 
+  void setComponentUpdater(ComponentUpdater updater);
+  [[nodiscard]] const ComponentUpdater& componentUpdater() const {
+    return componentUpdater_;
+  }
+
   void setShouldAttemptEagerTransitionCallback(std::function<bool()> callback);
   [[nodiscard]] bool shouldAttemptEagerTransition() const;
+  // Reconciles the host elements of the layout at rootElementOffset into
+  // rootContainer in one synchronous pass. The layout holds host elements
+  // only and no fibers are built for it, so lanes, transitions and
+  // useDeferredValue apply to fiber trees rendered through the work loop
+  // (scheduleFiberUpdate and renderRootConcurrent), not to this path.
   void renderRootSync(
     facebook::jsi::Runtime& runtime,
     std::uint32_t rootElementOffset,
@@ -72,11 +135,27 @@ public:
     facebook::jsi::Runtime& runtime,
     std::uint32_t rootElementOffset,
     std::shared_ptr<ReactDOMInstance> rootContainer);
+  // Renders a tree of typed C++ components into rootContainer, diffing against
+  // the tree retained from the previous typed render of the same container.
+  void renderTypedRootSync(
+    facebook::jsi::Runtime& runtime,
+    const TypedElement& rootElement,
+    std::shared_ptr<ReactDOMInstance> rootContainer);
+  [[nodiscard]] const TypedRenderStats& getLastTypedRenderStats() const;
 
   void unregisterRootContainer(const ReactDOMInstance* rootContainer);
 
   [[nodiscard]] std::size_t getRegisteredRootCount() const;
 
+  // Without a task driver every task runs before scheduleTask returns.
+  // Once a host installs one, tasks below ImmediatePriority are queued
+  // instead and `requestHostCallback` is called for each; the host then runs
+  // them from its event loop with runNextTask or flushScheduledTasks.
+  // ImmediatePriority tasks always run inline, standing in for the
+  // microtasks React schedules them in. An empty function removes the driver.
+  void setTaskDriver(std::function<void()> requestHostCallback);
+  [[nodiscard]] bool hasTaskDriver() const;
+
   TaskHandle scheduleTask(
     SchedulerPriority priority,
     Task task,
@@ -84,6 +163,12 @@ public:
 
   void cancelTask(TaskHandle handle);
 
+  [[nodiscard]] bool hasPendingTasks() const;
+  // Runs the highest priority queued task (FIFO within a priority). Returns
+  // false when the queue is empty.
+  bool runNextTask();
+  void flushScheduledTasks();
+
   SchedulerPriority getCurrentPriorityLevel() const;
 
   SchedulerPriority runWithPriority(
@@ -94,51 +179,95 @@ public:
 
   [[nodiscard]] double now() const;
 
+  // Opt-in reuse of unmounted host instances: keeps up to `capacityPerType`
+  // of each element type and hands them back out through the host's
+  // recycleHostInstance hooks. 0, the default, disables the pool.
+  void setHostInstancePoolCapacity(std::size_t capacityPerType);
+  [[nodiscard]] const HostInstancePoolStats& hostInstancePoolStats() const;
+
   std::shared_ptr<ReactDOMInstance> createInstance(
     facebook::jsi::Runtime& runtime,
-    const std::string& type,
+    std::string_view type,
     const facebook::jsi::Object& props);
 
   std::shared_ptr<ReactDOMInstance> createTextInstance(
     facebook::jsi::Runtime& runtime,
-    const std::string& text);
+    std::string_view text);
 
-  void appendChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child);
+  void appendChild(HostInstanceHandle parent, HostInstanceHandle child);
 
-  void removeChild(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child);
+  void removeChild(HostInstanceHandle parent, HostInstanceHandle child);
 
   void insertBefore(
-    std::shared_ptr<ReactDOMInstance> parent,
-    std::shared_ptr<ReactDOMInstance> child,
-    std::shared_ptr<ReactDOMInstance> beforeChild);
+    HostInstanceHandle parent,
+    HostInstanceHandle child,
+    HostInstanceHandle beforeChild);
+
+  void removeAllChildren(HostInstanceHandle parent);
+
+  // Hands a removed instance and its subtree to the host instance pool; a
+  // no-op while the pool is disabled.
+  void releaseInstance(std::shared_ptr<ReactDOMInstance> instance);
+
+  void replaceChildren(
+    HostInstanceHandle parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last);
+
+  void appendChildren(
+    HostInstanceHandle parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last);
+
+  void moveChildrenBefore(
+    HostInstanceHandle parent,
+    ReactDOMInstanceIterator first,
+    ReactDOMInstanceIterator last,
+    HostInstanceHandle beforeChild);
 
   void commitUpdate(
-    std::shared_ptr<ReactDOMInstance> instance,
+    HostInstanceHandle instance,
     const facebook::jsi::Object& oldProps,
     const facebook::jsi::Object& newProps,
     const facebook::jsi::Object& payload);
 
+  void commitUpdate(HostInstanceHandle instance, const UpdatePayload& payload);
+
   void commitTextUpdate(
-    std::shared_ptr<ReactDOMInstance> instance,
-    const std::string& oldText,
-    const std::string& newText);
+    HostInstanceHandle instance,
+    std::string_view oldText,
+    std::string_view newText);
 
 private:
-  std::shared_ptr<HostInterface> ensureHostInterface();
+  HostInterfaceV2& ensureHostInterface();
   void registerRootContainer(const std::shared_ptr<ReactDOMInstance>& rootContainer);
 
-  std::shared_ptr<HostInterface> hostInterface_{};
+  std::shared_ptr<HostInterfaceV2> hostInterface_{};
   WorkLoopState workLoopState_{};
   RootSchedulerState rootSchedulerState_{};
   AsyncActionState asyncActionState_{};
+  HooksState hooksState_{};
+  NewContextState newContextState_{};
+  PropsFingerprintStats propsFingerprintStats_{};
+  RenderScratchArena renderScratchArena_{};
+  HostInstancePool hostInstancePool_{};
+  struct ScheduledTask {
+    TaskHandle handle{};
+    SchedulerPriority priority{SchedulerPriority::NormalPriority};
+    Task task{};
+  };
+
   SchedulerPriority currentPriority_{SchedulerPriority::NormalPriority};
   std::uint64_t nextTaskId_{1};
+  std::vector<ScheduledTask> taskQueue_{};
+  std::function<void()> requestHostCallback_{};
+  bool isRunningTask_{false};
+  double taskStartTime_{0.0};
   std::function<bool()> shouldAttemptEagerTransitionCallback_{};
+  ComponentUpdater componentUpdater_{};
   std::unordered_map<const ReactDOMInstance*, std::weak_ptr<ReactDOMInstance>> registeredRoots_{};
+  std::unordered_map<const ReactDOMInstance*, std::shared_ptr<TypedNode>> typedRoots_{};
+  TypedRenderStats lastTypedRenderStats_{};
 };
 
 namespace ReactRuntimeTestHelper {
@@ -0,0 +1,97 @@
+#include "runtime/ReactTextChildren.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace react {
+namespace {
+
+std::size_t copyLiteral(const char* literal, char* buffer) {
+  const std::size_t length = std::strlen(literal);
+  std::memcpy(buffer, literal, length);
+  return length;
+}
+
+} // namespace
+
+std::size_t formatNumber(double value, char* buffer) {
+  if (std::isnan(value)) {
+    return copyLiteral("NaN", buffer);
+  }
+  if (std::isinf(value)) {
+    return copyLiteral(value > 0 ? "Infinity" : "-Infinity", buffer);
+  }
+  if (value == 0) {
+    // Covers -0, which JavaScript also prints as "0".
+    buffer[0] = '0';
+    return 1;
+  }
+
+  char* out = buffer;
+  if (value < 0) {
+    *out++ = '-';
+    value = -value;
+  }
+
+  // to_chars picks the shortest digits that round-trip, as JavaScript does;
+  // only the layout of those digits differs, so lay them out again below.
+  char scientific[kNumberTextCapacity];
+  const char* const end =
+      std::to_chars(scientific, scientific + sizeof(scientific), value, std::chars_format::scientific).ptr;
+  char digits[kNumberTextCapacity];
+  int digitCount = 0;
+  const char* cursor = scientific;
+  for (; cursor != end && *cursor != 'e'; ++cursor) {
+    if (*cursor != '.') {
+      digits[digitCount++] = *cursor;
+    }
+  }
+  int exponent = 0;
+  std::from_chars(cursor + (cursor[1] == '+' ? 2 : 1), end, exponent);
+
+  // ECMAScript Number::toString: the value is digits x 10^(point - digitCount).
+  const int point = exponent + 1;
+  if (digitCount <= point && point <= 21) {
+    std::memcpy(out, digits, digitCount);
+    out += digitCount;
+    std::memset(out, '0', point - digitCount);
+    out += point - digitCount;
+  } else if (0 < point && point <= 21) {
+    std::memcpy(out, digits, point);
+    out += point;
+    *out++ = '.';
+    std::memcpy(out, digits + point, digitCount - point);
+    out += digitCount - point;
+  } else if (-6 < point && point <= 0) {
+    *out++ = '0';
+    *out++ = '.';
+    std::memset(out, '0', -point);
+    out += -point;
+    std::memcpy(out, digits, digitCount);
+    out += digitCount;
+  } else {
+    *out++ = digits[0];
+    if (digitCount > 1) {
+      *out++ = '.';
+      std::memcpy(out, digits + 1, digitCount - 1);
+      out += digitCount - 1;
+    }
+    *out++ = 'e';
+    *out++ = exponent < 0 ? '-' : '+';
+    out = std::to_chars(out, buffer + kNumberTextCapacity, exponent < 0 ? -exponent : exponent).ptr;
+  }
+  return static_cast<std::size_t>(out - buffer);
+}
+
+void appendNumberText(std::string& out, double value) {
+  char buffer[kNumberTextCapacity];
+  out.append(buffer, formatNumber(value, buffer));
+}
+
+std::string numberToText(double value) {
+  char buffer[kNumberTextCapacity];
+  return std::string(buffer, formatNumber(value, buffer));
+}
+
+} // namespace react
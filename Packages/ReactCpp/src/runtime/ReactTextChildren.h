@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace react {
+
+// Room for the longest text formatNumber writes, such as
+// "-0.0000012345678901234567" or "-2.2250738585072014e-308".
+constexpr std::size_t kNumberTextCapacity = 32;
+
+// Writes `value` the way JavaScript's Number.prototype.toString does: the
+// shortest digits that round-trip, in fixed notation between 1e-7 and 1e21
+// and in exponent notation outside it. Returns the length written to
+// `buffer`, which must hold kNumberTextCapacity chars. Never allocates.
+std::size_t formatNumber(double value, char* buffer);
+
+// Appends formatNumber(value) to `out`.
+void appendNumberText(std::string& out, double value);
+
+std::string numberToText(double value);
+
+// Splits [first, last) into runs of adjacent text children, which are
+// rendered as a single host text node, and the children between them.
+// `appendText(text, child)` appends a string or number child to `text` and
+// returns false for any other child. `emitText(text, runFirst, runLast)`
+// receives each merged run together with the children it came from, and
+// `emitChild(child)` every other child, in document order. `text` is scratch
+// storage, reused across runs.
+template <typename Iterator, typename AppendText, typename EmitText, typename EmitChild>
+void coalesceTextChildren(
+    Iterator first,
+    Iterator last,
+    std::string& text,
+    AppendText&& appendText,
+    EmitText&& emitText,
+    EmitChild&& emitChild) {
+  text.clear();
+  Iterator runFirst = first;
+  bool inRun = false;
+  for (; first != last; ++first) {
+    if (appendText(text, *first)) {
+      if (!inRun) {
+        runFirst = first;
+        inRun = true;
+      }
+      continue;
+    }
+    if (inRun) {
+      emitText(static_cast<const std::string&>(text), runFirst, first);
+      text.clear();
+      inRun = false;
+    }
+    emitChild(*first);
+  }
+  if (inRun) {
+    emitText(static_cast<const std::string&>(text), runFirst, last);
+  }
+}
+
+} // namespace react
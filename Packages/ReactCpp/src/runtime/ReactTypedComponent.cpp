@@ -0,0 +1,337 @@
+#include "runtime/ReactTypedComponent.h"
+
+#include "jsi/jsi.h"
+#include "react-dom/client/ReactDOMInstance.h"
+#include "runtime/ReactRuntime.h"
+#include "runtime/ReactUpdatePayload.h"
+
+#include <unordered_map>
+
+namespace react {
+
+struct TypedNode {
+  TypedElementKind kind{TypedElementKind::Empty};
+  std::string type{};
+  std::string key{};
+  const TypedComponentDescriptor* component{nullptr};
+  std::shared_ptr<const void> componentProps{};
+  TypedHostProps hostProps{};
+  std::shared_ptr<ReactDOMInstance> instance{};
+  // Host children for Host nodes, the rendered output for Component nodes.
+  std::vector<std::unique_ptr<TypedNode>> children{};
+};
+
+namespace {
+
+using facebook::jsi::Object;
+using facebook::jsi::Runtime;
+using facebook::jsi::String;
+using facebook::jsi::Value;
+
+Value toJsiValue(Runtime& rt, const TypedPropValue& value) {
+  if (const auto* flag = std::get_if<bool>(&value)) {
+    return Value(*flag);
+  }
+  if (const auto* number = std::get_if<double>(&value)) {
+    return Value(*number);
+  }
+  if (const auto* text = std::get_if<std::string>(&value)) {
+    return Value(String::createFromUtf8(rt, *text));
+  }
+  return Value::null();
+}
+
+UpdatePayloadValue toPayloadValue(const TypedPropValue& value) {
+  if (const auto* flag = std::get_if<bool>(&value)) {
+    return UpdatePayloadValue::boolean(*flag);
+  }
+  if (const auto* number = std::get_if<double>(&value)) {
+    return UpdatePayloadValue::number(*number);
+  }
+  if (const auto* text = std::get_if<std::string>(&value)) {
+    return UpdatePayloadValue::string(*text);
+  }
+  return UpdatePayloadValue::null();
+}
+
+Object toJsiProps(Runtime& rt, const TypedHostProps& props) {
+  Object object(rt);
+  for (const auto& prop : props) {
+    object.setProperty(rt, prop.name.c_str(), toJsiValue(rt, prop.value));
+  }
+  return object;
+}
+
+const TypedHostProp* findHostProp(const TypedHostProps& props, const std::string& name) {
+  for (const auto& prop : props) {
+    if (prop.name == name) {
+      return &prop;
+    }
+  }
+  return nullptr;
+}
+
+bool canReuse(const TypedNode& node, const TypedElement& element) {
+  if (node.kind != element.kind || node.key != element.key) {
+    return false;
+  }
+  switch (element.kind) {
+    case TypedElementKind::Host:
+      return node.type == element.type;
+    case TypedElementKind::Component:
+      return node.component == element.component;
+    default:
+      return true;
+  }
+}
+
+void collectHostInstances(const TypedNode& node, std::vector<std::shared_ptr<ReactDOMInstance>>& out) {
+  if (node.kind == TypedElementKind::Host || node.kind == TypedElementKind::Text) {
+    if (node.instance) {
+      out.push_back(node.instance);
+    }
+    return;
+  }
+  for (const auto& child : node.children) {
+    collectHostInstances(*child, out);
+  }
+}
+
+class TypedReconciler {
+public:
+  TypedReconciler(ReactRuntime& runtime, Runtime& rt, TypedRenderStats& stats)
+    : runtime_(runtime), rt_(rt), stats_(stats) {}
+
+  void reconcileHostChildren(TypedNode& hostNode, const std::vector<TypedElement>& elements) {
+    reconcileList(hostNode.instance, hostNode.children, elements);
+    placeHostChildren(hostNode.instance, hostNode.children);
+  }
+
+private:
+  std::unique_ptr<TypedNode> mount(const TypedElement& element) {
+    auto node = std::make_unique<TypedNode>();
+    node->kind = element.kind;
+    node->key = element.key;
+
+    switch (element.kind) {
+      case TypedElementKind::Text:
+        node->type = element.type;
+        node->instance = runtime_.createTextInstance(rt_, element.type);
+        ++stats_.hostCreates;
+        break;
+      case TypedElementKind::Host: {
+        node->type = element.type;
+        node->hostProps = element.hostProps;
+        node->instance = runtime_.createInstance(rt_, element.type, toJsiProps(rt_, element.hostProps));
+        node->instance->setKey(element.key);
+        ++stats_.hostCreates;
+        reconcileHostChildren(*node, element.children);
+        break;
+      }
+      case TypedElementKind::Component: {
+        node->component = element.component;
+        node->componentProps = element.componentProps;
+        ++stats_.componentRenders;
+        TypedElement output = element.component->render(element.componentProps.get());
+        if (output.kind != TypedElementKind::Empty) {
+          node->children.push_back(mount(output));
+        }
+        break;
+      }
+      case TypedElementKind::Empty:
+        break;
+    }
+    return node;
+  }
+
+  void update(
+      const std::shared_ptr<ReactDOMInstance>& hostParent,
+      TypedNode& node,
+      const TypedElement& element) {
+    switch (element.kind) {
+      case TypedElementKind::Text:
+        if (node.type != element.type) {
+          runtime_.commitTextUpdate(node.instance, node.type, element.type);
+          node.type = element.type;
+          ++stats_.hostUpdates;
+        }
+        break;
+      case TypedElementKind::Host:
+        if (node.hostProps != element.hostProps) {
+          commitHostProps(node, element.hostProps);
+        }
+        reconcileHostChildren(node, element.children);
+        break;
+      case TypedElementKind::Component: {
+        if (node.componentProps == element.componentProps ||
+            node.component->propsEqual(node.componentProps.get(), element.componentProps.get())) {
+          ++stats_.memoBailouts;
+          break;
+        }
+        node.componentProps = element.componentProps;
+        ++stats_.componentRenders;
+        TypedElement output = element.component->render(element.componentProps.get());
+        std::vector<TypedElement> outputs;
+        if (output.kind != TypedElementKind::Empty) {
+          outputs.push_back(std::move(output));
+        }
+        reconcileList(hostParent, node.children, outputs);
+        break;
+      }
+      case TypedElementKind::Empty:
+        break;
+    }
+  }
+
+  void commitHostProps(TypedNode& node, const TypedHostProps& nextProps) {
+    UpdatePayload payload;
+    for (const auto& prop : nextProps) {
+      const TypedHostProp* previous = findHostProp(node.hostProps, prop.name);
+      if (previous == nullptr || previous->value != prop.value) {
+        payload.set(prop.name, toPayloadValue(prop.value));
+      }
+    }
+    for (const auto& prop : node.hostProps) {
+      if (findHostProp(nextProps, prop.name) == nullptr) {
+        payload.remove(prop.name);
+      }
+    }
+
+    runtime_.commitUpdate(node.instance, payload);
+    node.hostProps = nextProps;
+    ++stats_.hostUpdates;
+  }
+
+  // Matches keyed elements by key and unkeyed elements by position among the
+  // unkeyed nodes, like the JSI reconcileChildren path.
+  void reconcileList(
+      const std::shared_ptr<ReactDOMInstance>& hostParent,
+      std::vector<std::unique_ptr<TypedNode>>& nodes,
+      const std::vector<TypedElement>& elements) {
+    std::unordered_map<std::string, std::size_t> keyedIndex;
+    std::vector<std::size_t> unkeyedIndex;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      if (nodes[i]->key.empty()) {
+        unkeyedIndex.push_back(i);
+      } else {
+        keyedIndex.emplace(nodes[i]->key, i);
+      }
+    }
+
+    std::vector<std::unique_ptr<TypedNode>> nextNodes;
+    nextNodes.reserve(elements.size());
+    std::size_t unkeyedCursor = 0;
+    for (const auto& element : elements) {
+      if (element.kind == TypedElementKind::Empty) {
+        continue;
+      }
+
+      std::unique_ptr<TypedNode>* candidate = nullptr;
+      if (!element.key.empty()) {
+        auto it = keyedIndex.find(element.key);
+        if (it != keyedIndex.end()) {
+          candidate = &nodes[it->second];
+          keyedIndex.erase(it);
+        }
+      } else if (unkeyedCursor < unkeyedIndex.size()) {
+        candidate = &nodes[unkeyedIndex[unkeyedCursor++]];
+      }
+
+      if (candidate != nullptr && *candidate && canReuse(**candidate, element)) {
+        update(hostParent, **candidate, element);
+        nextNodes.push_back(std::move(*candidate));
+      } else {
+        nextNodes.push_back(mount(element));
+      }
+    }
+
+    for (auto& stale : nodes) {
+      if (stale) {
+        removeNode(hostParent, *stale);
+      }
+    }
+    nodes = std::move(nextNodes);
+  }
+
+  void removeNode(const std::shared_ptr<ReactDOMInstance>& hostParent, const TypedNode& node) {
+    std::vector<std::shared_ptr<ReactDOMInstance>> instances;
+    collectHostInstances(node, instances);
+    for (auto& instance : instances) {
+      runtime_.removeChild(hostParent, instance);
+      ++stats_.hostRemovals;
+    }
+  }
+
+  void placeHostChildren(
+      const std::shared_ptr<ReactDOMInstance>& hostParent,
+      const std::vector<std::unique_ptr<TypedNode>>& nodes) {
+    std::vector<std::shared_ptr<ReactDOMInstance>> desired;
+    desired.reserve(nodes.size());
+    for (const auto& node : nodes) {
+      collectHostInstances(*node, desired);
+    }
+
+    // `cursor` is the host child at the position the next desired instance
+    // belongs in.
+    ReactDOMInstance* cursor = hostParent->children.empty() ? nullptr : hostParent->children.front().get();
+    for (const auto& instance : desired) {
+      if (cursor == instance.get()) {
+        cursor = cursor->nextSibling();
+      } else if (cursor != nullptr) {
+        runtime_.insertBefore(hostParent, instance, cursor);
+      } else {
+        runtime_.appendChild(hostParent, instance);
+      }
+    }
+  }
+
+  ReactRuntime& runtime_;
+  Runtime& rt_;
+  TypedRenderStats& stats_;
+};
+
+} // namespace
+
+TypedElement typedHost(
+    std::string type,
+    TypedHostProps props,
+    std::vector<TypedElement> children,
+    std::string key) {
+  TypedElement element;
+  element.kind = TypedElementKind::Host;
+  element.type = std::move(type);
+  element.key = std::move(key);
+  element.hostProps = std::move(props);
+  element.children = std::move(children);
+  return element;
+}
+
+TypedElement typedText(std::string text) {
+  TypedElement element;
+  element.kind = TypedElementKind::Text;
+  element.type = std::move(text);
+  return element;
+}
+
+std::shared_ptr<TypedNode> createTypedRootNode(std::shared_ptr<ReactDOMInstance> rootContainer) {
+  auto root = std::make_shared<TypedNode>();
+  root->kind = TypedElementKind::Host;
+  root->instance = std::move(rootContainer);
+  return root;
+}
+
+void reconcileTypedRoot(
+    ReactRuntime& runtime,
+    Runtime& rt,
+    TypedNode& rootNode,
+    const TypedElement& element,
+    TypedRenderStats& stats) {
+  TypedReconciler reconciler(runtime, rt, stats);
+  std::vector<TypedElement> elements;
+  if (element.kind != TypedElementKind::Empty) {
+    elements.push_back(element);
+  }
+  reconciler.reconcileHostChildren(rootNode, elements);
+}
+
+} // namespace react
@@ -0,0 +1,176 @@
+#pragma once
+
+// Statically typed C++ function components.
+//
+// A component is a type with a nested `Props` struct and a static
+// `render(const Props&)` returning a TypedElement:
+//
+//   struct Row {
+//     struct Props {
+//       int id;
+//       std::string label;
+//       auto tie() const { return std::tie(id, label); }
+//     };
+//     static TypedElement render(const Props& props);
+//   };
+//
+//   runtime.renderTypedRootSync(rt, typedComponent<Row>({1, "first"}), container);
+//
+// Props never pass through jsi::Value. Equality for memo bailouts is generated
+// per Props type at compile time (from `tie()` when present, otherwise
+// `operator==`), and host props are only boxed into JSI objects at the host
+// boundary when an instance is created or updated.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace facebook {
+namespace jsi {
+class Runtime;
+} // namespace jsi
+} // namespace facebook
+
+namespace react {
+
+class ReactDOMInstance;
+class ReactRuntime;
+class TypedElement;
+
+using TypedPropValue = std::variant<std::monostate, bool, double, std::string>;
+
+struct TypedHostProp {
+  std::string name;
+  TypedPropValue value;
+
+  bool operator==(const TypedHostProp& other) const {
+    return name == other.name && value == other.value;
+  }
+  bool operator!=(const TypedHostProp& other) const {
+    return !(*this == other);
+  }
+};
+
+using TypedHostProps = std::vector<TypedHostProp>;
+
+struct TypedComponentDescriptor {
+  const char* name;
+  TypedElement (*render)(const void* props);
+  bool (*propsEqual)(const void* previous, const void* next);
+};
+
+enum class TypedElementKind : std::uint8_t {
+  Empty,
+  Text,
+  Host,
+  Component,
+};
+
+class TypedElement {
+public:
+  TypedElementKind kind{TypedElementKind::Empty};
+  // Host tag for Host elements, text content for Text elements.
+  std::string type{};
+  std::string key{};
+  TypedHostProps hostProps{};
+  std::vector<TypedElement> children{};
+  const TypedComponentDescriptor* component{nullptr};
+  std::shared_ptr<const void> componentProps{};
+};
+
+namespace detail {
+
+template <typename Props, typename = void>
+struct HasPropsTie : std::false_type {};
+
+template <typename Props>
+struct HasPropsTie<Props, std::void_t<decltype(std::declval<const Props&>().tie())>> : std::true_type {};
+
+template <typename Props, typename = void>
+struct HasPropsEquality : std::false_type {};
+
+template <typename Props>
+struct HasPropsEquality<
+    Props,
+    std::void_t<decltype(std::declval<const Props&>() == std::declval<const Props&>())>> : std::true_type {};
+
+} // namespace detail
+
+template <typename Props>
+bool typedPropsEqual(const Props& previous, const Props& next) {
+  if constexpr (detail::HasPropsTie<Props>::value) {
+    return previous.tie() == next.tie();
+  } else {
+    static_assert(
+        detail::HasPropsEquality<Props>::value,
+        "Typed component props need a tie() member or operator==");
+    return previous == next;
+  }
+}
+
+// One descriptor per component type; its address is the component identity
+// the reconciler compares when matching elements.
+template <typename Component>
+struct TypedComponentRegistration {
+  using Props = typename Component::Props;
+
+  static TypedElement render(const void* props) {
+    return Component::render(*static_cast<const Props*>(props));
+  }
+
+  static bool propsEqual(const void* previous, const void* next) {
+    return typedPropsEqual(*static_cast<const Props*>(previous), *static_cast<const Props*>(next));
+  }
+
+  static inline const TypedComponentDescriptor descriptor{
+      typeid(Component).name(),
+      &TypedComponentRegistration::render,
+      &TypedComponentRegistration::propsEqual};
+};
+
+template <typename Component>
+TypedElement typedComponent(typename Component::Props props, std::string key = std::string{}) {
+  TypedElement element;
+  element.kind = TypedElementKind::Component;
+  element.key = std::move(key);
+  element.component = &TypedComponentRegistration<Component>::descriptor;
+  element.componentProps = std::make_shared<const typename Component::Props>(std::move(props));
+  return element;
+}
+
+TypedElement typedHost(
+    std::string type,
+    TypedHostProps props = {},
+    std::vector<TypedElement> children = {},
+    std::string key = std::string{});
+
+TypedElement typedText(std::string text);
+
+struct TypedRenderStats {
+  std::size_t componentRenders{0};
+  std::size_t memoBailouts{0};
+  std::size_t hostCreates{0};
+  std::size_t hostUpdates{0};
+  std::size_t hostRemovals{0};
+};
+
+// Retained tree from the previous typed render of a root container.
+struct TypedNode;
+
+std::shared_ptr<TypedNode> createTypedRootNode(std::shared_ptr<ReactDOMInstance> rootContainer);
+
+void reconcileTypedRoot(
+    ReactRuntime& runtime,
+    facebook::jsi::Runtime& rt,
+    TypedNode& rootNode,
+    const TypedElement& element,
+    TypedRenderStats& stats);
+
+} // namespace react
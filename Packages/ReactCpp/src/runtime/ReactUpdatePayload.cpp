@@ -0,0 +1,36 @@
+#include "runtime/ReactUpdatePayload.h"
+
+#include "jsi/jsi.h"
+#include "react-dom/client/ReactDOMStyleValue.h"
+
+namespace react {
+
+facebook::jsi::Value updatePayloadValueToJsi(facebook::jsi::Runtime& rt, const UpdatePayloadValue& value) {
+  switch (value.kind) {
+    case UpdatePayloadValue::Kind::Null:
+      return facebook::jsi::Value::null();
+    case UpdatePayloadValue::Kind::Undefined:
+      return facebook::jsi::Value::undefined();
+    case UpdatePayloadValue::Kind::Boolean:
+      return facebook::jsi::Value(value.boolValue);
+    case UpdatePayloadValue::Kind::Number:
+      return facebook::jsi::Value(value.numberValue);
+    case UpdatePayloadValue::Kind::String:
+      return facebook::jsi::Value(facebook::jsi::String::createFromUtf8(
+          rt, reinterpret_cast<const uint8_t*>(value.stringValue.data()), value.stringValue.size()));
+  }
+  return facebook::jsi::Value::undefined();
+}
+
+std::string updatePayloadStyleText(std::string_view name, const UpdatePayloadValue& value) {
+  switch (value.kind) {
+    case UpdatePayloadValue::Kind::Number:
+      return dangerousStyleNumber(name, value.numberValue);
+    case UpdatePayloadValue::Kind::String:
+      return dangerousStyleText(std::string(value.stringValue));
+    default:
+      return std::string();
+  }
+}
+
+} // namespace react
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "react-dom/client/ReactDOMPropAtoms.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace facebook {
+namespace jsi {
+class Runtime;
+class Value;
+} // namespace jsi
+} // namespace facebook
+
+namespace react {
+
+// A prop value carried by an UpdatePayload.
+struct UpdatePayloadValue {
+  enum class Kind : uint8_t {
+    Null,
+    Undefined,
+    Boolean,
+    Number,
+    String,
+  };
+
+  Kind kind{Kind::Undefined};
+  bool boolValue{false};
+  double numberValue{0};
+  std::string_view stringValue{};
+
+  static UpdatePayloadValue null() {
+    return UpdatePayloadValue{Kind::Null};
+  }
+  static UpdatePayloadValue boolean(bool value) {
+    return UpdatePayloadValue{Kind::Boolean, value};
+  }
+  static UpdatePayloadValue number(double value) {
+    return UpdatePayloadValue{Kind::Number, false, value};
+  }
+  static UpdatePayloadValue string(std::string_view value) {
+    return UpdatePayloadValue{Kind::String, false, 0, value};
+  }
+};
+
+// Native form of the commitUpdate payload: the props to set and remove, in
+// the order the diff produced them, each by name and by atom. Style ops
+// name a single CSS property of the `style` prop and carry its raw value.
+// Names and string values view memory the caller owns and stay valid only
+// while commitHostUpdate runs.
+struct UpdatePayload {
+  struct Op {
+    std::string_view name;
+    bool remove{false};
+    UpdatePayloadValue value{};
+    PropAtom atom{PropAtom::None};
+    bool style{false};
+  };
+
+  std::pmr::vector<Op> ops;
+
+  UpdatePayload() = default;
+  // Keeps the ops in `resource`, typically the render's scratch arena.
+  explicit UpdatePayload(std::pmr::memory_resource* resource) : ops(resource) {}
+
+  void set(std::string_view name, UpdatePayloadValue value) {
+    set(internPropName(name), name, value);
+  }
+  void set(PropAtom atom, std::string_view name, UpdatePayloadValue value) {
+    ops.push_back(Op{name, false, value, atom});
+  }
+  void remove(std::string_view name) {
+    remove(internPropName(name), name);
+  }
+  void remove(PropAtom atom, std::string_view name) {
+    ops.push_back(Op{name, true, UpdatePayloadValue{}, atom});
+  }
+  void setStyle(PropAtom atom, std::string_view name, UpdatePayloadValue value) {
+    ops.push_back(Op{name, false, value, atom, true});
+  }
+  void removeStyle(PropAtom atom, std::string_view name) {
+    ops.push_back(Op{name, true, UpdatePayloadValue{}, atom, true});
+  }
+  bool empty() const {
+    return ops.empty();
+  }
+  void clear() {
+    ops.clear();
+  }
+};
+
+facebook::jsi::Value updatePayloadValueToJsi(facebook::jsi::Runtime& rt, const UpdatePayloadValue& value);
+
+// The DOM text of style property `name` set to `value`, as
+// dangerousStyleValue gives it; "" clears the property.
+std::string updatePayloadStyleText(std::string_view name, const UpdatePayloadValue& value);
+
+} // namespace react
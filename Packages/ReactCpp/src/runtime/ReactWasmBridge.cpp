@@ -25,10 +25,150 @@ jsi::Value convertWasmLayoutToJsi(
   uint32_t baseOffset,
   const WasmReactValue& wasmValue);
 
-// Helper to get a pointer into the Wasm memory
-template<typename T>
-T* getPointer(uint32_t baseOffset, uint32_t offset) {
-  return reinterpret_cast<T*>(__wasm_memory_buffer + baseOffset + offset);
+namespace {
+
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+void hashBytes(uint64_t& hash, const void* data, size_t length) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= bytes[i];
+    hash *= kFnvPrime;
+  }
+}
+
+void hashString(uint64_t& hash, const char* text) {
+  for (; *text != '\0'; ++text) {
+    hash ^= static_cast<uint8_t>(*text);
+    hash *= kFnvPrime;
+  }
+  // Include the terminator so adjacent strings cannot run together.
+  hash *= kFnvPrime;
+}
+
+// Mixes a primitive value into `hash`; returns false for any other value.
+bool hashPrimitive(uint64_t& hash, const uint8_t* base, const WasmReactValue& value) {
+  hashBytes(hash, &value.type, sizeof(value.type));
+  switch (value.type) {
+    case WasmValueType::Null:
+    case WasmValueType::Undefined:
+      return true;
+    case WasmValueType::Boolean: {
+      const uint8_t flag = value.data.boolValue ? 1 : 0;
+      hashBytes(hash, &flag, sizeof(flag));
+      return true;
+    }
+    case WasmValueType::Number: {
+      const double number = value.data.numberValue;
+      hashBytes(hash, &number, sizeof(number));
+      return true;
+    }
+    case WasmValueType::String:
+      hashString(hash, reinterpret_cast<const char*>(base + value.data.ptrValue));
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool hashPropValue(uint64_t& hash, const uint8_t* base, const WasmReactValue& value);
+
+bool hashPropEntries(uint64_t& hash, const uint8_t* base, uint32_t propsCount, uint32_t propsPtr) {
+  const uint32_t count = propsPtr != 0 ? propsCount : 0;
+  hashBytes(hash, &count, sizeof(count));
+  const auto* props = reinterpret_cast<const WasmReactProp*>(base + propsPtr);
+  for (uint32_t i = 0; i < count; ++i) {
+    const WasmReactProp& prop = props[i];
+    if (prop.key_ptr == 0) {
+      continue;
+    }
+    hashString(hash, reinterpret_cast<const char*>(base + prop.key_ptr));
+    if (!hashPropValue(hash, base, prop.value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Mixes a prop value into `hash`: a primitive, or an object such as a style
+// by its entries.
+bool hashPropValue(uint64_t& hash, const uint8_t* base, const WasmReactValue& value) {
+  if (value.type != WasmValueType::Object) {
+    return hashPrimitive(hash, base, value);
+  }
+  hashBytes(hash, &value.type, sizeof(value.type));
+  const auto* object = reinterpret_cast<const WasmReactObject*>(base + value.data.ptrValue);
+  return hashPropEntries(hash, base, object->props_count, object->props_ptr);
+}
+
+bool hashProps(uint64_t& hash, const uint8_t* base, const WasmReactElement& element) {
+  return hashPropEntries(hash, base, element.props_count, element.props_ptr);
+}
+
+bool hashChild(uint64_t& hash, const uint8_t* base, const WasmReactValue& value) {
+  if (value.type == WasmValueType::Element) {
+    const auto* child = reinterpret_cast<const WasmReactElement*>(base + value.data.ptrValue);
+    const uint64_t childHash = child->subtree_hash;
+    if (childHash == 0) {
+      return false;
+    }
+    hashBytes(hash, &value.type, sizeof(value.type));
+    hashBytes(hash, &childHash, sizeof(childHash));
+    return true;
+  }
+  if (value.type == WasmValueType::Array) {
+    hashBytes(hash, &value.type, sizeof(value.type));
+    if (value.data.ptrValue == 0) {
+      return true;
+    }
+    const auto* array = reinterpret_cast<const WasmReactArray*>(base + value.data.ptrValue);
+    const uint32_t length = array->items_ptr != 0 ? array->length : 0;
+    hashBytes(hash, &length, sizeof(length));
+    const auto* items = reinterpret_cast<const WasmReactValue*>(base + array->items_ptr);
+    for (uint32_t i = 0; i < length; ++i) {
+      if (!hashChild(hash, base, items[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return hashPrimitive(hash, base, value);
+}
+
+} // namespace
+
+uint64_t computeWasmPropsFingerprint(uint32_t baseOffset, const WasmReactElement& element) {
+  uint64_t hash = kFnvOffsetBasis;
+  if (!hashProps(hash, __wasm_memory_buffer + baseOffset, element)) {
+    return 0;
+  }
+  return hash != 0 ? hash : 1;
+}
+
+uint64_t computeWasmSubtreeHash(const uint8_t* base, const WasmReactElement& element) {
+  uint64_t hash = kFnvOffsetBasis;
+  if (element.type_name_ptr != 0) {
+    hashString(hash, reinterpret_cast<const char*>(base + element.type_name_ptr));
+  }
+  hash *= kFnvPrime;
+  if (element.key_ptr != 0) {
+    hashString(hash, reinterpret_cast<const char*>(base + element.key_ptr));
+  }
+  hash *= kFnvPrime;
+  if (!hashProps(hash, base, element)) {
+    return 0;
+  }
+
+  const uint32_t count = element.children_ptr != 0 ? element.children_count : 0;
+  hashBytes(hash, &count, sizeof(count));
+  const auto* children = reinterpret_cast<const WasmReactValue*>(base + element.children_ptr);
+  for (uint32_t i = 0; i < count; ++i) {
+    if (!hashChild(hash, base, children[i])) {
+      return 0;
+    }
+  }
+  return hash != 0 ? hash : 1;
 }
 
 jsi::Value convertWasmElementToJsi(
@@ -128,6 +268,21 @@ jsi::Value convertWasmLayoutToJsi(jsi::Runtime& rt, uint32_t baseOffset, const W
       }
       return jsi::Value(std::move(jsiArray));
     }
+    case WasmValueType::Object: {
+      WasmReactObject* wasmObject = getPointer<WasmReactObject>(baseOffset, wasmValue.data.ptrValue);
+      jsi::Object jsiObject(rt);
+      if (wasmObject->props_count > 0 && wasmObject->props_ptr != 0) {
+        WasmReactProp* entries = getPointer<WasmReactProp>(baseOffset, wasmObject->props_ptr);
+        for (uint32_t i = 0; i < wasmObject->props_count; ++i) {
+          if (entries[i].key_ptr == 0) {
+            continue;
+          }
+          const char* entryKey = getPointer<const char>(baseOffset, entries[i].key_ptr);
+          jsiObject.setProperty(rt, entryKey, convertWasmLayoutToJsi(rt, baseOffset, entries[i].value));
+        }
+      }
+      return jsi::Value(std::move(jsiObject));
+    }
     default:
       return jsi::Value::undefined();
   }
@@ -15,15 +15,34 @@ namespace react {
 
 class ReactDOMInstance;
 class ReactRuntime;
+struct WasmReactElement;
 struct WasmReactValue;
 class HostInterface;
 
 extern uint8_t* __wasm_memory_buffer;
+
+// Helper to get a pointer into the Wasm memory
+template<typename T>
+T* getPointer(uint32_t baseOffset, uint32_t offset) {
+  return reinterpret_cast<T*>(__wasm_memory_buffer + baseOffset + offset);
+}
+
 facebook::jsi::Value convertWasmLayoutToJsi(
   facebook::jsi::Runtime& rt,
   uint32_t baseOffset,
   const WasmReactValue& wasmValue);
 
+// Fingerprint of an element's props array, or 0 when the props hold values
+// (elements, arrays) that cannot be fingerprinted. Equal non-zero fingerprints
+// mean equal props up to hash collisions.
+uint64_t computeWasmPropsFingerprint(uint32_t baseOffset, const WasmReactElement& element);
+
+// Subtree hash for `element`, whose props, children and strings live in the
+// layout starting at `base`. Child elements contribute their own subtree_hash,
+// so builders encode children first; returns 0 when a child's hash is unknown
+// or a prop cannot be hashed.
+uint64_t computeWasmSubtreeHash(const uint8_t* base, const WasmReactElement& element);
+
 void react_set_host_interface(std::shared_ptr<HostInterface> hostInterface);
 
 extern "C" {
@@ -16,6 +16,7 @@ enum class WasmValueType : uint8_t {
   String,
   Element,
   Array,
+  Object,
 };
 
 // Represents a generic value. The `type` field determines which
@@ -25,7 +26,7 @@ struct WasmReactValue {
   union {
     bool boolValue;
     double numberValue;
-    // For complex types (String, Element, Array), this will be an
+    // For complex types (String, Element, Array, Object), this will be an
     // offset into the Wasm memory block.
     uint32_t ptrValue;
   } data;
@@ -46,6 +47,14 @@ struct WasmReactProp {
   WasmReactValue value;
 };
 
+// A plain object prop value such as `style`, whose entries are primitives.
+struct WasmReactObject {
+  // Number of entries.
+  uint32_t props_count;
+  // Offset to the contiguous block of `WasmReactProp` entries.
+  uint32_t props_ptr;
+};
+
 // The core binary representation of a React Element.
 struct WasmReactElement {
   // Offset to the null-terminated string for the element type (e.g., "div").
@@ -66,6 +75,10 @@ struct WasmReactElement {
   uint32_t children_count;
   // Offset to the array of WasmReactValue (where each value is an Element or String).
   uint32_t children_ptr;
+
+  // Structural hash of this element and everything below it, or 0 if unknown.
+  // Equal non-zero hashes mean identical subtrees up to hash collisions.
+  uint64_t subtree_hash;
 };
 
 } // namespace react
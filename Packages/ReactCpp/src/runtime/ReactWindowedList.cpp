@@ -0,0 +1,88 @@
+#include "runtime/ReactWindowedList.h"
+
+#include "runtime/ReactTextChildren.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace react {
+namespace {
+
+// Typed props carry no style objects, so the height goes out as inline
+// style text, which DOM hosts apply as the element's style attribute.
+TypedElement spacer(const std::string& type, double height, const char* key) {
+  return typedHost(type, {{"style", "height: " + numberToText(height) + "px"}}, {}, key);
+}
+
+} // namespace
+
+void WindowedListLayout::reset(std::size_t rowCount, const RowHeightProvider& rowHeight) {
+  offsets_.resize(rowCount + 1);
+  double offset = 0;
+  for (std::size_t index = 0; index < rowCount; ++index) {
+    offsets_[index] = offset;
+    offset += std::max(0.0, rowHeight(index));
+  }
+  offsets_[rowCount] = offset;
+}
+
+WindowRange WindowedListLayout::rowsInViewport(double scrollOffset, double viewportHeight) const {
+  // Row i covers [offsets_[i], offsets_[i + 1]): the first visible row is
+  // the first whose bottom is below the viewport top, and the rows up to the
+  // first whose top is at or below the viewport bottom are visible.
+  const auto begin = offsets_.begin();
+  const auto first = static_cast<std::size_t>(std::upper_bound(begin + 1, offsets_.end(), scrollOffset) - (begin + 1));
+  if (viewportHeight <= 0 || first >= rowCount()) {
+    return WindowRange{first, first};
+  }
+  const auto last = static_cast<std::size_t>(
+      std::lower_bound(begin + static_cast<std::ptrdiff_t>(first), offsets_.end() - 1, scrollOffset + viewportHeight) -
+      begin);
+  return WindowRange{first, std::max(first + 1, last)};
+}
+
+WindowedList::WindowedList(WindowedListProps props) : props_(std::move(props)) {
+  layout_.reset(props_.rowCount, props_.rowHeight);
+  updateWindow();
+}
+
+void WindowedList::setRowCount(std::size_t rowCount) {
+  props_.rowCount = rowCount;
+  invalidateRowHeights();
+}
+
+void WindowedList::invalidateRowHeights() {
+  layout_.reset(props_.rowCount, props_.rowHeight);
+  updateWindow();
+}
+
+void WindowedList::setViewport(double scrollOffset, double viewportHeight) {
+  scrollOffset_ = scrollOffset;
+  viewportHeight_ = viewportHeight;
+  updateWindow();
+}
+
+void WindowedList::updateWindow() {
+  const WindowRange visible = layout_.rowsInViewport(scrollOffset_, viewportHeight_);
+  const std::size_t rowCount = layout_.rowCount();
+  window_.first = visible.first - std::min(props_.overscan, visible.first);
+  window_.last = std::min(rowCount, visible.last + props_.overscan);
+  window_.first = std::min(window_.first, window_.last);
+}
+
+TypedElement WindowedList::render() const {
+  std::vector<TypedElement> children;
+  children.reserve(window_.size() + 2);
+  children.push_back(spacer(props_.type, layout_.rowOffset(window_.first), "#before"));
+  for (std::size_t index = window_.first; index < window_.last; ++index) {
+    TypedElement row = props_.renderRow(index);
+    row.key = props_.rowKey ? props_.rowKey(index) : std::to_string(index);
+    children.push_back(std::move(row));
+  }
+  children.push_back(spacer(props_.type, layout_.totalHeight() - layout_.rowOffset(window_.last), "#after"));
+  return typedHost(props_.type, {}, std::move(children));
+}
+
+} // namespace react
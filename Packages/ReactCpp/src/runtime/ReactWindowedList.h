@@ -0,0 +1,116 @@
+#pragma once
+
+// Windowed (virtualized) lists for typed roots.
+//
+// Of a list's `rowCount` rows, WindowedList renders only those that
+// intersect the viewport plus `overscan` rows on either side, between two
+// spacer elements whose style heights stand in for the rows outside the
+// window:
+//
+//   WindowedList list({100000, [](std::size_t) { return 24.0; }, renderRow});
+//   list.setViewport(scrollTop, 600);
+//   runtime.renderTypedRootSync(rt, list.render(), container);
+//
+// Every row carries its key, so when the window moves the typed reconciler
+// keeps the rows that are still inside it and only mounts and removes the
+// rows that cross its edges.
+
+#include "runtime/ReactTypedComponent.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace react {
+
+using RowHeightProvider = std::function<double(std::size_t index)>;
+using RowRenderer = std::function<TypedElement(std::size_t index)>;
+using RowKeyProvider = std::function<std::string(std::size_t index)>;
+
+// Rows [first, last).
+struct WindowRange {
+  std::size_t first{0};
+  std::size_t last{0};
+
+  std::size_t size() const {
+    return last - first;
+  }
+  bool operator==(const WindowRange& other) const {
+    return first == other.first && last == other.last;
+  }
+  bool operator!=(const WindowRange& other) const {
+    return !(*this == other);
+  }
+};
+
+// Row offsets of a list with variable row heights, kept as prefix sums so
+// finding the rows at a scroll offset is a binary search.
+class WindowedListLayout {
+public:
+  void reset(std::size_t rowCount, const RowHeightProvider& rowHeight);
+
+  std::size_t rowCount() const {
+    return offsets_.size() - 1;
+  }
+  double rowOffset(std::size_t index) const {
+    return offsets_[index];
+  }
+  double totalHeight() const {
+    return offsets_.back();
+  }
+
+  // The rows that intersect [scrollOffset, scrollOffset + viewportHeight).
+  WindowRange rowsInViewport(double scrollOffset, double viewportHeight) const;
+
+private:
+  // offsets_[i] is the top of row i; the last entry is the total height.
+  std::vector<double> offsets_{0.0};
+};
+
+struct WindowedListProps {
+  std::size_t rowCount{0};
+  RowHeightProvider rowHeight{};
+  RowRenderer renderRow{};
+  // Row keys; the row index when unset. Must not be "#before" or "#after",
+  // the keys of the spacers.
+  RowKeyProvider rowKey{};
+  // Rows mounted past each edge of the viewport.
+  std::size_t overscan{3};
+  // Host type of the list element and its spacers.
+  std::string type{"div"};
+};
+
+class WindowedList {
+public:
+  explicit WindowedList(WindowedListProps props);
+
+  // Both re-read every row height.
+  void setRowCount(std::size_t rowCount);
+  void invalidateRowHeights();
+
+  void setViewport(double scrollOffset, double viewportHeight);
+
+  const WindowedListLayout& layout() const {
+    return layout_;
+  }
+  // The rows render() mounts.
+  WindowRange window() const {
+    return window_;
+  }
+
+  // The list element: a spacer for the rows above the window, one keyed
+  // element per row in the window, and a spacer for the rows below it.
+  TypedElement render() const;
+
+private:
+  void updateWindow();
+
+  WindowedListProps props_;
+  WindowedListLayout layout_{};
+  double scrollOffset_{0};
+  double viewportHeight_{0};
+  WindowRange window_{};
+};
+
+} // namespace react
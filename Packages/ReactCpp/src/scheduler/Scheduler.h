@@ -7,6 +7,11 @@ namespace react {
 
 using Task = std::function<void()>;
 
+// Length of one scheduler time slice; concurrent renders yield back to the
+// host once a task has run this long. Mirrors frameYieldMs in
+// SchedulerFeatureFlags.js.
+inline constexpr double frameYieldMs = 5.0;
+
 enum class SchedulerPriority : uint8_t {
   NoPriority = 0,
   ImmediatePriority = 1,
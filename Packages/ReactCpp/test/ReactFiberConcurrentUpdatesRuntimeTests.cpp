@@ -9,6 +9,7 @@
 
 #include <cassert>
 #include <memory>
+#include <vector>
 
 namespace react::test {
 
@@ -85,6 +86,149 @@ bool runReactFiberConcurrentUpdatesRuntimeTests() {
   }
   assert((hiddenUpdate.lane & OffscreenLane) == OffscreenLane);
 
+  // Hidden and visible fibers flushed in one batch: only updates below the
+  // hidden boundary are tracked as hidden.
+  auto secondHiddenChild = makeFiber(WorkTag::FunctionComponent);
+  secondHiddenChild->returnFiber = offscreen.get();
+  hiddenChild->sibling = secondHiddenChild.get();
+  auto visibleChild = makeFiber(WorkTag::FunctionComponent);
+  visibleChild->returnFiber = rootFiber.get();
+  offscreen->sibling = visibleChild.get();
+
+  ConcurrentUpdate secondHiddenUpdate{};
+  secondHiddenUpdate.lane = TransitionLane2;
+  ConcurrentUpdate visibleUpdate{};
+  visibleUpdate.lane = TransitionLane2;
+  ConcurrentUpdateQueue secondHiddenQueue{};
+  ConcurrentUpdateQueue visibleQueue{};
+  enqueueConcurrentHookUpdate(visibleChild.get(), &visibleQueue, &visibleUpdate, TransitionLane2);
+  enqueueConcurrentHookUpdate(secondHiddenChild.get(), &secondHiddenQueue, &secondHiddenUpdate, TransitionLane2);
+  finishQueueingConcurrentUpdates();
+
+  const auto& secondSlot = rootState.hiddenUpdates[laneToIndex(TransitionLane2)];
+  assert(secondSlot.has_value());
+  assert(secondSlot->size() == 1);
+  assert((*secondSlot)[0] == &secondHiddenUpdate);
+  assert((secondHiddenUpdate.lane & OffscreenLane) == OffscreenLane);
+  assert(visibleUpdate.lane == TransitionLane2);
+  assert((offscreen->childLanes & TransitionLane2) == TransitionLane2);
+
+  // Batches larger than the ring spill, flush in enqueue order per queue, and
+  // grow the ring to the observed high-water mark for the next batch.
+  FiberRoot batchRootState{};
+  batchRootState.tag = RootTag::ConcurrentRoot;
+  auto batchRootFiber = makeFiber(WorkTag::HostRoot);
+  batchRootFiber->stateNode = &batchRootState;
+
+  auto batchParent = makeFiber(WorkTag::HostComponent);
+  batchParent->returnFiber = batchRootFiber.get();
+  batchRootFiber->child = batchParent.get();
+
+  auto leafA = makeFiber(WorkTag::FunctionComponent);
+  auto leafB = makeFiber(WorkTag::FunctionComponent);
+  leafA->returnFiber = batchParent.get();
+  leafB->returnFiber = batchParent.get();
+  batchParent->child = leafA.get();
+  leafA->sibling = leafB.get();
+
+  const std::size_t initialCapacity = ConcurrentUpdatesTestHelper::getQueueCapacity();
+  const std::size_t batchSize = initialCapacity * 3;
+  ConcurrentUpdateQueue queueA{};
+  ConcurrentUpdateQueue queueB{};
+  std::vector<ConcurrentUpdate> batchUpdates(batchSize);
+  for (std::size_t i = 0; i < batchSize; ++i) {
+    const bool toA = (i % 2) == 0;
+    const Lane lane = toA ? DefaultLane : InputContinuousLane;
+    batchUpdates[i].lane = lane;
+    enqueueConcurrentHookUpdate(toA ? leafA.get() : leafB.get(), toA ? &queueA : &queueB, &batchUpdates[i], lane);
+  }
+  assert(ConcurrentUpdatesTestHelper::getQueuedEntryCount() == batchSize);
+  assert(getConcurrentlyUpdatedLanes() == (DefaultLane | InputContinuousLane));
+
+  finishQueueingConcurrentUpdates();
+
+  assert(ConcurrentUpdatesTestHelper::getQueuedEntryCount() == 0);
+  assert(ConcurrentUpdatesTestHelper::getQueueHighWaterMark() >= batchSize);
+  assert(ConcurrentUpdatesTestHelper::getQueueCapacity() >= batchSize);
+  assert(getConcurrentlyUpdatedLanes() == NoLanes);
+
+  // queue.pending points at the last update; pending->next is the first.
+  assert(queueA.pending == &batchUpdates[batchSize - 2]);
+  assert(queueB.pending == &batchUpdates[batchSize - 1]);
+  std::size_t expectedIndex = 0;
+  ConcurrentUpdate* cursor = queueA.pending->next;
+  do {
+    assert(cursor == &batchUpdates[expectedIndex]);
+    expectedIndex += 2;
+    cursor = cursor->next;
+  } while (cursor != queueA.pending->next);
+  assert(expectedIndex == batchSize);
+
+  assert(leafA->lanes == DefaultLane);
+  assert(leafB->lanes == InputContinuousLane);
+  assert(batchParent->childLanes == (DefaultLane | InputContinuousLane));
+  assert(batchRootFiber->childLanes == (DefaultLane | InputContinuousLane));
+  assert(batchRootState.pendingLanes == (DefaultLane | InputContinuousLane));
+
+  // A steady-state batch of the same size fits in the grown ring.
+  const std::size_t grownCapacity = ConcurrentUpdatesTestHelper::getQueueCapacity();
+  for (std::size_t i = 0; i < batchSize; ++i) {
+    enqueueConcurrentRenderForLane(leafA.get(), DefaultLane);
+  }
+  finishQueueingConcurrentUpdates();
+  assert(ConcurrentUpdatesTestHelper::getQueueCapacity() == grownCapacity);
+  assert(ConcurrentUpdatesTestHelper::getQueuedEntryCount() == 0);
+
+  // Leaves under a shared spine only walk the spine once per flush, and a
+  // hidden boundary on the shared part still marks every leaf below it.
+  FiberRoot spineRootState{};
+  spineRootState.tag = RootTag::ConcurrentRoot;
+  auto spineRootFiber = makeFiber(WorkTag::HostRoot);
+  spineRootFiber->stateNode = &spineRootState;
+
+  constexpr std::size_t spineDepth = 16;
+  constexpr std::size_t spineLeafCount = 8;
+  std::vector<std::shared_ptr<FiberNode>> spine;
+  FiberNode* spineParent = spineRootFiber.get();
+  OffscreenInstance spineHiddenInstance;
+  spineHiddenInstance._visibility = 0;
+  for (std::size_t depth = 0; depth < spineDepth; ++depth) {
+    const bool hiddenLevel = depth == spineDepth / 2;
+    spine.push_back(makeFiber(hiddenLevel ? WorkTag::OffscreenComponent : WorkTag::HostComponent));
+    if (hiddenLevel) {
+      spine.back()->stateNode = &spineHiddenInstance;
+    }
+    spine.back()->returnFiber = spineParent;
+    spineParent = spine.back().get();
+  }
+  std::vector<std::shared_ptr<FiberNode>> spineLeaves;
+  std::vector<ConcurrentUpdateQueue> spineQueues(spineLeafCount);
+  std::vector<ConcurrentUpdate> spineUpdates(spineLeafCount);
+  for (std::size_t i = 0; i < spineLeafCount; ++i) {
+    spineLeaves.push_back(makeFiber(WorkTag::FunctionComponent));
+    spineLeaves.back()->returnFiber = spineParent;
+    const Lane lane = i == spineLeafCount - 1 ? SyncLane : TransitionLane2;
+    spineUpdates[i].lane = lane;
+    enqueueConcurrentHookUpdate(spineLeaves[i].get(), &spineQueues[i], &spineUpdates[i], lane);
+  }
+  finishQueueingConcurrentUpdates();
+
+  // The first TransitionLane2 leaf and the SyncLane leaf walk the whole spine
+  // plus the root; the other leaves stop at their shared parent.
+  assert(
+    ConcurrentUpdatesTestHelper::getLastFlushAncestorVisits() ==
+    2 * (spineDepth + 1) + (spineLeafCount - 2));
+  for (const auto& level : spine) {
+    assert(level->childLanes == (TransitionLane2 | SyncLane));
+  }
+  assert(spineRootFiber->childLanes == (TransitionLane2 | SyncLane));
+  assert(spineRootState.pendingLanes == (TransitionLane2 | SyncLane));
+  const auto& hiddenTransitionUpdates = spineRootState.hiddenUpdates[laneToIndex(TransitionLane2)];
+  assert(hiddenTransitionUpdates.has_value());
+  assert(hiddenTransitionUpdates->size() == spineLeafCount - 1);
+  const auto& hiddenSyncUpdates = spineRootState.hiddenUpdates[laneToIndex(SyncLane)];
+  assert(hiddenSyncUpdates.has_value() && hiddenSyncUpdates->size() == 1);
+
   return true;
 }
 
@@ -0,0 +1,138 @@
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberExternalStore.h"
+#include "react-reconciler/ReactFiberLane.h"
+#include "runtime/ReactRuntime.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+struct CounterState {
+  int left{0};
+  int right{0};
+};
+
+void appendChildren(FiberNode& parent, const std::vector<FiberNode*>& children) {
+  FiberNode* previous = nullptr;
+  for (FiberNode* child : children) {
+    child->returnFiber = &parent;
+    if (previous == nullptr) {
+      parent.child = child;
+    } else {
+      previous->sibling = child;
+    }
+    previous = child;
+  }
+}
+
+} // namespace
+
+bool runReactFiberExternalStoreTests() {
+  ReactRuntime runtime;
+
+  FiberRoot root{};
+  FiberNode* hostRoot = createFiber(WorkTag::HostRoot);
+  hostRoot->stateNode = &root;
+  root.current = hostRoot;
+  FiberNode* leftA = createFiber(WorkTag::FunctionComponent);
+  FiberNode* leftB = createFiber(WorkTag::FunctionComponent);
+  FiberNode* right = createFiber(WorkTag::FunctionComponent);
+  appendChildren(*hostRoot, {leftA, leftB, right});
+
+  ExternalStore<CounterState> store(runtime, CounterState{});
+  auto selectLeft = [](const CounterState& state) { return state.left; };
+  auto leftASubscription = store.subscribe(*leftA, selectLeft);
+  auto leftBSubscription = store.subscribe(*leftB, selectLeft);
+  auto rightSubscription = store.subscribe(*right, [](const CounterState& state) { return state.right; });
+  assert(store.getSubscriberCount() == 3);
+  assert(rightSubscription->getSelection() == 0);
+
+  // A write whose selections are all unchanged schedules nothing.
+  store.update([](CounterState&) {});
+  assert(store.getLastNotifyStats().selectorRuns == 3);
+  assert(store.getLastNotifyStats().bailouts == 3);
+  assert(store.getLastNotifyStats().scheduledFibers == 0);
+  assert(root.pendingLanes == NoLanes);
+  assert(root.current == hostRoot);
+
+  // Both left subscribers change; they render together in one sync pass, so
+  // the root commits exactly once.
+  store.update([](CounterState& state) { state.left = 1; });
+  const ExternalStoreNotifyStats& stats = store.getLastNotifyStats();
+  assert(stats.scheduledFibers == 2);
+  assert(stats.bailouts == 1);
+  assert(stats.scheduledRoots == 1);
+  assert(leftASubscription->getSelection() == 1);
+  assert(rightSubscription->getSelection() == 0);
+  assert(root.pendingLanes == NoLanes);
+  assert(root.current != hostRoot);
+  FiberNode* const afterFirstPass = root.current;
+
+  // Writes inside a batch notify once at the end, against the final state.
+  store.batch([&] {
+    store.update([](CounterState& state) { state.right = 1; });
+    store.update([](CounterState& state) { state.right = 2; });
+    assert(rightSubscription->getSelection() == 0);
+  });
+  assert(rightSubscription->getSelection() == 2);
+  assert(store.getLastNotifyStats().scheduledFibers == 1);
+  assert(store.getLastNotifyStats().selectorRuns == 3);
+  assert(root.current == hostRoot);
+  assert(root.current->alternate == afterFirstPass);
+
+  // Destroying a subscription unsubscribes it.
+  leftBSubscription.reset();
+  assert(store.getSubscriberCount() == 2);
+  store.setState(CounterState{5, 2});
+  assert(store.getLastNotifyStats().selectorRuns == 2);
+  assert(store.getLastNotifyStats().scheduledFibers == 1);
+  assert(leftASubscription->getSelection() == 5);
+
+  // Subscriptions outliving their store are detached rather than dangling.
+  {
+    ExternalStore<CounterState> shortLived(runtime, CounterState{});
+    leftBSubscription = shortLived.subscribe(*leftB, selectLeft);
+    assert(leftBSubscription->isSubscribed());
+  }
+  assert(!leftBSubscription->isSubscribed());
+  leftBSubscription.reset();
+
+  // A selector may unsubscribe a subscription the notify loop has not reached
+  // yet; that one is skipped rather than the loop walking a reordered list.
+  auto selectRight = [](const CounterState& state) { return state.right; };
+  std::unique_ptr<ExternalStoreSubscription<CounterState, decltype(selectRight)>> victim;
+  auto unsubscriber = store.subscribe(*leftB, [&victim](const CounterState& state) {
+    if (state.right == 7) {
+      victim.reset();
+    }
+    return state.right;
+  });
+  victim = store.subscribe(*leftB, selectRight);
+  assert(store.getSubscriberCount() == 4);
+  store.setState(CounterState{5, 7});
+  assert(victim == nullptr);
+  assert(store.getSubscriberCount() == 3);
+  assert(store.getLastNotifyStats().selectorRuns == 3);
+  assert(store.getLastNotifyStats().scheduledFibers == 2);
+  assert(unsubscriber->getSelection() == 7);
+  store.setState(CounterState{6, 7});
+  assert(store.getLastNotifyStats().selectorRuns == 3);
+  assert(leftASubscription->getSelection() == 6);
+  unsubscriber.reset();
+
+  leftASubscription.reset();
+  rightSubscription.reset();
+  for (FiberNode* fiber : {leftA, leftB, right}) {
+    delete fiber->alternate;
+    delete fiber;
+  }
+  delete hostRoot->alternate;
+  delete hostRoot;
+  return true;
+}
+
+} // namespace react::test
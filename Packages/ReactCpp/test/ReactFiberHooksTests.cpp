@@ -0,0 +1,241 @@
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberHooks.h"
+#include "runtime/ReactRuntime.h"
+#include "shared/ReactFeatureFlags.h"
+
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+int gStateA = 1;
+int gStateB = 2;
+int gStateC = 3;
+
+} // namespace
+
+bool runReactFiberHooksTests() {
+  ReactRuntime runtime;
+
+  FiberNode* current = createFiber(WorkTag::FunctionComponent);
+
+  // Mount appends one contiguous slot per hook.
+  int mountCount = renderWithHooks(
+      runtime,
+      nullptr,
+      *current,
+      [&](int hookCount) {
+        for (int i = 0; i < hookCount; ++i) {
+          Hook& hook = nextWorkInProgressHook(runtime);
+          assert(getCurrentHook(runtime) == nullptr);
+          hook.memoizedState = i == 0 ? &gStateA : &gStateB;
+        }
+        return hookCount;
+      },
+      3,
+      DefaultLane);
+  assert(mountCount == 3);
+  HookSlots* mountedSlots = getHookSlots(*current);
+  assert(mountedSlots != nullptr);
+  assert(mountedSlots->owner == current);
+  assert(mountedSlots->hooks.size() == 3);
+  assert(mountedSlots->hooks[0].memoizedState == &gStateA);
+  assert(runtime.hooksState().currentlyRenderingFiber == nullptr);
+
+  // The work-in-progress render copies the committed slots into its own buffer.
+  FiberNode* workInProgress = createWorkInProgress(current, nullptr);
+  assert(getHookSlots(*workInProgress) == mountedSlots);
+  renderWithHooks(
+      runtime,
+      current,
+      *workInProgress,
+      [&](int) {
+        Hook& first = nextWorkInProgressHook(runtime);
+        assert(getCurrentHook(runtime) == &mountedSlots->hooks[0]);
+        assert(first.memoizedState == &gStateA);
+        first.memoizedState = &gStateC;
+        nextWorkInProgressHook(runtime);
+        nextWorkInProgressHook(runtime);
+        return 0;
+      },
+      0,
+      DefaultLane);
+  HookSlots* updatedSlots = getHookSlots(*workInProgress);
+  assert(updatedSlots != mountedSlots);
+  assert(updatedSlots->owner == workInProgress);
+  assert(updatedSlots->alternate == mountedSlots);
+  assert(mountedSlots->alternate == updatedSlots);
+  assert(updatedSlots->hooks[0].memoizedState == &gStateC);
+  assert(mountedSlots->hooks[0].memoizedState == &gStateA);
+
+  // After the swap the next render reuses the first buffer instead of allocating.
+  FiberNode* nextWorkInProgress = createWorkInProgress(workInProgress, nullptr);
+  assert(nextWorkInProgress == current);
+  renderWithHooks(
+      runtime,
+      workInProgress,
+      *nextWorkInProgress,
+      [&](int) {
+        assert(nextWorkInProgressHook(runtime).memoizedState == &gStateC);
+        nextWorkInProgressHook(runtime);
+        nextWorkInProgressHook(runtime);
+        return 0;
+      },
+      0,
+      DefaultLane);
+  assert(getHookSlots(*nextWorkInProgress) == mountedSlots);
+  assert(mountedSlots->hooks[0].memoizedState == &gStateC);
+
+  // Hook count mismatches are reported like React does, and leave no cursor behind.
+  bool threwForFewer = false;
+  try {
+    renderWithHooks(
+        runtime,
+        nextWorkInProgress,
+        *workInProgress,
+        [&](int) {
+          nextWorkInProgressHook(runtime);
+          return 0;
+        },
+        0,
+        DefaultLane);
+  } catch (const std::logic_error&) {
+    threwForFewer = true;
+  }
+  assert(threwForFewer);
+  assert(runtime.hooksState().workInProgressSlots == nullptr);
+
+  bool threwForMore = false;
+  try {
+    renderWithHooks(
+        runtime,
+        nextWorkInProgress,
+        *workInProgress,
+        [&](int) {
+          for (int i = 0; i < 4; ++i) {
+            nextWorkInProgressHook(runtime);
+          }
+          return 0;
+        },
+        0,
+        DefaultLane);
+  } catch (const std::logic_error&) {
+    threwForMore = true;
+  }
+  assert(threwForMore);
+  assert(runtime.hooksState().currentlyRenderingFiber == nullptr);
+
+  releaseHookSlots(*current);
+  assert(current->memoizedState == nullptr);
+  assert(workInProgress->memoizedState == nullptr);
+
+  delete workInProgress;
+  delete current;
+
+  // Without an explicit release the slots go with the last fiber of the pair.
+  FiberNode* owned = createFiber(WorkTag::FunctionComponent);
+  auto renderOneHook = [&](int) {
+    nextWorkInProgressHook(runtime);
+    return 0;
+  };
+  renderWithHooks(runtime, nullptr, *owned, renderOneHook, 0, DefaultLane);
+  FiberNode* ownedAlternate = createWorkInProgress(owned, nullptr);
+  renderWithHooks(runtime, owned, *ownedAlternate, renderOneHook, 0, DefaultLane);
+  assert(owned->hookStorage == ownedAlternate->hookStorage);
+  std::weak_ptr<void> ownedStorage = owned->hookStorage;
+  delete owned;
+  assert(!ownedStorage.expired());
+  assert(getHookSlots(*ownedAlternate)->hooks.size() == 1);
+  delete ownedAlternate;
+  assert(ownedStorage.expired());
+
+  // useMemoCache hands out fixed-size blocks filled with the sentinel on mount.
+  FiberNode* cached = createFiber(WorkTag::FunctionComponent);
+  auto mountMemo = [&](int) {
+    std::vector<const void*>& first = useMemoCache(runtime, 2);
+    assert(first.size() == 2);
+    assert(first[0] == kMemoCacheSentinel && first[1] == kMemoCacheSentinel);
+    first[0] = &gStateA;
+    first[1] = &gStateB;
+    std::vector<const void*>& second = useMemoCache(runtime, 1);
+    second[0] = &gStateC;
+    return 0;
+  };
+  renderWithHooks(runtime, nullptr, *cached, mountMemo, 0, DefaultLane);
+  MemoCache* committedCache = getHookSlots(*cached)->memoCache.get();
+  assert(committedCache != nullptr);
+  assert(committedCache->data.size() == 2);
+
+  // An update sees the committed entries through the shared cache.
+  FiberNode* cachedWorkInProgress = createWorkInProgress(cached, nullptr);
+  renderWithHooks(
+      runtime,
+      cached,
+      *cachedWorkInProgress,
+      [&](int) {
+        std::vector<const void*>& first = useMemoCache(runtime, 2);
+        assert(first[0] == &gStateA && first[1] == &gStateB);
+        first[1] = &gStateC;
+        assert(useMemoCache(runtime, 1)[0] == &gStateC);
+        return 0;
+      },
+      0,
+      DefaultLane);
+  // Current and work-in-progress point at the same cache, so the write above
+  // is already visible through the committed fiber.
+  MemoCache* renderedCache = getHookSlots(*cachedWorkInProgress)->memoCache.get();
+  assert(renderedCache == committedCache);
+  assert(getHookSlots(*cached)->memoCache == getHookSlots(*cachedWorkInProgress)->memoCache);
+  assert(committedCache->data[0][1] == &gStateC);
+
+  // Asking for a different size for the same block is an error.
+  bool threwForSize = false;
+  try {
+    renderWithHooks(
+        runtime,
+        cachedWorkInProgress,
+        *cached,
+        [&](int) {
+          useMemoCache(runtime, 3);
+          return 0;
+        },
+        0,
+        DefaultLane);
+  } catch (const std::logic_error&) {
+    threwForSize = true;
+  }
+  assert(threwForSize);
+  assert(runtime.hooksState().memoCache == nullptr);
+
+  releaseHookSlots(*cached);
+  delete cachedWorkInProgress;
+  delete cached;
+
+  // A render shares the committed cache; a mount starts an empty one.
+  HookSlots committed;
+  committed.memoCache = std::make_shared<MemoCache>();
+  committed.memoCache->data = {{&gStateA}};
+  HookSlots rendering;
+  HooksState cacheState{};
+  cacheState.currentSlots = &committed;
+  cacheState.workInProgressSlots = &rendering;
+
+  MemoCache& shared = prepareMemoCache(cacheState);
+  assert(&shared == committed.memoCache.get());
+  assert(rendering.memoCache == committed.memoCache);
+  assert(cacheState.memoCache == &shared);
+  shared.data[0][0] = &gStateB;
+  assert(committed.memoCache->data[0][0] == &gStateB);
+
+  cacheState.currentSlots = nullptr;
+  MemoCache& mounted = prepareMemoCache(cacheState);
+  assert(&mounted != committed.memoCache.get());
+  assert(mounted.data.empty());
+  return true;
+}
+
+} // namespace react::test
@@ -0,0 +1,146 @@
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberFlags.h"
+#include "react-reconciler/ReactFiberNewContext.h"
+#include "runtime/ReactRuntime.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+int gOldValue = 1;
+int gNewValue = 2;
+
+void appendChildren(FiberNode& parent, const std::vector<FiberNode*>& children) {
+  FiberNode* previous = nullptr;
+  for (FiberNode* child : children) {
+    child->returnFiber = &parent;
+    if (previous == nullptr) {
+      parent.child = child;
+    } else {
+      previous->sibling = child;
+    }
+    previous = child;
+  }
+}
+
+void subscribe(ReactRuntime& runtime, FiberNode& consumer, const ReactContext& context) {
+  prepareToReadContext(runtime, consumer, DefaultLane);
+  readContext(runtime, context);
+  resetContextDependencies(runtime);
+  consumer.flags = NoFlags;
+}
+
+void clearWork(const std::vector<FiberNode*>& fibers) {
+  for (FiberNode* fiber : fibers) {
+    fiber->lanes = NoLanes;
+    fiber->childLanes = NoLanes;
+    fiber->flags = NoFlags;
+  }
+}
+
+} // namespace
+
+bool runReactFiberNewContextTests() {
+  ReactRuntime runtime;
+  ReactContext context{&gOldValue};
+  ReactContextProviderProps oldProps{&gOldValue};
+  ReactContextProviderProps newProps{&gNewValue};
+
+  // provider -> app -> [panel (consumer) -> wrapper -> nested (consumer),
+  //                     sidebar -> leaf (consumer)]
+  FiberNode* providerCurrent = createFiber(WorkTag::ContextProvider);
+  FiberNode* provider = createFiber(WorkTag::ContextProvider);
+  FiberNode* app = createFiber(WorkTag::FunctionComponent);
+  FiberNode* panel = createFiber(WorkTag::FunctionComponent);
+  FiberNode* wrapper = createFiber(WorkTag::FunctionComponent);
+  FiberNode* nested = createFiber(WorkTag::FunctionComponent);
+  FiberNode* sidebar = createFiber(WorkTag::FunctionComponent);
+  FiberNode* leaf = createFiber(WorkTag::FunctionComponent);
+  const std::vector<FiberNode*> tree{provider, app, panel, wrapper, nested, sidebar, leaf};
+
+  provider->type = &context;
+  provider->pendingProps = &newProps;
+  provider->alternate = providerCurrent;
+  providerCurrent->alternate = provider;
+  providerCurrent->memoizedProps = &oldProps;
+  appendChildren(*provider, {app});
+  appendChildren(*app, {panel, sidebar});
+  appendChildren(*panel, {wrapper});
+  appendChildren(*wrapper, {nested});
+  appendChildren(*sidebar, {leaf});
+
+  subscribe(runtime, *panel, context);
+  subscribe(runtime, *nested, context);
+  subscribe(runtime, *leaf, context);
+  auto* dependency = static_cast<ContextDependency*>(leaf->dependencies->firstContext);
+  assert(dependency->context == &context);
+  assert(dependency->memoizedValue == &gOldValue);
+  assert(dependency->next == nullptr);
+
+  // checkIfContextChanged compares against the value on the provider stack.
+  assert(!checkIfContextChanged(*leaf->dependencies));
+  pushProvider(runtime, *provider, context, &gNewValue);
+  assert(checkIfContextChanged(*leaf->dependencies));
+  // The saved value lives on this runtime's cursor, not on a shared one.
+  assert(runtime.newContextState().valueCursor.current == &gOldValue);
+  assert(ReactRuntime().newContextState().valueCursor.current == nullptr);
+
+  // Eager propagation visits the whole subtree and marks every consumer.
+  propagateContextChange(*provider, context, DefaultLane);
+  assert(panel->lanes == DefaultLane);
+  assert(nested->lanes == DefaultLane);
+  assert(leaf->lanes == DefaultLane);
+  assert(app->childLanes == DefaultLane);
+  assert(wrapper->childLanes == DefaultLane);
+  clearWork(tree);
+
+  // Lazy propagation from a bailing-out fiber stops at the first consumer on
+  // each path and marks the search root as propagated.
+  lazilyPropagateParentContextChanges(*app, *app, DefaultLane);
+  assert(panel->lanes == DefaultLane);
+  assert(leaf->lanes == DefaultLane);
+  assert(nested->lanes == NoLanes);
+  assert(wrapper->childLanes == NoLanes);
+  assert(app->childLanes == DefaultLane);
+  assert(sidebar->childLanes == DefaultLane);
+  assert((app->flags & DidPropagateContext) != NoFlags);
+
+  // A sibling bailing out afterwards finds the marker and does no work.
+  leaf->lanes = NoLanes;
+  lazilyPropagateParentContextChanges(*sidebar, *sidebar, DefaultLane);
+  assert(leaf->lanes == NoLanes);
+
+  // Once the consumer renders (setting NeedsPropagation), its bailing-out
+  // children resume the deferred propagation past the marker.
+  prepareToReadContext(runtime, *panel, DefaultLane);
+  assert(readContext(runtime, context) == &gNewValue);
+  resetContextDependencies(runtime);
+  assert((panel->flags & NeedsPropagation) != NoFlags);
+  lazilyPropagateParentContextChanges(*wrapper, *wrapper, DefaultLane);
+  assert(nested->lanes == DefaultLane);
+  assert(wrapper->childLanes == DefaultLane);
+
+  popProvider(runtime, context, *provider);
+  assert(context.currentValue == &gOldValue);
+
+  // Reading context outside of render is an error.
+  bool threw = false;
+  try {
+    readContext(runtime, context);
+  } catch (const std::logic_error&) {
+    threw = true;
+  }
+  assert(threw);
+
+  for (FiberNode* fiber : tree) {
+    delete fiber;
+  }
+  delete providerCurrent;
+  return true;
+}
+
+} // namespace react::test
@@ -0,0 +1,251 @@
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberHooks.h"
+#include "react-reconciler/ReactFiberLane.h"
+#include "react-reconciler/ReactFiberTransition.h"
+#include "react-reconciler/ReactFiberWorkLoop.h"
+#include "runtime/ReactRuntime.h"
+#include "TestFunctionComponents.h"
+
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+constexpr std::size_t kRowCount = 20;
+
+// App -> [Input, Results -> rows]. Input shows the typed text; Results
+// filters with either the transition query or a deferred copy of the text.
+struct FilterApp {
+  const std::string* text{nullptr};
+  const std::string* transitionQuery{nullptr};
+  bool deferText{false};
+  // Query the rows render with, set by Results before its rows render.
+  const std::string* renderingQuery{nullptr};
+  const std::string* inputRendered{nullptr};
+  std::size_t resultsRenders{0};
+  std::size_t rowRenders{0};
+  std::size_t filterPasses{0};
+};
+
+FilterApp gApp;
+
+// One address per query text, so equal deferred values render the same output.
+const std::string* internQuery(const std::string& query) {
+  static std::set<std::string> queries;
+  return &*queries.insert(query).first;
+}
+
+const void* renderApp(ReactRuntime&, const void*) {
+  return gApp.text;
+}
+
+const void* renderInput(ReactRuntime&, const void*) {
+  gApp.inputRendered = gApp.text;
+  return nullptr;
+}
+
+const void* renderResults(ReactRuntime& runtime, const void*) {
+  ++gApp.resultsRenders;
+  const std::string& deferredText = useDeferredValue(runtime, *gApp.text);
+  const std::string* query = gApp.deferText ? internQuery(deferredText) : gApp.transitionQuery;
+  // The rows' output for a query, computed once per query. The cache is
+  // shared with the committed fiber, so a restarted render reuses it.
+  std::vector<const void*>& cache = useMemoCache(runtime, 2);
+  if (cache[0] != query) {
+    ++gApp.filterPasses;
+    cache[0] = query;
+    cache[1] = query;
+  }
+  gApp.renderingQuery = query;
+  return cache[1];
+}
+
+// Slow enough that a transition render of all rows spans several slices.
+const void* renderRow(ReactRuntime& runtime, const void*) {
+  ++gApp.rowRenders;
+  const double start = runtime.now();
+  while (runtime.now() - start < 1.0) {
+  }
+  return nullptr;
+}
+
+const TestFunctionComponent kApp{"App", &renderApp};
+const TestFunctionComponent kInput{"Input", &renderInput};
+const TestFunctionComponent kResults{"Results", &renderResults};
+const TestFunctionComponent kRow{"Row", &renderRow};
+
+void releaseFiber(FiberNode* fiber) {
+  releaseHookSlots(*fiber);
+  delete fiber->alternate;
+  delete fiber;
+}
+
+void typeText(ReactRuntime& runtime, FiberNode& fiber, const std::string& text) {
+  gApp.text = &text;
+  runtime.runWithPriority(SchedulerPriority::ImmediatePriority, [&] {
+    assert(scheduleFiberUpdate(runtime, fiber) == SyncLane);
+  });
+}
+
+} // namespace
+
+bool runReactFiberTransitionTests() {
+  ReactRuntime runtime;
+
+  // Scheduler: without a driver every task runs inline.
+  bool ranInline = false;
+  runtime.scheduleTask(SchedulerPriority::NormalPriority, [&] {
+    assert(runtime.getCurrentPriorityLevel() == SchedulerPriority::NormalPriority);
+    ranInline = true;
+  });
+  assert(ranInline && !runtime.hasPendingTasks());
+
+  // With one installed, immediate tasks still run inline and others wait
+  // for the host, which is asked for a callback per queued task.
+  std::size_t hostCallbacks = 0;
+  runtime.setTaskDriver([&] { ++hostCallbacks; });
+  assert(runtime.hasTaskDriver());
+  bool ranNormal = false;
+  runtime.scheduleTask(SchedulerPriority::NormalPriority, [&] { ranNormal = true; });
+  const TaskHandle cancelled = runtime.scheduleTask(SchedulerPriority::LowPriority, [] { assert(false); });
+  assert(!ranNormal && runtime.hasPendingTasks());
+  assert(hostCallbacks == 2);
+  runtime.cancelTask(cancelled);
+  assert(runtime.runNextTask());
+  assert(ranNormal && !runtime.hasPendingTasks());
+  assert(!runtime.runNextTask());
+  assert(!runtime.shouldYield());
+
+  installTestComponents(runtime);
+  const std::string empty;
+  const std::string a = "a";
+  const std::string ab = "ab";
+  gApp = FilterApp{};
+  gApp.text = &empty;
+  gApp.transitionQuery = &empty;
+
+  FiberRoot root{};
+  FiberNode* hostRoot = createFiber(WorkTag::HostRoot);
+  hostRoot->stateNode = &root;
+  root.current = hostRoot;
+  FiberNode* app = appendTestComponent(kApp, *hostRoot, nullptr);
+  FiberNode* input = appendTestComponent(kInput, *app, nullptr);
+  FiberNode* results = appendTestComponent(kResults, *app, input);
+  std::vector<FiberNode*> rows;
+  for (std::size_t i = 0; i < kRowCount; ++i) {
+    rows.push_back(appendTestComponent(kRow, *results, rows.empty() ? nullptr : rows.back()));
+  }
+
+  // Mount: a sync update on App renders the whole tree before returning.
+  typeText(runtime, *app, empty);
+  assert(gApp.resultsRenders == 1);
+  assert(gApp.rowRenders == kRowCount);
+  assert(root.pendingLanes == NoLanes);
+  assert(!runtime.hasPendingTasks());
+
+  // An update inside startTransition gets a transition lane and waits for
+  // the scheduler instead of rendering inline.
+  Lane transitionLane = NoLane;
+  std::shared_ptr<const Transition> keptTransition;
+  startTransition(runtime, [&] {
+    gApp.transitionQuery = &a;
+    transitionLane = scheduleFiberUpdate(runtime, *results);
+    keptTransition = requestCurrentTransition(runtime);
+  });
+  assert(isTransitionLane(transitionLane));
+  assert(requestCurrentTransition(runtime) == nullptr);
+  // A transition recorded during the scope stays valid after it returns.
+  assert(keptTransition != nullptr && keptTransition.use_count() == 1);
+  assert(gApp.resultsRenders == 1);
+  assert(runtime.hasPendingTasks());
+
+  // The first slice yields before all rows have rendered.
+  gApp.rowRenders = 0;
+  const std::size_t filterPassesBefore = gApp.filterPasses;
+  assert(runtime.runNextTask());
+  assert(getWorkInProgressRoot(runtime) == &root);
+  assert(gApp.rowRenders > 0 && gApp.rowRenders < kRowCount);
+  assert(runtime.hasPendingTasks());
+
+  // Sync input interrupts it: the input commits right away and the
+  // transition restarts from the root afterwards.
+  typeText(runtime, *input, a);
+  assert(gApp.inputRendered == &a);
+  assert(includesSomeLane(root.pendingLanes, transitionLane));
+  assert(runtime.hasPendingTasks());
+
+  gApp.rowRenders = 0;
+  runtime.flushScheduledTasks();
+  assert(root.pendingLanes == NoLanes);
+  assert(*gApp.renderingQuery == a);
+  assert(gApp.rowRenders == kRowCount);
+  // The restarted render found the interrupted one's filter in the cache.
+  assert(gApp.filterPasses == filterPassesBefore + 1);
+
+  // useDeferredValue: the urgent render keeps the previous text and skips
+  // the rows; the deferred lane re-renders them with the new text.
+  gApp.deferText = true;
+  typeText(runtime, *results, a);
+  assert(*gApp.renderingQuery == a);
+  assert(root.pendingLanes == NoLanes);
+
+  gApp.rowRenders = 0;
+  const std::size_t resultsRendersBefore = gApp.resultsRenders;
+  typeText(runtime, *app, ab);
+  assert(gApp.inputRendered == &ab);
+  assert(gApp.resultsRenders == resultsRendersBefore + 1);
+  assert(*gApp.renderingQuery == a);
+  assert(gApp.rowRenders == 0);
+  assert((root.pendingLanes & TransitionLanes) != NoLanes);
+
+  runtime.flushScheduledTasks();
+  assert(*gApp.renderingQuery == ab);
+  assert(gApp.rowRenders == kRowCount);
+  assert(root.pendingLanes == NoLanes);
+
+  // One event updating the input and then the app: the first pass clones
+  // Results without rendering it, and the second must still see the hooks
+  // committed by the deferred render.
+  const std::string abc = "abc";
+  gApp.text = &abc;
+  gApp.rowRenders = 0;
+  runtime.runWithPriority(SchedulerPriority::ImmediatePriority, [&] {
+    scheduleFiberUpdate(runtime, *input);
+    scheduleFiberUpdate(runtime, *app);
+  });
+  assert(gApp.inputRendered == &abc);
+  assert(*gApp.renderingQuery == ab);
+  assert(gApp.rowRenders == 0);
+
+  runtime.flushScheduledTasks();
+  assert(*gApp.renderingQuery == abc);
+  assert(gApp.rowRenders == kRowCount);
+
+  // The deferred value is compared by value: equal text in another string
+  // neither spawns a deferred render nor changes the rows.
+  const std::string abcCopy = abc;
+  gApp.rowRenders = 0;
+  typeText(runtime, *app, abcCopy);
+  assert(gApp.inputRendered == &abcCopy);
+  assert(*gApp.renderingQuery == abc);
+  assert(gApp.rowRenders == 0);
+  assert(root.pendingLanes == NoLanes);
+  assert(!runtime.hasPendingTasks());
+
+  for (FiberNode* row : rows) {
+    releaseFiber(row);
+  }
+  releaseFiber(results);
+  releaseFiber(input);
+  releaseFiber(app);
+  delete hostRoot->alternate;
+  delete hostRoot;
+  return true;
+}
+
+} // namespace react::test
@@ -1,3 +1,6 @@
+#include "react-reconciler/ReactFiberClassUpdateQueue.h"
+#include "react-reconciler/ReactFiberSuspenseComponent.h"
+#include "react-reconciler/ReactFiberThrow.h"
 #include "react-reconciler/ReactFiberWorkLoop.h"
 #include "runtime/ReactRuntime.h"
 
@@ -643,6 +646,102 @@ bool runReactFiberWorkLoopStateTests() {
   assert(getWorkInProgressRootExitStatus(runtime) == RootExitStatus::SuspendedAtTheShell);
   assert(getWorkInProgressFiber(runtime) == nullptr);
 
+  // Class queues, captured error updates included, keep their state across
+  // idle commits; retry queues are released in bulk once the root is idle.
+  resetState(runtime);
+  FiberNode* errorSource = createFiber(WorkTag::FunctionComponent);
+  {
+    FiberRoot errorRoot{};
+    FiberNode* errorBoundary = createFiber(WorkTag::ClassComponent);
+    errorSource->returnFiber = errorBoundary;
+    static char thrownError[] = "boom";
+    setWorkInProgressRoot(runtime, &errorRoot);
+    setWorkInProgressRootRenderLanes(runtime, DefaultLane);
+    const bool fatal = throwException(
+      runtime, errorRoot, errorBoundary, *errorSource, thrownError, DefaultLane);
+    assert(!fatal);
+    auto* errorQueue = static_cast<ClassUpdateQueue*>(errorBoundary->updateQueue);
+    assert(errorQueue != nullptr);
+    assert(errorQueue->firstBaseUpdate != nullptr);
+    assert(errorQueue->firstBaseUpdate == errorQueue->lastBaseUpdate);
+    assert(errorQueue->firstBaseUpdate->tag == ClassUpdateTag::CaptureUpdate);
+    assert(errorRoot.updateQueueArena.liveObjectCount() == 2);
+    static int committedState = 0;
+    errorQueue->baseState = &committedState;
+
+    RetryQueue* retryQueue = errorRoot.retryQueueArena.createForFiber<RetryQueue>(*errorSource);
+    retryQueue->insert(nullptr);
+    assert(errorSource->updateQueue == retryQueue);
+    // The work-in-progress copy shares the queue pointer.
+    FiberNode* sourceWorkInProgress = createWorkInProgress(errorSource, nullptr);
+    assert(sourceWorkInProgress->updateQueue == retryQueue);
+    // A registered fiber destroyed without an alternate releases its queue,
+    // and the freed block is handed out again.
+    FiberNode* unmountedBoundary = createFiber(WorkTag::SuspenseComponent);
+    errorRoot.retryQueueArena.createForFiber<RetryQueue>(*unmountedBoundary);
+    const std::size_t retryBytes = errorRoot.retryQueueArena.bytesInUse();
+    delete unmountedBoundary;
+    assert(errorRoot.retryQueueArena.liveObjectCount() == 1);
+    unmountedBoundary = createFiber(WorkTag::SuspenseComponent);
+    errorRoot.retryQueueArena.createForFiber<RetryQueue>(*unmountedBoundary);
+    assert(errorRoot.retryQueueArena.bytesInUse() == retryBytes);
+    delete unmountedBoundary;
+    assert(errorRoot.retryQueueArena.liveObjectCount() == 1);
+
+    errorRoot.pendingLanes = DefaultLane;
+    assert(!releaseRootRetryQueueArenaIfIdle(errorRoot));
+    assert(errorSource->updateQueue == retryQueue);
+
+    errorRoot.pendingLanes = NoLanes;
+    const std::size_t reserved = errorRoot.retryQueueArena.bytesReserved();
+    assert(releaseRootRetryQueueArenaIfIdle(errorRoot));
+    assert(errorSource->updateQueue == nullptr);
+    assert(sourceWorkInProgress->updateQueue == nullptr);
+    assert(errorSource->queueOwnerArena == nullptr);
+    assert(errorRoot.retryQueueArena.liveObjectCount() == 0);
+    assert(errorRoot.retryQueueArena.bytesInUse() == 0);
+    assert(errorRoot.retryQueueArena.bytesReserved() == reserved);
+    assert(errorBoundary->updateQueue == errorQueue);
+    assert(errorQueue->baseState == &committedState);
+    assert(errorRoot.updateQueueArena.liveObjectCount() == 2);
+
+    // A clone for the work-in-progress boundary keeps the committed state.
+    FiberNode* boundaryWorkInProgress = createWorkInProgress(errorBoundary, nullptr);
+    boundaryWorkInProgress->updateQueue = nullptr;
+    ClassUpdateQueue& clone = ensureClassUpdateQueue(errorRoot, *boundaryWorkInProgress);
+    assert(&clone != errorQueue && clone.baseState == &committedState);
+    assert(errorRoot.updateQueueArena.liveObjectCount() == 4);
+
+    // A discarded clone and its copied update are reclaimed at the next
+    // commit, and repeated renders reuse their blocks.
+    const std::size_t cloneBytes = errorRoot.updateQueueArena.bytesInUse();
+    for (int render = 0; render < 8; ++render) {
+      boundaryWorkInProgress->updateQueue = errorQueue;
+      errorRoot.pendingLanes = DefaultLane;
+      compactRootQueueArenas(errorRoot);
+      assert(errorRoot.updateQueueArena.liveObjectCount() == 2);
+      assert(errorBoundary->updateQueue == errorQueue);
+      boundaryWorkInProgress->updateQueue = nullptr;
+      ClassUpdateQueue& retried = ensureClassUpdateQueue(errorRoot, *boundaryWorkInProgress);
+      assert(retried.baseState == &committedState);
+      assert(errorRoot.updateQueueArena.bytesInUse() == cloneBytes);
+    }
+    errorRoot.pendingLanes = NoLanes;
+
+    // Objects still live when the root goes away are destroyed with it.
+    ClassUpdate* pending = createClassErrorUpdate(errorRoot, SyncLane);
+    pushClassUpdate(errorRoot, *errorBoundary, pending);
+    assert(static_cast<ClassUpdateQueue*>(errorBoundary->updateQueue)->lastBaseUpdate == pending);
+    errorRoot.retryQueueArena.createForFiber<RetryQueue>(*errorSource);
+    setWorkInProgressRoot(runtime, nullptr);
+    delete sourceWorkInProgress;
+    delete boundaryWorkInProgress;
+    delete errorBoundary;
+  }
+  // errorSource outlived its root, which detached it.
+  assert(errorSource->updateQueue == nullptr && errorSource->queueOwnerArena == nullptr);
+  delete errorSource;
+
   delete parent;
   delete childA;
   delete childB;
@@ -151,6 +151,7 @@ WasmLayout buildKeyedSpanLayout(const std::vector<std::pair<std::string, std::st
     element.props_ptr = propsOffset;
     element.children_count = 0;
     element.children_ptr = 0;
+    element.subtree_hash = computeWasmSubtreeHash(builder.buffer.data(), element);
     const uint32_t elementOffset = builder.appendStruct(element);
 
     childValues.push_back(makeElementChild(elementOffset));
@@ -166,6 +167,7 @@ WasmLayout buildKeyedSpanLayout(const std::vector<std::pair<std::string, std::st
   root.props_ptr = 0;
   root.children_count = static_cast<uint32_t>(childValues.size());
   root.children_ptr = childrenOffset;
+  root.subtree_hash = computeWasmSubtreeHash(builder.buffer.data(), root);
   layout.rootOffset = builder.appendStruct(root);
 
   return layout;
@@ -244,6 +246,13 @@ struct RecordingHostInterface : HostInterface {
     HostInterface::commitHostUpdate(instance, oldProps, newProps, payload);
   }
 
+  void commitHostUpdate(
+      std::shared_ptr<ReactDOMInstance> instance,
+      const UpdatePayload& payload) override {
+    log.emplace_back("commit:" + describeInstance(instance));
+    HostInterface::commitHostUpdate(instance, payload);
+  }
+
   void commitHostTextUpdate(
       std::shared_ptr<ReactDOMInstance> instance,
       const std::string& oldText,
@@ -1,13 +1,1234 @@
+#include "react-dom/client/ReactDOMComponent.h"
+#include "react-dom/client/ReactDOMDiffProperties.h"
+#include "react-dom/client/ReactDOMPropAtoms.h"
+#include "react-dom/client/ReactDOMStyleValue.h"
+#include "runtime/ReactHostInterface.h"
+#include "runtime/ReactHostInterfaceV2.h"
 #include "runtime/ReactJSXRuntime.h"
+#include "runtime/ReactRuntime.h"
+#include "runtime/ReactTextChildren.h"
+#include "runtime/ReactUpdatePayload.h"
+#include "runtime/ReactWasmBridge.h"
 #include "TestRuntime.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace react::test {
 
 namespace jsi = facebook::jsi;
 
+namespace {
+
+jsx::WasmSerializedLayout renderCards(
+    ReactRuntime& reactRuntime,
+    TestRuntime& runtime,
+    const std::shared_ptr<ReactDOMInstance>& container,
+    const std::string& secondTitle) {
+  using namespace react::jsx;
+  auto makeStringValue = [&runtime](const std::string& text) {
+    return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
+  };
+
+  jsi::Array cards(runtime, 2);
+  for (size_t i = 0; i < 2; ++i) {
+    PropList props;
+    props.emplace_back("className", makeStringValue("card"));
+    props.emplace_back("title", makeStringValue(i == 0 ? "Revenue" : secondTitle));
+    props.emplace_back("width", jsi::Value(240.0));
+    cards.setValueAtIndex(
+        runtime, i, createJsxHostValue(runtime, jsx::jsx(runtime, makeStringValue("section"), std::move(props))));
+  }
+
+  PropList rootProps;
+  rootProps.emplace_back("id", makeStringValue("dashboard"));
+  rootProps.emplace_back("children", jsi::Value(runtime, cards));
+  auto layout = serializeToWasm(runtime, *jsxs(runtime, makeStringValue("div"), std::move(rootProps)));
+  __wasm_memory_buffer = layout.buffer.data();
+  reactRuntime.renderRootSync(runtime, layout.rootOffset, container);
+  __wasm_memory_buffer = nullptr;
+  return layout;
+}
+
+// Writes <div>{spans}</div> straight into a layout buffer, the way a non-JSX
+// producer would, with one keyed span per (key, className) pair and subtree
+// hashes computed children first.
+jsx::WasmSerializedLayout buildKeyedSpanLayout(const std::vector<std::pair<std::string, std::string>>& spans) {
+  jsx::WasmSerializedLayout layout;
+  auto& buffer = layout.buffer;
+  buffer.push_back(0); // Offset 0 is the null sentinel.
+  auto appendString = [&buffer](const std::string& text) {
+    const auto offset = static_cast<uint32_t>(buffer.size());
+    buffer.insert(buffer.end(), text.begin(), text.end());
+    buffer.push_back('\0');
+    return offset;
+  };
+  auto appendStruct = [&buffer](const auto& value) {
+    const auto offset = static_cast<uint32_t>(buffer.size());
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+    return offset;
+  };
+
+  const uint32_t divType = appendString("div");
+  const uint32_t spanType = appendString("span");
+  const uint32_t classNameKey = appendString("className");
+  std::vector<uint32_t> spanOffsets;
+  for (const auto& [key, className] : spans) {
+    WasmReactProp prop{};
+    prop.key_ptr = classNameKey;
+    prop.value.type = WasmValueType::String;
+    prop.value.data.ptrValue = appendString(className);
+    WasmReactElement span{};
+    span.type_name_ptr = spanType;
+    span.key_ptr = appendString(key);
+    span.props_count = 1;
+    span.props_ptr = appendStruct(prop);
+    span.subtree_hash = computeWasmSubtreeHash(buffer.data(), span);
+    spanOffsets.push_back(appendStruct(span));
+  }
+
+  WasmReactElement root{};
+  root.type_name_ptr = divType;
+  root.children_count = static_cast<uint32_t>(spanOffsets.size());
+  for (size_t i = 0; i < spanOffsets.size(); ++i) {
+    WasmReactValue child{};
+    child.type = WasmValueType::Element;
+    child.data.ptrValue = spanOffsets[i];
+    const uint32_t offset = appendStruct(child);
+    if (i == 0) {
+      root.children_ptr = offset;
+    }
+  }
+  root.subtree_hash = computeWasmSubtreeHash(buffer.data(), root);
+  layout.rootOffset = appendStruct(root);
+  return layout;
+}
+
+// Counts host child operations per node; `calls` counts host calls, so a
+// bulk operation adds one call and one per node it touches.
+struct HostOpCounts : HostInterface {
+  std::size_t creates{0};
+  std::size_t appends{0};
+  std::size_t inserts{0};
+  std::size_t removes{0};
+  std::size_t calls{0};
+  bool failCreates{false};
+
+  std::shared_ptr<ReactDOMInstance> createHostInstance(
+      jsi::Runtime& runtime,
+      const std::string& type,
+      const jsi::Object& props) override {
+    if (failCreates) {
+      throw std::runtime_error("host create failed");
+    }
+    ++creates;
+    return HostInterface::createHostInstance(runtime, type, props);
+  }
+
+  void appendHostChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child) override {
+    ++calls;
+    ++appends;
+    HostInterface::appendHostChild(std::move(parent), std::move(child));
+  }
+
+  void removeHostChild(std::shared_ptr<ReactDOMInstance> parent, std::shared_ptr<ReactDOMInstance> child) override {
+    ++calls;
+    ++removes;
+    HostInterface::removeHostChild(std::move(parent), std::move(child));
+  }
+
+  void insertHostChildBefore(
+      std::shared_ptr<ReactDOMInstance> parent,
+      std::shared_ptr<ReactDOMInstance> child,
+      std::shared_ptr<ReactDOMInstance> beforeChild) override {
+    ++calls;
+    ++inserts;
+    HostInterface::insertHostChildBefore(std::move(parent), std::move(child), std::move(beforeChild));
+  }
+
+  void removeAllHostChildren(std::shared_ptr<ReactDOMInstance> parent) override {
+    ++calls;
+    removes += parent->children.size();
+    HostInterface::removeAllHostChildren(std::move(parent));
+  }
+
+  void replaceHostChildren(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last) override {
+    ++calls;
+    removes += parent->children.size();
+    appends += static_cast<std::size_t>(last - first);
+    HostInterface::replaceHostChildren(std::move(parent), first, last);
+  }
+
+  void appendHostChildren(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last) override {
+    ++calls;
+    appends += static_cast<std::size_t>(last - first);
+    HostInterface::appendHostChildren(std::move(parent), first, last);
+  }
+
+  void moveHostChildrenBefore(
+      std::shared_ptr<ReactDOMInstance> parent,
+      ReactDOMInstanceIterator first,
+      ReactDOMInstanceIterator last,
+      std::shared_ptr<ReactDOMInstance> beforeChild) override {
+    ++calls;
+    inserts += static_cast<std::size_t>(last - first);
+    HostInterface::moveHostChildrenBefore(std::move(parent), first, last, std::move(beforeChild));
+  }
+
+  void reset() {
+    creates = appends = inserts = removes = calls = 0;
+  }
+};
+
+// A host written against HostInterfaceV2, recording what reaches it.
+struct HandleRecordingHost : HostInterfaceV2 {
+  std::vector<std::string> createdTypes;
+  std::size_t removes{0};
+  std::size_t appendedChildren{0};
+
+  std::shared_ptr<ReactDOMInstance> createInstance(
+      jsi::Runtime& runtime,
+      std::string_view type,
+      const jsi::Object& props) override {
+    createdTypes.emplace_back(type);
+    return HostInterfaceV2::createInstance(runtime, type, props);
+  }
+
+  void removeChild(HostInstanceHandle parent, HostInstanceHandle child) override {
+    assert(parent.kind == HostNodeKind::Element && child.kind == HostNodeKind::Element);
+    ++removes;
+    HostInterfaceV2::removeChild(parent, child);
+  }
+
+  void appendChildren(HostInstanceHandle parent, HostInstanceSpan children) override {
+    appendedChildren += children.size();
+    HostInterfaceV2::appendChildren(parent, children);
+  }
+};
+
+// Counts the JSI property reads made through it.
+struct PropertyReadCountingRuntime : TestRuntime {
+  std::size_t enumerations{0};
+  std::size_t reads{0};
+
+  jsi::Array getPropertyNames(const jsi::Object& object) override {
+    ++enumerations;
+    return TestRuntime::getPropertyNames(object);
+  }
+  jsi::Value getProperty(const jsi::Object& object, const jsi::PropNameID& name) override {
+    ++reads;
+    return TestRuntime::getProperty(object, name);
+  }
+  bool hasProperty(const jsi::Object& object, const jsi::PropNameID& name) override {
+    ++reads;
+    return TestRuntime::hasProperty(object, name);
+  }
+};
+
+// Renders <ul> with one <li key=k> per key, or a <p key=k> for keys listed
+// in `paragraphs`.
+void renderKeyedList(
+    ReactRuntime& reactRuntime,
+    TestRuntime& runtime,
+    const std::shared_ptr<ReactDOMInstance>& container,
+    const std::vector<std::string>& keys,
+    const std::string& paragraphs = std::string{}) {
+  using namespace react::jsx;
+  auto makeStringValue = [&runtime](const std::string& text) {
+    return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
+  };
+
+  jsi::Array items(runtime, keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const char* type = paragraphs.find(keys[i]) != std::string::npos ? "p" : "li";
+    items.setValueAtIndex(
+        runtime,
+        i,
+        createJsxHostValue(runtime, jsx::jsx(runtime, makeStringValue(type), PropList{}, makeStringValue(keys[i]))));
+  }
+
+  PropList listProps;
+  listProps.emplace_back("children", jsi::Value(runtime, items));
+  auto layout = serializeToWasm(runtime, *jsxs(runtime, makeStringValue("ul"), std::move(listProps)));
+  __wasm_memory_buffer = layout.buffer.data();
+  reactRuntime.renderRootSync(runtime, layout.rootOffset, container);
+  __wasm_memory_buffer = nullptr;
+}
+
+std::string childKeys(const ReactDOMInstance& list) {
+  std::string keys;
+  for (const auto& child : list.children) {
+    keys += child->getKey();
+  }
+  return keys;
+}
+
+} // namespace
+
+bool runReactKeyedChildrenTests() {
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  auto host = std::make_shared<HostOpCounts>();
+  reactRuntime.setHostInterface(host);
+  jsi::Object containerProps(runtime);
+  auto container = std::make_shared<ReactDOMComponent>(runtime, "root", containerProps);
+
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b", "c", "d", "e"});
+  auto list = container->children[0];
+  assert(childKeys(*list) == "abcde");
+  const auto firstA = list->children[0];
+  const auto firstE = list->children[4];
+
+  // Moving the last row to the front is a single host move.
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"e", "a", "b", "c", "d"});
+  assert(childKeys(*list) == "eabcd");
+  assert(host->inserts == 1 && host->appends == 0 && host->creates == 0 && host->removes == 0);
+  assert(list->children[0] == firstE && list->children[1] == firstA);
+
+  // Only rows outside the longest ordered run move: b and d here.
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"e", "b", "a", "c", "d"});
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b", "c", "d", "e"});
+  assert(childKeys(*list) == "abcde");
+  assert(host->inserts + host->appends == 2);
+
+  // A reversal keeps one row in place and moves the others.
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"e", "d", "c", "b", "a"});
+  assert(childKeys(*list) == "edcba");
+  assert(host->inserts + host->appends == 4 && host->creates == 0);
+
+  // Head inserts and tail deletes touch only the changed rows.
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b", "c", "d", "e"});
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"x", "y", "a", "b", "c", "d", "e"});
+  assert(childKeys(*list) == "xyabcde");
+  assert(host->creates == 2 && host->inserts == 2 && host->appends == 0 && host->removes == 0);
+  assert(list->children[2] == firstA);
+
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"x", "y", "a", "b"});
+  assert(childKeys(*list) == "xyab");
+  assert(host->removes == 3 && host->inserts == 0 && host->appends == 0);
+
+  // A keyed row whose type changed is replaced in place.
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"x", "y", "a", "b"}, "y");
+  assert(childKeys(*list) == "xyab");
+  assert(host->creates == 1 && host->removes == 1 && host->inserts == 1);
+  assert(std::static_pointer_cast<ReactDOMComponent>(list->children[1])->getType() == "p");
+
+  // A run of moved rows is placed with one host call.
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b", "c", "d", "e"});
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"c", "d", "e", "a", "b"});
+  assert(childKeys(*list) == "cdeab");
+  assert(host->calls == 1 && host->inserts == 2);
+
+  // Clearing, mounting into an empty list and replacing every row are each
+  // a single host call.
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {});
+  assert(list->children.empty());
+  assert(host->calls == 1 && host->removes == 5);
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b", "c"});
+  assert(childKeys(*list) == "abc");
+  assert(host->calls == 1 && host->appends == 3 && host->creates == 3);
+  const auto replacedA = list->children[0];
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"x", "y", "z", "w"});
+  assert(childKeys(*list) == "xyzw");
+  assert(host->calls == 1 && host->removes == 3 && host->appends == 4);
+  assert(replacedA->parent.expired());
+  for (const auto& child : list->children) {
+    assert(child->parent.lock() == list);
+  }
+
+  // Reconciler temporaries live in the scratch arena, which is rewound after
+  // every commit and reused by the next render.
+  RenderScratchArena& scratch = reactRuntime.renderScratchArena();
+  assert(scratch.bytesInUse() == 0);
+  const std::size_t reserved = scratch.bytesReserved();
+  assert(reserved > 0);
+  renderKeyedList(reactRuntime, runtime, container, {"w", "z", "y", "x"});
+  assert(childKeys(*list) == "wzyx");
+  assert(scratch.bytesInUse() == 0);
+  assert(scratch.bytesReserved() == reserved);
+
+  // A render the host aborts still rewinds it.
+  host->failCreates = true;
+  bool threw = false;
+  try {
+    renderKeyedList(reactRuntime, runtime, container, {"w", "z", "v"});
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  host->failCreates = false;
+  assert(threw);
+  assert(scratch.bytesInUse() == 0);
+
+  return true;
+}
+
+bool runReactHostInstancePoolTests() {
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  auto host = std::make_shared<HostOpCounts>();
+  reactRuntime.setHostInterface(host);
+  jsi::Object containerProps(runtime);
+  auto container = std::make_shared<ReactDOMComponent>(runtime, "root", containerProps);
+
+  // The pool is off by default: removed rows are simply freed.
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b"});
+  renderKeyedList(reactRuntime, runtime, container, {"c"});
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b"});
+  assert(reactRuntime.hostInstancePoolStats().hits == 0);
+  assert(reactRuntime.hostInstancePoolStats().released == 0);
+
+  reactRuntime.setHostInstancePoolCapacity(2);
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b", "c", "d", "e"});
+  auto list = container->children[0];
+  std::vector<std::weak_ptr<ReactDOMInstance>> firstRows(list->children.begin(), list->children.end());
+  const auto heldA = list->children[0];
+
+  // Rows still referenced elsewhere are never pooled, and the pool keeps at
+  // most two rows per type.
+  renderKeyedList(reactRuntime, runtime, container, {"x", "y", "z"});
+  const auto afterRemove = reactRuntime.hostInstancePoolStats();
+  assert(afterRemove.released == 2 && afterRemove.dropped == 2);
+  assert(heldA->parent.expired());
+
+  // Mounting new rows reuses the pooled ones, reset to the new key.
+  host->reset();
+  renderKeyedList(reactRuntime, runtime, container, {"p", "q", "r"});
+  const auto afterMount = reactRuntime.hostInstancePoolStats();
+  assert(afterMount.hits - afterRemove.hits == 2);
+  assert(afterMount.misses - afterRemove.misses == 1);
+  assert(host->creates == 1);
+  assert(childKeys(*list) == "pqr");
+  std::size_t recycled = 0;
+  for (const auto& child : list->children) {
+    assert(child->parent.lock() == list);
+    for (const auto& row : firstRows) {
+      recycled += row.lock() == child ? 1 : 0;
+    }
+  }
+  assert(recycled == 2);
+
+  // Disabling the pool frees what it holds.
+  reactRuntime.setHostInstancePoolCapacity(0);
+  renderKeyedList(reactRuntime, runtime, container, {"a"});
+  assert(reactRuntime.hostInstancePoolStats().hits == afterMount.hits);
+  for (const auto& row : firstRows) {
+    assert(row.expired() || row.lock() == heldA || row.lock()->parent.lock() == list);
+  }
+
+  return true;
+}
+
+bool runReactHostInterfaceV2Tests() {
+  TestRuntime runtime;
+  jsi::Object props(runtime);
+
+  // Handles borrow an instance and carry its node kind.
+  HostInterfaceV2 defaults;
+  auto element = defaults.createInstance(runtime, "li", props);
+  auto text = defaults.createTextInstance(runtime, "label");
+  const HostInstanceHandle elementHandle(element);
+  assert(elementHandle.kind == HostNodeKind::Element && elementHandle.instance == element.get());
+  assert(HostInstanceHandle(text).kind == HostNodeKind::Text);
+  assert(!HostInstanceHandle());
+  assert(element.use_count() == 1);
+  assert(elementHandle.retain() == element);
+  defaults.appendChild(element, text);
+  assert(element->children.size() == 1 && text->parent.lock() == element);
+  defaults.commitTextUpdate(text, "label", "renamed");
+  assert(text->getTextContent() == "renamed");
+
+  // A v2 host is driven directly by the reconciler.
+  ReactRuntime reactRuntime;
+  auto host = std::make_shared<HandleRecordingHost>();
+  reactRuntime.setHostInterface(host);
+  auto container = std::make_shared<ReactDOMComponent>(runtime, "root", props);
+  renderKeyedList(reactRuntime, runtime, container, {"a", "b", "c"});
+  assert((host->createdTypes == std::vector<std::string>{"ul", "li", "li", "li"}));
+  // The <ul> into the root, then its three rows.
+  assert(host->appendedChildren == 4);
+  auto list = container->children[0];
+  renderKeyedList(reactRuntime, runtime, container, {"a", "c"});
+  assert(host->removes == 1);
+  assert(childKeys(*list) == "ac");
+
+  return true;
+}
+
+std::string childTypes(const ReactDOMInstance& parent) {
+  std::string types;
+  for (const auto& child : parent.children) {
+    types += static_cast<const ReactDOMComponent&>(*child).getType();
+  }
+  return types;
+}
+
+bool runReactChildListTests() {
+  TestRuntime runtime;
+  jsi::Object props(runtime);
+  auto parent = std::make_shared<ReactDOMComponent>(runtime, "ul", props);
+  auto a = std::make_shared<ReactDOMComponent>(runtime, "a", props);
+  auto b = std::make_shared<ReactDOMComponent>(runtime, "b", props);
+  auto c = std::make_shared<ReactDOMComponent>(runtime, "c", props);
+  auto d = std::make_shared<ReactDOMComponent>(runtime, "d", props);
+
+  // Appends, inserts and the sibling links agree with positional reads.
+  parent->appendChild(a);
+  parent->appendChild(c);
+  parent->appendChild(a);
+  parent->insertChildBefore(b, c);
+  parent->insertChildBefore(d, nullptr);
+  assert(childTypes(*parent) == "abcd");
+  assert(parent->children.size() == 4);
+  assert(parent->children[1] == b && parent->children[3] == d);
+  assert(parent->children.front() == a && parent->children.back() == d);
+  assert(b->previousSibling() == a.get() && b->nextSibling() == c.get());
+  assert(a->previousSibling() == nullptr && d->nextSibling() == nullptr);
+  assert(b->parent.lock() == parent && parent->hasChild(*b));
+
+  // Moves and removals keep the index in step.
+  parent->insertChildBefore(d, a);
+  assert(childTypes(*parent) == "dabc" && parent->children[0] == d && parent->children[3] == c);
+  parent->insertChildBefore(b, b);
+  assert(childTypes(*parent) == "dabc");
+  parent->removeChild(c);
+  assert(childTypes(*parent) == "dab" && parent->children[2] == b);
+  assert(c->parent.expired() && c->nextSibling() == nullptr && c->previousSibling() == nullptr);
+  parent->removeChild(c);
+  assert(parent->children.size() == 3);
+  std::vector<std::shared_ptr<ReactDOMInstance>> run{b, d};
+  parent->moveChildrenBefore(run.data(), run.data() + run.size(), a);
+  assert(childTypes(*parent) == "bda");
+
+  // Adopting a child detaches it from its previous parent.
+  auto other = std::make_shared<ReactDOMComponent>(runtime, "ol", props);
+  other->appendChild(d);
+  assert(childTypes(*parent) == "ba" && childTypes(*other) == "d");
+  assert(d->parent.lock() == other && !parent->hasChild(*d));
+
+  // Parents own their children and release them when destroyed.
+  std::weak_ptr<ReactDOMInstance> weakA = a;
+  a.reset();
+  assert(!weakA.expired());
+  parent->removeAllChildren();
+  assert(weakA.expired() && parent->children.empty());
+  auto node = std::make_shared<ReactDOMComponent>(runtime, "div", props);
+  std::weak_ptr<ReactDOMInstance> leaf;
+  {
+    std::shared_ptr<ReactDOMInstance> tail = node;
+    for (int depth = 0; depth < 1000; ++depth) {
+      auto next = std::make_shared<ReactDOMComponent>(runtime, "div", props);
+      tail->appendChild(next);
+      tail = next;
+    }
+    leaf = tail;
+  }
+  node.reset();
+  assert(leaf.expired());
+
+  return true;
+}
+
+bool runReactInPlaceUpdateTests() {
+  PropertyReadCountingRuntime runtime;
+  auto makeStringValue = [&runtime](const std::string& text) {
+    return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
+  };
+
+  jsi::Object oldProps(runtime);
+  jsi::Object newProps(runtime);
+  for (int i = 0; i < 30; ++i) {
+    const std::string name = "data-" + std::to_string(i);
+    oldProps.setProperty(runtime, name.c_str(), makeStringValue("old"));
+    newProps.setProperty(runtime, name.c_str(), makeStringValue("old"));
+  }
+  oldProps.setProperty(runtime, "onClick", jsi::Object(runtime));
+  oldProps.setProperty(runtime, "title", makeStringValue("before"));
+  newProps.setProperty(runtime, "data-0", makeStringValue("new"));
+  newProps.setProperty(runtime, "children", makeStringValue("label"));
+  auto element = std::make_shared<ReactDOMComponent>(runtime, "div", oldProps);
+  assert(element->getProps().size() == 32 && element->getEventHandlers().size() == 1);
+
+  jsi::Object attributes(runtime);
+  attributes.setProperty(runtime, "data-0", makeStringValue("new"));
+  jsi::Array removedAttributes(runtime, 1);
+  removedAttributes.setValueAtIndex(runtime, 0, makeStringValue("title"));
+  jsi::Array removedEvents(runtime, 1);
+  removedEvents.setValueAtIndex(runtime, 0, makeStringValue("onClick"));
+  jsi::Object payload(runtime);
+  payload.setProperty(runtime, "attributes", attributes);
+  payload.setProperty(runtime, "removedAttributes", removedAttributes);
+  payload.setProperty(runtime, "removedEvents", removedEvents);
+
+  // Only the payload is enumerated; the 30 unchanged props are not read.
+  runtime.enumerations = runtime.reads = 0;
+  element->applyUpdate(newProps, payload);
+  assert(runtime.enumerations == 1);
+  assert(runtime.reads < 16);
+
+  // props_ and the event handlers end up matching newProps.
+  const auto& props = element->getProps();
+  assert(props.size() == 31 && props.count(internPropName("title")) == 0 && props.count(internPropName("onClick")) == 0);
+  assert(element->getEventHandlers().empty());
+  assert(element->getAttribute(runtime, "data-0").getString(runtime).utf8(runtime) == "new");
+  assert(element->getAttribute(runtime, "data-1").getString(runtime).utf8(runtime) == "old");
+  assert(element->getAttribute(runtime, "children").getString(runtime).utf8(runtime) == "label");
+
+  return true;
+}
+
+bool runReactPropAtomTests() {
+  // Known names map to their fixed atoms through the perfect hash.
+  for (std::size_t index = 1; index < kKnownPropNameCount; ++index) {
+    const std::string_view name = kKnownPropNames[index];
+    const PropAtom atom = internPropName(name);
+    assert(atom == knownPropAtom(name) && findPropAtom(name) == atom);
+    assert(propAtomIndex(atom) == index && propAtomName(atom) == name);
+    assert(isEventPropAtom(atom) == isEventPropName(name));
+  }
+  assert(isEventPropAtom(knownPropAtom("onClick")) && !isEventPropAtom(kClassNameAtom));
+  assert(kClassAtom != kClassNameAtom);
+  assert(internPropName("") == PropAtom::None && propAtomName(PropAtom::None).empty());
+
+  // Other names are interned on first use and keep their atom.
+  assert(findPropAtom("data-atom-test") == PropAtom::None);
+  const PropAtom dynamic = internPropName(std::string("data-atom-test"));
+  assert(dynamic != PropAtom::None && propAtomIndex(dynamic) >= kKnownPropNameCount);
+  assert(internPropName("data-atom-test") == dynamic && findPropAtom("data-atom-test") == dynamic);
+  assert(propAtomName(dynamic) == "data-atom-test" && !isEventPropAtom(dynamic));
+  const PropAtom customEvent = internPropName("onAtomTest");
+  assert(customEvent != dynamic && isEventPropAtom(customEvent));
+  // Names interned after a thread has looked some up are still found.
+  assert(propAtomName(customEvent) == "onAtomTest");
+  const PropAtom later = internPropName("data-atom-later");
+  assert(propAtomName(later) == "data-atom-later" && propAtomName(dynamic) == "data-atom-test");
+
+  // Payload ops carry the atom of their name.
+  UpdatePayload payload;
+  payload.set("title", UpdatePayloadValue::string("x"));
+  payload.remove("data-atom-test");
+  assert(payload.ops[0].atom == knownPropAtom("title") && payload.ops[1].atom == dynamic);
+
+  // Reading an unknown attribute does not intern its name.
+  TestRuntime runtime;
+  jsi::Object props(runtime);
+  ReactDOMComponent element(runtime, "div", props);
+  assert(element.getAttribute(runtime, "data-never-set").isUndefined());
+  assert(findPropAtom("data-never-set") == PropAtom::None);
+
+  return true;
+}
+
+bool runReactDiffPropertiesTests() {
+  TestRuntime runtime;
+  auto makeStringValue = [&runtime](const std::string& text) {
+    return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
+  };
+  jsi::Object handler(runtime);
+
+  jsi::Object previous(runtime);
+  previous.setProperty(runtime, "id", makeStringValue("a"));
+  previous.setProperty(runtime, "title", makeStringValue("kept"));
+  previous.setProperty(runtime, "width", 10.0);
+  previous.setProperty(runtime, "hidden", true);
+  previous.setProperty(runtime, "data-gone", makeStringValue("x"));
+  previous.setProperty(runtime, "onClick", handler);
+  previous.setProperty(runtime, "onBlur", handler);
+  previous.setProperty(runtime, "textContent", 5.0);
+  previous.setProperty(runtime, "children", makeStringValue("old"));
+
+  jsi::Object next(runtime);
+  next.setProperty(runtime, "id", makeStringValue("b"));
+  next.setProperty(runtime, "title", makeStringValue("kept"));
+  next.setProperty(runtime, "width", makeStringValue("10"));
+  next.setProperty(runtime, "hidden", true);
+  next.setProperty(runtime, "data-new", 1.0);
+  next.setProperty(runtime, "role", jsi::Value::null());
+  next.setProperty(runtime, "onClick", handler);
+  next.setProperty(runtime, "onFocus", handler);
+  next.setProperty(runtime, "textContent", makeStringValue("5"));
+  next.setProperty(runtime, "children", makeStringValue("new"));
+
+  const auto diff = diffReactDOMProperties(runtime, jsi::Value(runtime, previous), jsi::Value(runtime, next));
+  auto names = [](const auto& keys) {
+    assert(std::is_sorted(keys.begin(), keys.end()));
+    std::vector<std::string_view> result;
+    for (const ReactDOMPropKey& key : keys) {
+      result.push_back(key.getName());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+
+  // Equal values, and `children`, are left out; a number and a string with
+  // the same text differ; null for a prop that was absent removes it.
+  assert((names(diff.attributesToSet) == std::vector<std::string_view>{"data-new", "id", "width"}));
+  assert((names(diff.attributesToRemove) == std::vector<std::string_view>{"data-gone", "role"}));
+  assert((names(diff.eventsToSet) == std::vector<std::string_view>{"onFocus"}));
+  assert((names(diff.eventsToRemove) == std::vector<std::string_view>{"onBlur"}));
+  // textContent compares as text.
+  assert(!diff.textContent.has_value());
+  assert(diff.hasChanges());
+
+  const auto same = diffReactDOMProperties(runtime, jsi::Value(runtime, next), jsi::Value(runtime, next));
+  assert(!same.hasChanges());
+  const auto cleared = diffReactDOMProperties(runtime, jsi::Value(runtime, previous), jsi::Value::undefined());
+  assert(cleared.attributesToRemove.size() == 5 && cleared.eventsToRemove.size() == 2);
+  assert(cleared.textContent == std::string());
+
+  // Names the atom table lacks are diffed by name without interning them,
+  // events included, and reach the payload under the same names.
+  jsi::Object generated(runtime);
+  generated.setProperty(runtime, "data-diff-row-7", 7.0);
+  generated.setProperty(runtime, "onDiffOnly", handler);
+  const auto added = diffReactDOMProperties(runtime, jsi::Value::undefined(), jsi::Value(runtime, generated));
+  assert((names(added.attributesToSet) == std::vector<std::string_view>{"data-diff-row-7"}));
+  assert((names(added.eventsToSet) == std::vector<std::string_view>{"onDiffOnly"}));
+  const auto removed = diffReactDOMProperties(runtime, jsi::Value(runtime, generated), jsi::Value::undefined());
+  assert((names(removed.attributesToRemove) == std::vector<std::string_view>{"data-diff-row-7"}));
+  assert((names(removed.eventsToRemove) == std::vector<std::string_view>{"onDiffOnly"}));
+  assert(!diffReactDOMProperties(runtime, jsi::Value(runtime, generated), jsi::Value(runtime, generated)).hasChanges());
+  assert(findPropAtom("data-diff-row-7") == PropAtom::None && findPropAtom("onDiffOnly") == PropAtom::None);
+  jsi::Object payload = createReactDOMUpdatePayload(runtime, added);
+  assert(payload.getProperty(runtime, "attributes").asObject(runtime).hasProperty(runtime, "data-diff-row-7"));
+  assert(findPropAtom("data-diff-row-7") == PropAtom::None);
+
+  return true;
+}
+
+bool runReactStyleDiffTests() {
+  static_assert(isUnitlessNumberStyle("opacity") && isUnitlessNumberStyle("zIndex"));
+  static_assert(isUnitlessNumberStyle("WebkitFlexGrow") && isUnitlessNumberStyle("msGridRow"));
+  static_assert(!isUnitlessNumberStyle("width") && !isUnitlessNumberStyle("Webkitopacity"));
+
+  TestRuntime runtime;
+  auto makeStringValue = [&runtime](const std::string& text) {
+    return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
+  };
+
+  assert(dangerousStyleValue(runtime, "width", jsi::Value(10.0)) == "10px");
+  assert(dangerousStyleValue(runtime, "width", jsi::Value(0.0)) == "0");
+  assert(dangerousStyleValue(runtime, "opacity", jsi::Value(0.5)) == "0.5");
+  assert(dangerousStyleValue(runtime, "--gap", jsi::Value(4.0)) == "4");
+  assert(dangerousStyleValue(runtime, "color", makeStringValue("  red ")) == "red");
+  assert(dangerousStyleValue(runtime, "color", jsi::Value(true)).empty());
+  assert(dangerousStyleValue(runtime, "color", jsi::Value::null()).empty());
+
+  auto names = [](const auto& keys) {
+    assert(std::is_sorted(keys.begin(), keys.end()));
+    std::vector<std::string_view> result;
+    for (const ReactDOMPropKey& key : keys) {
+      result.push_back(key.getName());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+
+  jsi::Object previousStyle(runtime);
+  previousStyle.setProperty(runtime, "color", makeStringValue("red"));
+  previousStyle.setProperty(runtime, "width", 10.0);
+  previousStyle.setProperty(runtime, "opacity", 1.0);
+  previousStyle.setProperty(runtime, "top", 5.0);
+  previousStyle.setProperty(runtime, "left", 5.0);
+  jsi::Object previous(runtime);
+  previous.setProperty(runtime, "id", makeStringValue("box"));
+  previous.setProperty(runtime, "style", previousStyle);
+
+  jsi::Object nextStyle(runtime);
+  nextStyle.setProperty(runtime, "color", makeStringValue("red"));
+  nextStyle.setProperty(runtime, "width", 12.0);
+  nextStyle.setProperty(runtime, "opacity", 0.5);
+  nextStyle.setProperty(runtime, "top", makeStringValue(""));
+  nextStyle.setProperty(runtime, "--accent", makeStringValue("blue"));
+  jsi::Object next(runtime);
+  next.setProperty(runtime, "id", makeStringValue("box"));
+  next.setProperty(runtime, "style", nextStyle);
+
+  // Only the changed CSS properties are listed, and `style` never becomes
+  // an attribute; a property cleared with "" is removed.
+  const auto diff = diffReactDOMProperties(runtime, jsi::Value(runtime, previous), jsi::Value(runtime, next));
+  assert(diff.attributesToSet.empty() && diff.attributesToRemove.empty());
+  assert((names(diff.stylesToSet) == std::vector<std::string_view>{"--accent", "opacity", "width"}));
+  assert((names(diff.stylesToRemove) == std::vector<std::string_view>{"left", "top"}));
+  for (const auto& change : diff.stylesToSet) {
+    const std::string_view name = change.getName();
+    assert(change.value == (name == "width" ? "12px" : name == "opacity" ? "0.5" : "blue"));
+  }
+
+  // The payload carries the style changes to the component, which patches
+  // its styles and refreshes the `style` prop.
+  ReactDOMComponent element(runtime, "div", previous);
+  assert(element.getStyles().size() == 5 && element.getStyles().at(findPropAtom("width")) == "10px");
+  element.applyUpdate(next, createReactDOMUpdatePayload(runtime, diff));
+  const ReactDOMStyleMap& styles = element.getStyles();
+  assert(styles.size() == 4);
+  assert(styles.at(findPropAtom("color")) == "red" && styles.at(findPropAtom("width")) == "12px");
+  assert(styles.at(findPropAtom("opacity")) == "0.5" && styles.at(findPropAtom("--accent")) == "blue");
+  assert(jsi::Value::strictEquals(runtime, element.getAttribute(runtime, "style"), jsi::Value(runtime, nextStyle)));
+
+  // A string style that gives way to an object is removed first; an object
+  // that gives way to a string or to nothing is replaced as an attribute.
+  jsi::Object stringStyled(runtime);
+  stringStyled.setProperty(runtime, "style", makeStringValue("color: red"));
+  const auto toObject =
+      diffReactDOMProperties(runtime, jsi::Value(runtime, stringStyled), jsi::Value(runtime, next));
+  assert((names(toObject.attributesToRemove) == std::vector<std::string_view>{"style"}));
+  assert(toObject.stylesToSet.size() == 4 && toObject.stylesToRemove.empty());
+  const auto toString =
+      diffReactDOMProperties(runtime, jsi::Value(runtime, next), jsi::Value(runtime, stringStyled));
+  assert(toString.attributesToSet.size() == 1 && toString.attributesToSet[0].atom == kStyleAtom);
+  assert(toString.stylesToSet.empty() && toString.stylesToRemove.empty());
+  element.applyUpdate(stringStyled, createReactDOMUpdatePayload(runtime, toString));
+  assert(element.getStyles().empty());
+
+  const auto same = diffReactDOMProperties(runtime, jsi::Value(runtime, next), jsi::Value(runtime, next));
+  assert(!same.hasChanges());
+
+  // New props that keep the style object diff no CSS properties.
+  jsi::Object sameStyle(runtime);
+  sameStyle.setProperty(runtime, "id", makeStringValue("moved"));
+  sameStyle.setProperty(runtime, "style", nextStyle);
+  const auto kept = diffReactDOMProperties(runtime, jsi::Value(runtime, next), jsi::Value(runtime, sameStyle));
+  assert(kept.attributesToSet.size() == 1 && kept.stylesToSet.empty() && kept.stylesToRemove.empty());
+
+  // A style diffed as the next one keeps the values it was diffed with, so
+  // mutating it afterwards does not hide what the DOM was given.
+  nextStyle.setProperty(runtime, "width", 30.0);
+  jsi::Object resized(runtime);
+  resized.setProperty(runtime, "width", 30.0);
+  resized.setProperty(runtime, "color", makeStringValue("red"));
+  jsi::Object resizedProps(runtime);
+  resizedProps.setProperty(runtime, "style", resized);
+  const auto afterMutation =
+      diffReactDOMProperties(runtime, jsi::Value(runtime, next), jsi::Value(runtime, resizedProps));
+  assert((names(afterMutation.stylesToSet) == std::vector<std::string_view>{"width"}));
+  assert(afterMutation.stylesToSet[0].value == "30px");
+  assert((names(afterMutation.stylesToRemove) == std::vector<std::string_view>{"--accent", "opacity", "top"}));
+
+  return true;
+}
+
+bool runReactPropsFingerprintTests() {
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  jsi::Object containerProps(runtime);
+  auto container = std::make_shared<ReactDOMComponent>(runtime, "root", containerProps);
+
+  // Props fingerprints are stable across decodes of equal props.
+  auto first = renderCards(reactRuntime, runtime, container, "Churn");
+  auto second = renderCards(reactRuntime, runtime, container, "Churn");
+  const auto* firstBase = first.buffer.data();
+  const auto* secondBase = second.buffer.data();
+  __wasm_memory_buffer = first.buffer.data();
+  const uint64_t firstFingerprint = computeWasmPropsFingerprint(
+      0, *reinterpret_cast<const WasmReactElement*>(firstBase + first.rootOffset));
+  __wasm_memory_buffer = second.buffer.data();
+  const uint64_t secondFingerprint = computeWasmPropsFingerprint(
+      0, *reinterpret_cast<const WasmReactElement*>(secondBase + second.rootOffset));
+  __wasm_memory_buffer = nullptr;
+  assert(firstFingerprint != 0);
+  assert(firstFingerprint == secondFingerprint);
+
+  // The identical re-render skipped the whole tree on its subtree hash.
+  const auto& stats = reactRuntime.propsFingerprintStats();
+  assert(stats.skippedSubtrees == 1);
+  assert(stats.matchedElements == 0);
+  assert(stats.diffedElements == 0);
+
+  // A changed prop falls back to the diff for that element only; the root's
+  // props still match their fingerprint and the first card is skipped.
+  renderCards(reactRuntime, runtime, container, "Retention");
+  assert(stats.skippedSubtrees == 1);
+  assert(stats.matchedElements == 1);
+  assert(stats.skippedPropComparisons == 2);
+  assert(stats.diffedElements == 1);
+  auto secondCard = container->children[0]->children[1];
+  assert(secondCard->getAttribute(runtime, "title").getString(runtime).utf8(runtime) == "Retention");
+
+  // Host-side writes invalidate the fingerprint so the next render re-diffs.
+  secondCard->setAttribute("title", jsi::Value(runtime, jsi::String::createFromUtf8(runtime, "Edited")));
+  renderCards(reactRuntime, runtime, container, "Retention");
+  assert(stats.diffedElements == 1);
+  assert(secondCard->getAttribute(runtime, "title").getString(runtime).utf8(runtime) == "Retention");
+
+  return true;
+}
+
+bool runReactSubtreeHashTests() {
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  jsi::Object containerProps(runtime);
+  auto container = std::make_shared<ReactDOMComponent>(runtime, "root", containerProps);
+
+  // Equal trees hash equally; a change deep in one card changes the hash of
+  // that card and the root only.
+  auto first = renderCards(reactRuntime, runtime, container, "Churn");
+  auto second = renderCards(reactRuntime, runtime, container, "Retention");
+  const auto* firstRoot = reinterpret_cast<const WasmReactElement*>(first.buffer.data() + first.rootOffset);
+  const auto* secondRoot = reinterpret_cast<const WasmReactElement*>(second.buffer.data() + second.rootOffset);
+  const auto* firstCards = reinterpret_cast<const WasmReactValue*>(first.buffer.data() + firstRoot->children_ptr);
+  const auto* secondCards = reinterpret_cast<const WasmReactValue*>(second.buffer.data() + secondRoot->children_ptr);
+  auto cardHash = [](const jsx::WasmSerializedLayout& layout, const WasmReactValue& card) -> uint64_t {
+    return reinterpret_cast<const WasmReactElement*>(layout.buffer.data() + card.data.ptrValue)->subtree_hash;
+  };
+  assert(firstRoot->subtree_hash != 0);
+  assert(firstRoot->subtree_hash != secondRoot->subtree_hash);
+  assert(cardHash(first, firstCards[0]) == cardHash(second, secondCards[0]));
+  assert(cardHash(first, firstCards[1]) != cardHash(second, secondCards[1]));
+
+  // Host-side changes below a skipped subtree reset the hashes on the path to
+  // it, so the next render repairs the change.
+  auto firstCard = container->children[0]->children[0];
+  assert(firstCard->subtreeHash != 0);
+  firstCard->setAttribute("title", jsi::Value(runtime, jsi::String::createFromUtf8(runtime, "Edited")));
+  assert(firstCard->subtreeHash == 0);
+  assert(container->children[0]->subtreeHash == 0);
+  renderCards(reactRuntime, runtime, container, "Retention");
+  const auto& stats = reactRuntime.propsFingerprintStats();
+  assert(stats.skippedSubtrees == 1);
+  assert(stats.diffedElements == 1);
+  assert(firstCard->getAttribute(runtime, "title").getString(runtime).utf8(runtime) == "Revenue");
+  assert(container->children[0]->subtreeHash == secondRoot->subtree_hash);
+
+  // A hand-written layout hashes like serializeToWasm's encoding of the same
+  // tree, and keyed children are skipped by hash wherever they move.
+  using namespace react::jsx;
+  auto makeStringValue = [&runtime](const std::string& text) {
+    return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
+  };
+  jsi::Array spans(runtime, 2);
+  const char* const keys[] = {"a", "b"};
+  for (size_t i = 0; i < 2; ++i) {
+    PropList props;
+    props.emplace_back("className", makeStringValue(std::string("old") + (i == 0 ? "A" : "B")));
+    spans.setValueAtIndex(
+        runtime,
+        i,
+        createJsxHostValue(
+            runtime,
+            jsx::jsx(runtime, makeStringValue("span"), std::move(props), std::optional<jsi::Value>(makeStringValue(keys[i])))));
+  }
+  PropList divProps;
+  divProps.emplace_back("children", jsi::Value(runtime, spans));
+  auto serialized = serializeToWasm(runtime, *jsxs(runtime, makeStringValue("div"), std::move(divProps)));
+  auto rootHash = [](const WasmSerializedLayout& layout) {
+    return reinterpret_cast<const WasmReactElement*>(layout.buffer.data() + layout.rootOffset)->subtree_hash;
+  };
+  auto initial = buildKeyedSpanLayout({{"a", "oldA"}, {"b", "oldB"}});
+  assert(rootHash(initial) != 0);
+  assert(rootHash(initial) == rootHash(serialized));
+
+  auto keyedContainer = std::make_shared<ReactDOMComponent>(runtime, "root", containerProps);
+  auto renderLayout = [&](const WasmSerializedLayout& layout) {
+    __wasm_memory_buffer = const_cast<uint8_t*>(layout.buffer.data());
+    reactRuntime.renderRootSync(runtime, layout.rootOffset, keyedContainer);
+    __wasm_memory_buffer = nullptr;
+  };
+  renderLayout(initial);
+  auto list = keyedContainer->children[0];
+  const auto spanA = list->children[0];
+  const auto spanB = list->children[1];
+
+  auto updated = buildKeyedSpanLayout({{"a", "newA"}, {"b", "oldB"}});
+  renderLayout(updated);
+  assert(stats.skippedSubtrees == 1);
+  assert(stats.diffedElements == 1);
+  assert(list->children[0] == spanA && list->children[1] == spanB);
+  assert(spanA->getAttribute(runtime, "className").getString(runtime).utf8(runtime) == "newA");
+
+  auto reordered = buildKeyedSpanLayout({{"b", "oldB"}, {"a", "newA"}});
+  renderLayout(reordered);
+  assert(stats.skippedSubtrees == 2);
+  assert(stats.diffedElements == 0);
+  assert(childKeys(*list) == "ba");
+  assert(list->children[0] == spanB && list->children[1] == spanA);
+
+  return true;
+}
+
+struct PayloadRecorder : HostInterface {
+  std::vector<std::string> ops;
+  // Set values as text, copied because the payload's views end with the call.
+  std::vector<std::string> values;
+  std::vector<PropAtom> atoms;
+  std::size_t jsiUpdates{0};
+
+  void commitHostUpdate(std::shared_ptr<ReactDOMInstance> instance, const UpdatePayload& payload) override {
+    for (const auto& op : payload.ops) {
+      ops.push_back((op.remove ? "-" : "+") + std::string(op.style ? "style." : "") + std::string(op.name));
+      atoms.push_back(op.atom);
+      if (op.remove) {
+        continue;
+      }
+      switch (op.value.kind) {
+        case UpdatePayloadValue::Kind::String:
+          values.emplace_back(op.value.stringValue);
+          break;
+        case UpdatePayloadValue::Kind::Boolean:
+          values.emplace_back(op.value.boolValue ? "true" : "false");
+          break;
+        case UpdatePayloadValue::Kind::Number:
+          values.push_back(numberToText(op.value.numberValue));
+          break;
+        default:
+          values.emplace_back("null");
+          break;
+      }
+    }
+    HostInterface::commitHostUpdate(instance, payload);
+  }
+
+  void commitHostUpdate(
+      std::shared_ptr<ReactDOMInstance> instance,
+      const jsi::Object& oldProps,
+      const jsi::Object& newProps,
+      const jsi::Object& payload) override {
+    ++jsiUpdates;
+    HostInterface::commitHostUpdate(instance, oldProps, newProps, payload);
+  }
+};
+
+bool runReactLayoutReconcileTests() {
+  using namespace react::jsx;
+
+  TestRuntime runtime;
+  ReactRuntime reactRuntime;
+  auto host = std::make_shared<PayloadRecorder>();
+  reactRuntime.setHostInterface(host);
+  jsi::Object containerProps(runtime);
+  auto container = std::make_shared<ReactDOMComponent>(runtime, "root", containerProps);
+
+  auto render = [&](bool compact, const std::string& label, double count) {
+    PropList props;
+    if (!compact) {
+      props.emplace_back("className", jsi::Value(runtime, jsi::String::createFromUtf8(runtime, "badge")));
+    }
+    props.emplace_back("title", jsi::Value(runtime, jsi::String::createFromUtf8(runtime, label)));
+    props.emplace_back("hidden", jsi::Value(compact));
+    jsi::Array children(runtime, 4);
+    children.setValueAtIndex(runtime, 0, jsi::String::createFromUtf8(runtime, label));
+    children.setValueAtIndex(runtime, 1, jsi::Value::null());
+    children.setValueAtIndex(runtime, 2, jsi::String::createFromUtf8(runtime, ": "));
+    children.setValueAtIndex(runtime, 3, jsi::Value(count));
+    props.emplace_back("children", jsi::Value(runtime, children));
+    auto layout = serializeToWasm(runtime, *jsxs(runtime, jsi::String::createFromUtf8(runtime, "span"), std::move(props)));
+    __wasm_memory_buffer = layout.buffer.data();
+    reactRuntime.renderRootSync(runtime, layout.rootOffset, container);
+    __wasm_memory_buffer = nullptr;
+  };
+
+  // Props and text children are read straight from the layout buffer.
+  render(false, "Inbox", 3);
+  assert(container->children.size() == 1);
+  auto badge = std::static_pointer_cast<ReactDOMComponent>(container->children[0]);
+  assert(badge->getType() == "span");
+  assert(badge->getProps().size() == 3);
+  assert(badge->getAttribute(runtime, "title").getString(runtime).utf8(runtime) == "Inbox");
+  assert(badge->getAttribute(runtime, "hidden").getBool() == false);
+  // Adjacent text children render as a single text node.
+  assert(badge->children.size() == 1);
+  assert(badge->children[0]->getTextContent() == "Inbox: 3");
+
+  // Changed props are patched, dropped props removed, and text updated in place.
+  auto firstText = badge->children[0];
+  render(true, "Archive", 12);
+  // The update reaches the host as one native payload, never as JSI objects.
+  assert(host->jsiUpdates == 0);
+  assert((host->ops == std::vector<std::string>{"+title", "+hidden", "-className"}));
+  assert((host->values == std::vector<std::string>{"Archive", "true"}));
+  assert(host->atoms.back() == kClassNameAtom);
+  assert(host->atoms[0] == findPropAtom("title"));
+  assert(container->children[0] == badge);
+  assert(badge->getProps().count(kClassNameAtom) == 0);
+  assert(badge->getAttribute(runtime, "title").getString(runtime).utf8(runtime) == "Archive");
+  assert(badge->getAttribute(runtime, "hidden").getBool() == true);
+  assert(badge->children[0] == firstText);
+  assert(firstText->getTextContent() == "Archive: 12");
+
+  // String props are compared with the component's native copy, which lasts
+  // until the prop is written again.
+  const PropAtom titleAtom = findPropAtom("title");
+  const std::string* cachedTitle = badge->getStringProp(titleAtom);
+  assert(cachedTitle != nullptr && *cachedTitle == "Archive");
+  assert(badge->getStringProp(findPropAtom("hidden")) == nullptr);
+  host->ops.clear();
+  render(false, "Archive", 12);
+  assert((host->ops == std::vector<std::string>{"+className", "+hidden"}));
+  assert(badge->getStringProp(titleAtom) == cachedTitle);
+  render(false, "Sent", 12);
+  assert(*badge->getStringProp(titleAtom) == "Sent");
+
+  // Dropping many props at once removes each of them exactly once.
+  auto renderData = [&](int count, int step) {
+    PropList props;
+    for (int i = 0; i < count; i += step) {
+      props.emplace_back("data-" + std::to_string(i), jsi::Value(static_cast<double>(i)));
+    }
+    auto layout = serializeToWasm(runtime, *jsx::jsx(runtime, jsi::String::createFromUtf8(runtime, "div"), std::move(props)));
+    __wasm_memory_buffer = layout.buffer.data();
+    reactRuntime.renderRootSync(runtime, layout.rootOffset, container);
+    __wasm_memory_buffer = nullptr;
+  };
+  renderData(40, 1);
+  auto grid = std::static_pointer_cast<ReactDOMComponent>(container->children[0]);
+  assert(grid->getProps().size() == 40);
+  host->ops.clear();
+  renderData(40, 4);
+  assert(container->children[0] == grid);
+  assert(host->ops.size() == 30);
+  std::vector<std::string> removed = host->ops;
+  std::sort(removed.begin(), removed.end());
+  assert(std::unique(removed.begin(), removed.end()) == removed.end());
+  assert(std::all_of(removed.begin(), removed.end(), [](const std::string& op) { return op[0] == '-'; }));
+  assert(grid->getProps().size() == 10);
+  assert(grid->getProps().count(internPropName("data-4")) == 1);
+  assert(grid->getProps().count(internPropName("data-5")) == 0);
+
+  // A style object is diffed per CSS property against the committed styles
+  // and reaches the host as style ops, not as a new `style` prop.
+  auto makeStyle = [&](const char* color, double width, bool withTop) {
+    jsi::Object style(runtime);
+    style.setProperty(runtime, "color", jsi::String::createFromUtf8(runtime, color));
+    style.setProperty(runtime, "width", width);
+    style.setProperty(runtime, "opacity", 1.0);
+    if (withTop) {
+      style.setProperty(runtime, "top", 5.0);
+    }
+    return jsi::Value(runtime, style);
+  };
+  auto renderStyled = [&](jsi::Value style) {
+    PropList props;
+    props.emplace_back("id", jsi::Value(runtime, jsi::String::createFromUtf8(runtime, "box")));
+    props.emplace_back("style", std::move(style));
+    auto layout = serializeToWasm(runtime, *jsx::jsx(runtime, jsi::String::createFromUtf8(runtime, "p"), std::move(props)));
+    __wasm_memory_buffer = layout.buffer.data();
+    reactRuntime.renderRootSync(runtime, layout.rootOffset, container);
+    __wasm_memory_buffer = nullptr;
+  };
+  auto sortedOps = [&]() {
+    std::vector<std::string> ops = host->ops;
+    std::sort(ops.begin(), ops.end());
+    return ops;
+  };
+  auto styleText = [](const ReactDOMComponent& component, const char* name) {
+    auto it = component.getStyles().find(internPropName(name));
+    return it != component.getStyles().end() ? it->second : std::string();
+  };
+
+  renderStyled(makeStyle("red", 10, true));
+  auto box = std::static_pointer_cast<ReactDOMComponent>(container->children[0]);
+  assert(box->getType() == "p");
+  assert(box->getStyles().size() == 4);
+  assert(styleText(*box, "width") == "10px" && styleText(*box, "top") == "5px");
+  assert(styleText(*box, "color") == "red" && styleText(*box, "opacity") == "1");
+  const jsi::Object firstStyle = box->getAttribute(runtime, "style").getObject(runtime);
+
+  // Only the properties whose DOM text changes are sent; " red " trims to
+  // the committed "red".
+  host->ops.clear();
+  host->values.clear();
+  renderStyled(makeStyle(" red ", 12, false));
+  assert(container->children[0] == box);
+  assert(host->jsiUpdates == 0);
+  assert((sortedOps() == std::vector<std::string>{"+style.width", "-style.top"}));
+  assert((host->values == std::vector<std::string>{"12"}));
+  assert(box->getStyles().size() == 3);
+  assert(styleText(*box, "width") == "12px" && styleText(*box, "top").empty());
+  // The `style` prop is patched on a copy; the committed object is untouched.
+  const jsi::Object patchedStyle = box->getAttribute(runtime, "style").getObject(runtime);
+  assert(patchedStyle.getProperty(runtime, "width").getNumber() == 12);
+  assert(!patchedStyle.hasProperty(runtime, "top"));
+  assert(firstStyle.getProperty(runtime, "width").getNumber() == 10);
+
+  // An equal style object sends nothing.
+  host->ops.clear();
+  renderStyled(makeStyle(" red ", 12, false));
+  assert(host->ops.empty());
+
+  // A string style replaces the declarations, and an object after it is
+  // applied in full.
+  renderStyled(jsi::Value(runtime, jsi::String::createFromUtf8(runtime, "color: blue")));
+  assert(box->getStyles().empty());
+  host->ops.clear();
+  renderStyled(makeStyle("blue", 0, false));
+  assert((sortedOps() == std::vector<std::string>{"+style.color", "+style.opacity", "+style.width", "-style"}));
+  assert(host->ops.front() == "-style");
+  assert(styleText(*box, "color") == "blue" && styleText(*box, "width") == "0");
+  assert(box->getAttribute(runtime, "style").getObject(runtime).getProperty(runtime, "opacity").getNumber() == 1);
+
+  return true;
+}
+
+bool runReactTextChildrenTests() {
+  using namespace react::jsx;
+
+  // Numbers print as JavaScript's Number.prototype.toString does.
+  const std::pair<double, const char*> numbers[] = {
+      {0, "0"},
+      {-0.0, "0"},
+      {42, "42"},
+      {-1.5, "-1.5"},
+      {0.1 + 0.2, "0.30000000000000004"},
+      {123456789012, "123456789012"},
+      {1e20, "100000000000000000000"},
+      {1e21, "1e+21"},
+      {0.000001, "0.000001"},
+      {1.5e-7, "1.5e-7"},
+      {5e-324, "5e-324"},
+      {1.7976931348623157e308, "1.7976931348623157e+308"},
+      {std::numeric_limits<double>::quiet_NaN(), "NaN"},
+      {-std::numeric_limits<double>::infinity(), "-Infinity"},
+  };
+  for (const auto& [value, expected] : numbers) {
+    assert(numberToText(value) == expected);
+  }
+
+  // The JSX runtime merges adjacent string and number children and keeps
+  // lone ones as they are.
+  TestRuntime runtime;
+  jsi::Array children(runtime, 5);
+  children.setValueAtIndex(runtime, 0, jsi::String::createFromUtf8(runtime, "Total: "));
+  children.setValueAtIndex(runtime, 1, jsi::Value(2.5));
+  children.setValueAtIndex(runtime, 2, jsi::Value(false));
+  children.setValueAtIndex(
+      runtime, 3, createJsxHostValue(runtime, jsx::jsx(runtime, jsi::String::createFromUtf8(runtime, "br"), {})));
+  children.setValueAtIndex(runtime, 4, jsi::Value(7));
+  PropList props;
+  props.emplace_back("children", jsi::Value(runtime, children));
+  auto element = jsxs(runtime, jsi::String::createFromUtf8(runtime, "p"), std::move(props));
+  assert(element->children.size() == 3);
+  assert(element->children[0].kind == ValueKind::String);
+  assert(std::get<std::string>(element->children[0].payload) == "Total: 2.5");
+  assert(element->children[1].kind == ValueKind::Element);
+  assert(element->children[2].kind == ValueKind::Number);
+
+  return true;
+}
+
 bool runReactJSXRuntimeTests() {
   using namespace react::jsx;
 
@@ -17,14 +1238,14 @@ bool runReactJSXRuntimeTests() {
     return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, text));
   };
 
-  PropList childProps{
-      {"className", makeStringValue("chip")},
-      {"children", makeStringValue("Alpha")}};
+  PropList childProps;
+  childProps.emplace_back("className", makeStringValue("chip"));
+  childProps.emplace_back("children", makeStringValue("Alpha"));
 
-  auto child = jsx(
+  auto child = react::jsx::jsx(
       runtime,
       makeStringValue("span"),
-      childProps,
+      std::move(childProps),
       std::optional<jsi::Value>(makeStringValue("alpha")));
   assert(child != nullptr);
   assert(child->type.isString());
@@ -42,14 +1263,14 @@ bool runReactJSXRuntimeTests() {
   assert(child->children[0].kind == ValueKind::String);
   assert(std::get<std::string>(child->children[0].payload) == "Alpha");
 
-  PropList rootProps{
-      {"id", makeStringValue("root")}};
+  PropList rootProps;
+  rootProps.emplace_back("id", makeStringValue("root"));
 
-  auto childrenArray = runtime.createArray(1);
+  jsi::Array childrenArray(runtime, 1);
   childrenArray.setValueAtIndex(runtime, 0, createJsxHostValue(runtime, child));
   rootProps.emplace_back("children", jsi::Value(runtime, childrenArray));
 
-  auto root = jsxs(runtime, makeStringValue("div"), rootProps);
+  auto root = jsxs(runtime, makeStringValue("div"), std::move(rootProps));
   assert(root != nullptr);
   assert(root->props.size() == 1);
   assert(root->children.size() == 1);
@@ -88,16 +1309,16 @@ bool runReactJSXRuntimeTests() {
   const auto* textValue = reinterpret_cast<const char*>(base + textChild->data.ptrValue);
   assert(std::strcmp(textValue, "Alpha") == 0);
 
-  PropList devConfig{
-      {"className", makeStringValue("chip")},
-      {"children", makeStringValue("Beta")},
-      {"key", makeStringValue("beta")}};
+  PropList devConfig;
+  devConfig.emplace_back("className", makeStringValue("chip"));
+  devConfig.emplace_back("children", makeStringValue("Beta"));
+  devConfig.emplace_back("key", makeStringValue("beta"));
 
   SourceLocation location{"App.jsx", 42, 7};
   auto devElement = jsxDEV(
       runtime,
     makeStringValue("span"),
-      devConfig,
+      std::move(devConfig),
       std::nullopt,
       location,
       std::optional<jsi::Value>(makeStringValue("ref")));
@@ -113,7 +1334,10 @@ bool runReactJSXRuntimeTests() {
   assert(devElement->props[0].second.isString());
   assert(devElement->props[0].second.getString(runtime).utf8(runtime) == "chip");
 
-  return true;
+  return runReactPropsFingerprintTests() && runReactKeyedChildrenTests() && runReactLayoutReconcileTests() &&
+      runReactSubtreeHashTests() && runReactTextChildrenTests() && runReactHostInstancePoolTests() &&
+      runReactHostInterfaceV2Tests() && runReactChildListTests() && runReactInPlaceUpdateTests() &&
+      runReactPropAtomTests() && runReactDiffPropertiesTests() && runReactStyleDiffTests();
 }
 
 } // namespace react::test
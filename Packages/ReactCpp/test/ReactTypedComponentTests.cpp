@@ -0,0 +1,213 @@
+#include "react-dom/client/ReactDOMComponent.h"
+#include "runtime/ReactRuntime.h"
+#include "runtime/ReactTypedComponent.h"
+#include "runtime/ReactWindowedList.h"
+#include "TestRuntime.h"
+
+#include <cassert>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace react::test {
+
+namespace {
+
+int gRowRenders = 0;
+
+struct Row {
+  struct Props {
+    int id;
+    std::string label;
+    bool selected;
+    auto tie() const {
+      return std::tie(id, label, selected);
+    }
+  };
+
+  static TypedElement render(const Props& props) {
+    ++gRowRenders;
+    TypedHostProps hostProps{{"className", std::string(props.selected ? "row selected" : "row")}};
+    if (props.selected) {
+      hostProps.push_back({"ariaSelected", true});
+    }
+    return typedHost("li", std::move(hostProps), {typedText(props.label)});
+  }
+};
+
+struct List {
+  struct Props {
+    std::vector<Row::Props> rows;
+    // The list always re-renders; only its rows are memoized.
+    bool operator==(const Props&) const {
+      return false;
+    }
+  };
+
+  static TypedElement render(const Props& props) {
+    std::vector<TypedElement> children;
+    for (const auto& row : props.rows) {
+      children.push_back(typedComponent<Row>(row, std::to_string(row.id)));
+    }
+    return typedHost("ul", {}, std::move(children));
+  }
+};
+
+// The spacer height as the host sees it: the inline style text, checked
+// for its exact form and parsed back to pixels.
+double heightOf(TestRuntime& rt, const std::shared_ptr<ReactDOMInstance>& instance) {
+  assert(instance->getAttribute(rt, "height").isUndefined());
+  auto value = instance->getAttribute(rt, "style");
+  assert(value.isString());
+  const std::string style = value.getString(rt).utf8(rt);
+  const std::string prefix = "height: ";
+  assert(style.size() > prefix.size() + 2 && style.compare(0, prefix.size(), prefix) == 0);
+  assert(style.compare(style.size() - 2, 2, "px") == 0);
+  return std::stod(style.substr(prefix.size(), style.size() - prefix.size() - 2));
+}
+
+std::string classNameOf(TestRuntime& rt, const std::shared_ptr<ReactDOMInstance>& instance) {
+  auto value = instance->getAttribute(rt, "className");
+  return value.isString() ? value.getString(rt).utf8(rt) : std::string{};
+}
+
+} // namespace
+
+bool runReactWindowedListTests() {
+  // Rows alternate between 10 and 30 units tall: their tops are 0, 10, 40,
+  // 50, 80 and 90.
+  WindowedListLayout layout;
+  layout.reset(6, [](std::size_t index) { return index % 2 == 0 ? 10.0 : 30.0; });
+  assert(layout.totalHeight() == 120);
+  assert(layout.rowOffset(3) == 50);
+  assert((layout.rowsInViewport(0, 10) == WindowRange{0, 1}));
+  assert((layout.rowsInViewport(5, 10) == WindowRange{0, 2}));
+  assert((layout.rowsInViewport(85, 100) == WindowRange{4, 6}));
+  assert((layout.rowsInViewport(120, 10) == WindowRange{6, 6}));
+
+  TestRuntime rt;
+  ReactRuntime runtime;
+  facebook::jsi::Object rootProps(rt);
+  auto container = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+
+  gRowRenders = 0;
+  WindowedList list(
+      {1000,
+       [](std::size_t) { return 20.0; },
+       [](std::size_t index) {
+         return typedComponent<Row>({static_cast<int>(index), "Row " + std::to_string(index), false});
+       },
+       {},
+       2});
+  list.setViewport(0, 100);
+  runtime.renderTypedRootSync(rt, list.render(), container);
+  auto host = container->children[0];
+
+  // Only the five visible rows and two overscan rows are mounted, between
+  // spacers for the other 993.
+  assert((list.window() == WindowRange{0, 7}));
+  assert(gRowRenders == 7);
+  assert(host->children.size() == 9);
+  assert(heightOf(rt, host->children[0]) == 0);
+  assert(heightOf(rt, host->children[8]) == 993 * 20);
+  assert(host->children[8]->getAttribute(rt, "style").getString(rt).utf8(rt) == "height: 19860px");
+  assert(host->children[1]->children[0]->getTextContent() == "Row 0");
+
+  // Scrolling by two rows mounts the two that enter the window and removes
+  // the two that leave it; the rest keep their instances and bail out.
+  auto rowFour = host->children[5];
+  gRowRenders = 0;
+  list.setViewport(80, 100);
+  runtime.renderTypedRootSync(rt, list.render(), container);
+  const auto& stats = runtime.getLastTypedRenderStats();
+  assert((list.window() == WindowRange{2, 11}));
+  assert(gRowRenders == 4);
+  assert(stats.hostRemovals == 2);
+  assert(host->children.size() == 11);
+  assert(host->children[3] == rowFour);
+  assert(heightOf(rt, host->children[0]) == 40);
+
+  gRowRenders = 0;
+  list.setViewport(120, 100);
+  runtime.renderTypedRootSync(rt, list.render(), container);
+  assert((list.window() == WindowRange{4, 13}));
+  assert(gRowRenders == 2);
+  assert(runtime.getLastTypedRenderStats().hostRemovals == 2);
+  assert(host->children[1] == rowFour);
+  assert(heightOf(rt, host->children[10]) == (1000 - 13) * 20);
+
+  // Jumping to the end replaces the whole window.
+  list.setViewport(1000 * 20 - 100, 100);
+  runtime.renderTypedRootSync(rt, list.render(), container);
+  assert((list.window() == WindowRange{993, 1000}));
+  assert(host->children.size() == 9);
+  assert(host->children[7]->children[0]->getTextContent() == "Row 999");
+  assert(heightOf(rt, host->children[8]) == 0);
+
+  // Shrinking the list pulls the window back inside it.
+  list.setRowCount(10);
+  runtime.renderTypedRootSync(rt, list.render(), container);
+  assert((list.window() == WindowRange{8, 10}));
+  assert(heightOf(rt, host->children[0]) == 160);
+
+  return true;
+}
+
+bool runReactTypedComponentTests() {
+  TestRuntime rt;
+  ReactRuntime runtime;
+  facebook::jsi::Object rootProps(rt);
+  auto container = std::make_shared<ReactDOMComponent>(rt, "root", rootProps);
+
+  // Mount renders every component and creates host instances directly.
+  List::Props props{{{1, "one", false}, {2, "two", false}, {3, "three", false}}};
+  runtime.renderTypedRootSync(rt, typedComponent<List>(props), container);
+  assert(gRowRenders == 3);
+  assert(runtime.getLastTypedRenderStats().hostCreates == 7);
+  assert(container->children.size() == 1);
+  auto list = container->children[0];
+  assert(list->children.size() == 3);
+  assert(list->children[1]->children[0]->getTextContent() == "two");
+  assert(classNameOf(rt, list->children[0]) == "row");
+
+  // Re-rendering with equal props bails out of every row without touching the host.
+  gRowRenders = 0;
+  props.rows[1].selected = true;
+  runtime.renderTypedRootSync(rt, typedComponent<List>(props), container);
+  const auto& stats = runtime.getLastTypedRenderStats();
+  assert(gRowRenders == 1);
+  assert(stats.memoBailouts == 2);
+  assert(stats.hostCreates == 0);
+  assert(stats.hostUpdates == 1);
+  assert(classNameOf(rt, list->children[1]) == "row selected");
+  assert(list->children[1]->getAttribute(rt, "ariaSelected").getBool());
+
+  // Dropped props are removed from the host instance.
+  props.rows[1].selected = false;
+  runtime.renderTypedRootSync(rt, typedComponent<List>(props), container);
+  assert(classNameOf(rt, list->children[1]) == "row");
+  assert(list->children[1]->getAttribute(rt, "ariaSelected").isUndefined());
+
+  // Keyed rows move instead of re-mounting; missing rows are removed.
+  auto rowThree = list->children[2];
+  auto rowOne = list->children[0];
+  gRowRenders = 0;
+  props.rows = {{3, "three", false}, {1, "one", false}};
+  runtime.renderTypedRootSync(rt, typedComponent<List>(props), container);
+  assert(gRowRenders == 0);
+  assert(runtime.getLastTypedRenderStats().hostRemovals == 1);
+  assert(list->children.size() == 2);
+  assert(list->children[0] == rowThree);
+  assert(list->children[1] == rowOne);
+
+  // Unregistering the container discards the retained typed tree.
+  runtime.unregisterRootContainer(container.get());
+  runtime.renderTypedRootSync(rt, typedComponent<List>(props), container);
+  assert(container->children.size() == 1);
+  assert(container->children[0] != list);
+  assert(gRowRenders == 2);
+
+  return runReactWindowedListTests();
+}
+
+} // namespace react::test
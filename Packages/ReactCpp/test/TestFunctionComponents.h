@@ -0,0 +1,83 @@
+#pragma once
+
+// Function components for driving the work loop in tests and benchmarks,
+// installed as the runtime's ComponentUpdater.
+//
+// There is no child reconciler yet, so a component does not return elements.
+// Its fiber keeps the children it was built with, and `render` returns a
+// pointer standing in for its output, kept in a hook after the component's
+// own. Output that differs from the committed render's marks the children as
+// receiving new props so they render too; otherwise they bail out as an
+// identical element would. Comparing against the committed output rather
+// than the last attempt keeps an interrupted render from hiding a change.
+
+#include "react-reconciler/ReactFiber.h"
+#include "react-reconciler/ReactFiberBeginWork.h"
+#include "react-reconciler/ReactFiberHooks.h"
+#include "react-reconciler/ReactWorkTags.h"
+#include "runtime/ReactRuntime.h"
+
+namespace react::test {
+
+// `type` of a FunctionComponent fiber built with appendTestComponent.
+struct TestFunctionComponent {
+  const char* name;
+  // Runs the component body with hooks available. Returns the same pointer
+  // as the committed render when the rendered children are unchanged.
+  const void* (*render)(ReactRuntime& runtime, const void* props);
+};
+
+inline FiberNode* updateTestComponent(
+    ReactRuntime& runtime,
+    FiberNode* current,
+    FiberNode& workInProgress,
+    Lanes renderLanes) {
+  bool didChangeChildren = false;
+  if (workInProgress.tag == WorkTag::FunctionComponent && workInProgress.type != nullptr) {
+    const auto* type = static_cast<const TestFunctionComponent*>(workInProgress.type);
+    didChangeChildren = renderWithHooks(
+        runtime,
+        current,
+        workInProgress,
+        [&runtime, type](const void* props) {
+          const void* output = type->render(runtime, props);
+          Hook& hook = nextWorkInProgressHook(runtime);
+          const Hook* committed = getCurrentHook(runtime);
+          hook.memoizedState = const_cast<void*>(output);
+          return committed == nullptr || committed->memoizedState != output;
+        },
+        static_cast<const void*>(workInProgress.pendingProps),
+        renderLanes);
+  }
+
+  if (current == nullptr) {
+    // Mounting: the children were created for this fiber and have no
+    // committed counterparts to clone.
+    return workInProgress.child;
+  }
+  cloneChildFibers(workInProgress);
+  if (didChangeChildren) {
+    for (FiberNode* child = workInProgress.child; child != nullptr; child = child->sibling) {
+      child->lanes = mergeLanes(child->lanes, renderLanes);
+    }
+  }
+  return workInProgress.child;
+}
+
+inline void installTestComponents(ReactRuntime& runtime) {
+  runtime.setComponentUpdater(&updateTestComponent);
+}
+
+inline FiberNode* appendTestComponent(const TestFunctionComponent& type, FiberNode& parent, FiberNode* previous) {
+  FiberNode* fiber = createFiber(WorkTag::FunctionComponent);
+  fiber->type = &type;
+  fiber->returnFiber = &parent;
+  if (previous == nullptr) {
+    parent.child = fiber;
+  } else {
+    previous->sibling = fiber;
+  }
+  return fiber;
+}
+
+} // namespace react::test
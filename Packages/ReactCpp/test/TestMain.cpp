@@ -6,8 +6,13 @@ bool runReactFiberLaneRuntimeTests();
 bool runReactFiberConcurrentUpdatesRuntimeTests();
 bool runReactFiberRuntimeTests();
 bool runReactFiberWorkLoopStateTests();
+bool runReactFiberHooksTests();
+bool runReactFiberNewContextTests();
+bool runReactFiberExternalStoreTests();
 bool runReactFiberAsyncActionTests();
+bool runReactFiberTransitionTests();
 bool runReactJSXRuntimeTests();
+bool runReactTypedComponentTests();
 }
 
 int main() {
@@ -17,7 +22,12 @@ int main() {
     allPassed &= react::test::runReactFiberConcurrentUpdatesRuntimeTests();
     allPassed &= react::test::runReactFiberRuntimeTests();
     allPassed &= react::test::runReactFiberWorkLoopStateTests();
+    allPassed &= react::test::runReactFiberHooksTests();
+    allPassed &= react::test::runReactFiberNewContextTests();
+    allPassed &= react::test::runReactFiberExternalStoreTests();
     allPassed &= react::test::runReactFiberAsyncActionTests();
+    allPassed &= react::test::runReactFiberTransitionTests();
     allPassed &= react::test::runReactJSXRuntimeTests();
+    allPassed &= react::test::runReactTypedComponentTests();
     return allPassed ? EXIT_SUCCESS : EXIT_FAILURE;
 }
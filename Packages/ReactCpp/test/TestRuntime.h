@@ -487,7 +487,7 @@ class TestRuntime : public Runtime {
   struct StringValue : PointerValue {
     explicit StringValue(std::shared_ptr<std::string> data) : data(std::move(data)) {}
     void invalidate() noexcept override {
-      data.reset();
+      delete this;
     }
     std::shared_ptr<std::string> data;
   };
@@ -495,7 +495,7 @@ class TestRuntime : public Runtime {
   struct PropNameIDValue : PointerValue {
     explicit PropNameIDValue(std::shared_ptr<std::string> name) : name(std::move(name)) {}
     void invalidate() noexcept override {
-      name.reset();
+      delete this;
     }
     std::shared_ptr<std::string> name;
   };
@@ -511,7 +511,7 @@ class TestRuntime : public Runtime {
   struct ObjectValue : PointerValue {
     explicit ObjectValue(std::shared_ptr<ObjectData> data) : data(std::move(data)) {}
     void invalidate() noexcept override {
-      data.reset();
+      delete this;
     }
     std::shared_ptr<ObjectData> data;
   };
@@ -520,7 +520,7 @@ class TestRuntime : public Runtime {
     WeakObjectValue() = default;
     explicit WeakObjectValue(std::weak_ptr<ObjectData> weak) : data(std::move(weak)) {}
     void invalidate() noexcept override {
-      data.reset();
+      delete this;
     }
     std::weak_ptr<ObjectData> data;
   };
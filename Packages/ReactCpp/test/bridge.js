@@ -10,6 +10,7 @@ const WasmValueType = {
   String: 4,
   Element: 5,
   Array: 6,
+  Object: 7,
 };
 
 const SIZE = {
@@ -18,6 +19,7 @@ const SIZE = {
   PROP: 13, // uint32 key offset + WasmReactValue
   ELEMENT: 28,
   ARRAY: 8,
+  OBJECT: 8, // uint32 entry count + offset to WasmReactProp entries
 };
 
 const REACT_ELEMENT_TYPE = (function resolveReactElementType() {
@@ -89,6 +91,9 @@ function getValueType(value) {
   if (isReactElement(value)) {
     return WasmValueType.Element;
   }
+  if (typeof value === 'object') {
+    return WasmValueType.Object;
+  }
   throw new TypeError(`Unsupported prop/child value type: ${typeof value}`);
 }
 
@@ -107,6 +112,22 @@ function measureArray(values) {
   return size;
 }
 
+// Object entries, such as style declarations, skip null and undefined
+// values like the C++ encoder does.
+function objectEntries(value) {
+  return Object.entries(value).filter(([, entry]) => entry != null);
+}
+
+function measureObject(value) {
+  const entries = objectEntries(value);
+  let size = SIZE.OBJECT + SIZE.PROP * entries.length;
+  for (const [key, entry] of entries) {
+    size += measureString(key);
+    size += measureValue(entry);
+  }
+  return size;
+}
+
 function measureElement(element) {
   if (!isReactElement(element)) {
     throw new TypeError('measureElement expects a React element-like object.');
@@ -156,6 +177,8 @@ function measureValue(value) {
       return measureElement(value);
     case WasmValueType.Array:
       return measureArray(value);
+    case WasmValueType.Object:
+      return measureObject(value);
     default:
       throw new TypeError('Unexpected value type encountered during measurement.');
   }
@@ -232,6 +255,11 @@ class WasmWriter {
         this.view.setUint32(payloadOffset, ptr, true);
         return;
       }
+      case WasmValueType.Object: {
+        const ptr = this.writeObject(value);
+        this.view.setUint32(payloadOffset, ptr, true);
+        return;
+      }
       default:
         throw new TypeError('Unsupported value type during serialization.');
     }
@@ -253,6 +281,26 @@ class WasmWriter {
     return arrayPtr;
   }
 
+  writeObject(value) {
+    const entries = objectEntries(value);
+    const objectOffset = this.reserve(SIZE.OBJECT);
+    const objectPtr = this.baseAddress + objectOffset;
+    this.view.setUint32(objectOffset, entries.length, true);
+    let entriesPtr = 0;
+    if (entries.length > 0) {
+      const entriesOffset = this.reserve(SIZE.PROP * entries.length);
+      entriesPtr = this.baseAddress + entriesOffset;
+      for (let index = 0; index < entries.length; ++index) {
+        const [key, entry] = entries[index];
+        const entryOffset = entriesOffset + index * SIZE.PROP;
+        this.view.setUint32(entryOffset, this.writeString(key), true);
+        this.writeValueInto(entryOffset + 4, entry);
+      }
+    }
+    this.view.setUint32(objectOffset + 4, entriesPtr, true);
+    return objectPtr;
+  }
+
   writeElement(element) {
     const offset = this.reserve(SIZE.ELEMENT);
     const elementPtr = this.baseAddress + offset;
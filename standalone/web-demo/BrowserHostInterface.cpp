@@ -2,33 +2,15 @@
 
 #include "BrowserHostInterface.h"
 
+#include "react-dom/client/ReactDOMStyleValue.h"
 #include "runtime/ReactHostInterface.h"
+#include "runtime/ReactTextChildren.h"
 
 #include "jsi/jsi.h"
 
 #include <algorithm>
-#include <cmath>
-#include <sstream>
 #include <stdexcept>
 
-namespace {
-
-std::string numberToString(double value) {
-  if (std::isnan(value) || !std::isfinite(value)) {
-    return std::string{};
-  }
-  if (std::floor(value) == value) {
-    std::ostringstream oss;
-    oss << static_cast<long long>(value);
-    return oss.str();
-  }
-  std::ostringstream oss;
-  oss << value;
-  return oss.str();
-}
-
-} // namespace
-
 namespace react::browser {
 
 BrowserHostInterface::BrowserHostInterface() = default;
@@ -73,6 +55,20 @@ std::shared_ptr<ReactDOMInstance> BrowserHostInterface::createHostTextInstance(
   return instance;
 }
 
+bool BrowserHostInterface::recycleHostInstance(
+    std::shared_ptr<ReactDOMInstance>,
+    facebook::jsi::Runtime&,
+    const facebook::jsi::Object&) {
+  return false;
+}
+
+bool BrowserHostInterface::recycleHostTextInstance(
+    std::shared_ptr<ReactDOMInstance>,
+    facebook::jsi::Runtime&,
+    const std::string&) {
+  return false;
+}
+
 void BrowserHostInterface::appendHostChild(
     std::shared_ptr<ReactDOMInstance> parent,
     std::shared_ptr<ReactDOMInstance> child) {
@@ -130,6 +126,25 @@ void BrowserHostInterface::commitHostUpdate(
   applyPayload(payload, element);
 }
 
+void BrowserHostInterface::commitHostUpdate(
+    std::shared_ptr<ReactDOMInstance> instance,
+    const UpdatePayload& payload) {
+  // Remove ops may view keys of the instance's props, so update the DOM node
+  // before the base class applies the payload to the instance.
+  auto element = getNode(instance);
+  if (!element.isUndefined() && runtime_) {
+    for (const auto& op : payload.ops) {
+      const std::string key(op.name);
+      if (op.remove) {
+        removeAttribute(key, element);
+      } else {
+        applyAttribute(key, updatePayloadValueToJsi(*runtime_, op.value), element);
+      }
+    }
+  }
+  HostInterface::commitHostUpdate(instance, payload);
+}
+
 void BrowserHostInterface::commitHostTextUpdate(
     std::shared_ptr<ReactDOMInstance> instance,
     const std::string& oldText,
@@ -235,7 +250,7 @@ void BrowserHostInterface::applyAttribute(
     if (value.isString()) {
       element.set("textContent", emscripten::val(value.getString(*runtime_).utf8(*runtime_)));
     } else if (value.isNumber()) {
-      element.set("textContent", emscripten::val(numberToString(value.getNumber())));
+      element.set("textContent", emscripten::val(numberToText(value.getNumber())));
     } else {
       element.set("textContent", emscripten::val(""));
     }
@@ -245,6 +260,22 @@ void BrowserHostInterface::applyAttribute(
     removeAttribute(key, element);
     return;
   }
+  if (key == "style" && value.isObject()) {
+    facebook::jsi::Runtime& rt = *runtime_;
+    facebook::jsi::Object style = value.getObject(rt);
+    facebook::jsi::Array names = style.getPropertyNames(rt);
+    size_t length = names.size(rt);
+    for (size_t i = 0; i < length; ++i) {
+      facebook::jsi::Value nameValue = names.getValueAtIndex(rt, i);
+      if (!nameValue.isString()) {
+        continue;
+      }
+      std::string name = nameValue.getString(rt).utf8(rt);
+      facebook::jsi::Value styleValue = style.getProperty(rt, name.c_str());
+      applyStyleProperty(name, dangerousStyleValue(rt, name, styleValue), element);
+    }
+    return;
+  }
   if (value.isBool()) {
     bool boolValue = value.getBool();
     element.set(key.c_str(), emscripten::val(boolValue));
@@ -256,7 +287,7 @@ void BrowserHostInterface::applyAttribute(
     return;
   }
   if (value.isNumber()) {
-    element.call<void>("setAttribute", emscripten::val(key), emscripten::val(numberToString(value.getNumber())));
+    element.call<void>("setAttribute", emscripten::val(key), emscripten::val(numberToText(value.getNumber())));
     return;
   }
   if (value.isString()) {
@@ -282,6 +313,22 @@ void BrowserHostInterface::removeAttribute(
   element.set(key.c_str(), emscripten::val::undefined());
 }
 
+void BrowserHostInterface::applyStyleProperty(
+    const std::string& name,
+    const std::string& value,
+    const emscripten::val& element) {
+  emscripten::val style = element["style"];
+  if (isCustomStyleProperty(name)) {
+    if (value.empty()) {
+      style.call<void>("removeProperty", emscripten::val(name));
+    } else {
+      style.call<void>("setProperty", emscripten::val(name), emscripten::val(value));
+    }
+    return;
+  }
+  style.set(name.c_str(), emscripten::val(value));
+}
+
 void BrowserHostInterface::applyPayload(
     const facebook::jsi::Object& payload,
     const emscripten::val& element) {
@@ -326,13 +373,51 @@ void BrowserHostInterface::applyPayload(
     }
   }
 
+  // Styles after the attributes, which may have replaced the whole style.
+  facebook::jsi::PropNameID stylesId = facebook::jsi::PropNameID::forUtf8(rt, "styles");
+  if (payload.hasProperty(rt, stylesId)) {
+    facebook::jsi::Value stylesValue = payload.getProperty(rt, stylesId);
+    if (stylesValue.isObject()) {
+      facebook::jsi::Object styles = stylesValue.asObject(rt);
+      facebook::jsi::Array names = styles.getPropertyNames(rt);
+      size_t length = names.size(rt);
+      for (size_t i = 0; i < length; ++i) {
+        facebook::jsi::Value nameValue = names.getValueAtIndex(rt, i);
+        if (!nameValue.isString()) {
+          continue;
+        }
+        std::string name = nameValue.asString(rt).utf8(rt);
+        facebook::jsi::Value styleValue = styles.getProperty(rt, name.c_str());
+        applyStyleProperty(name, styleValue.isString() ? styleValue.getString(rt).utf8(rt) : std::string(), element);
+      }
+    }
+  }
+
+  facebook::jsi::PropNameID removedStylesId = facebook::jsi::PropNameID::forUtf8(rt, "removedStyles");
+  if (payload.hasProperty(rt, removedStylesId)) {
+    facebook::jsi::Value removedValue = payload.getProperty(rt, removedStylesId);
+    if (removedValue.isObject()) {
+      facebook::jsi::Object removed = removedValue.asObject(rt);
+      if (removed.isArray(rt)) {
+        facebook::jsi::Array array = removed.asArray(rt);
+        size_t length = array.size(rt);
+        for (size_t i = 0; i < length; ++i) {
+          facebook::jsi::Value entry = array.getValueAtIndex(rt, i);
+          if (entry.isString()) {
+            applyStyleProperty(entry.getString(rt).utf8(rt), std::string(), element);
+          }
+        }
+      }
+    }
+  }
+
   facebook::jsi::PropNameID textId = facebook::jsi::PropNameID::forUtf8(rt, "text");
   if (payload.hasProperty(rt, textId)) {
     facebook::jsi::Value textValue = payload.getProperty(rt, textId);
     if (textValue.isString()) {
       element.set("textContent", emscripten::val(textValue.getString(rt).utf8(rt)));
     } else if (textValue.isNumber()) {
-      element.set("textContent", emscripten::val(numberToString(textValue.getNumber())));
+      element.set("textContent", emscripten::val(numberToText(textValue.getNumber())));
     } else {
       element.set("textContent", emscripten::val(""));
     }
@@ -38,6 +38,18 @@ public:
       facebook::jsi::Runtime& runtime,
       const std::string& text) override;
 
+  // Pooled instances still map to their old DOM nodes, so always create
+  // fresh ones.
+  bool recycleHostInstance(
+      std::shared_ptr<ReactDOMInstance> instance,
+      facebook::jsi::Runtime& runtime,
+      const facebook::jsi::Object& props) override;
+
+  bool recycleHostTextInstance(
+      std::shared_ptr<ReactDOMInstance> instance,
+      facebook::jsi::Runtime& runtime,
+      const std::string& text) override;
+
   void appendHostChild(
       std::shared_ptr<ReactDOMInstance> parent,
       std::shared_ptr<ReactDOMInstance> child) override;
@@ -57,6 +69,10 @@ public:
       const facebook::jsi::Object& newProps,
       const facebook::jsi::Object& payload) override;
 
+  void commitHostUpdate(
+      std::shared_ptr<ReactDOMInstance> instance,
+      const UpdatePayload& payload) override;
+
   void commitHostTextUpdate(
       std::shared_ptr<ReactDOMInstance> instance,
       const std::string& oldText,
@@ -82,6 +98,11 @@ private:
   void removeAttribute(
       const std::string& key,
       const emscripten::val& element);
+  // Writes one CSS property; an empty value clears it.
+  void applyStyleProperty(
+      const std::string& name,
+      const std::string& value,
+      const emscripten::val& element);
     void applyPayload(
             const facebook::jsi::Object& payload,
             const emscripten::val& element);
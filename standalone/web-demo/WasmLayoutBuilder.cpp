@@ -1,5 +1,7 @@
 #include "WasmLayoutBuilder.h"
 
+#include "runtime/ReactWasmBridge.h"
+
 #include <cstring>
 
 namespace react::browser {
@@ -112,6 +114,7 @@ WasmLayout buildKeyedSpanLayout(const std::vector<std::pair<std::string, std::st
     element.props_ptr = propsOffset;
     element.children_count = 0;
     element.children_ptr = 0;
+    element.subtree_hash = computeWasmSubtreeHash(builder.buffer.data(), element);
     const uint32_t elementOffset = builder.appendStruct(element);
 
     childValues.push_back(makeElementChild(elementOffset));
@@ -127,6 +130,7 @@ WasmLayout buildKeyedSpanLayout(const std::vector<std::pair<std::string, std::st
   root.props_ptr = 0;
   root.children_count = static_cast<uint32_t>(childValues.size());
   root.children_ptr = childrenOffset;
+  root.subtree_hash = computeWasmSubtreeHash(builder.buffer.data(), root);
   const uint32_t rootOffset = builder.appendStruct(root);
 
   WasmLayout layout;
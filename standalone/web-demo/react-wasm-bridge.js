@@ -147,6 +147,8 @@ class WasmLayoutBuilder {
     this.writeUint32(propsOffset);
     this.writeUint32(childrenCount);
     this.writeUint32(childrenOffset);
+    this.writeUint32(0); // subtree_hash (low), 0 = unknown
+    this.writeUint32(0); // subtree_hash (high)
     return offset;
   }
 